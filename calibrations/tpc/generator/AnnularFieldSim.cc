@@ -17,16 +17,129 @@
 #include <TVector3.h>
 
 #include <algorithm>
+#include <atomic>
 #include <boost/format.hpp>
 
 #include <cassert>  // for assert
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #define ALMOST_ZERO 0.00001
 
+namespace
+{
+  // runs func(begin,end) on contiguous blocks of [0,n), one block per thread
+  template <class Func>
+  void parallel_for(int n, int nthreads, Func func)
+  {
+    nthreads = std::max(1, std::min(nthreads, n));
+    int block = (n + nthreads - 1) / nthreads;
+    std::vector<std::thread> workers;
+    for (int begin = 0; begin < n; begin += block)
+    {
+      workers.emplace_back(func, begin, std::min(n, begin + block));
+    }
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  // runs func(i) for every i in [0,n), handing out one index at a time so threads stay busy when the cost per index varies
+  template <class Func>
+  void parallel_for_each(int n, int nthreads, Func func)
+  {
+    std::atomic<int> next(0);
+    parallel_for(std::max(1, std::min(nthreads, n)), nthreads, [&](int /*begin*/, int /*end*/)
+                 {
+      for (int i = next++; i < n; i = next++)
+      {
+        func(i);
+      } });
+  }
+
+  // result of drifting one electron from a distortion map bin to the readout
+  struct DriftResult
+  {
+    TVector3 distortion;
+    TVector3 differential;
+    int validToStep = 0;
+    int success = 0;
+  };
+
+  // orthonormal real fourier basis for n periodic bins: row 0 is the constant, then cos and sin of mode 1, 2, ...
+  // mode[row] is the azimuthal mode number of each row.
+  void periodic_basis(int n, std::vector<double> &basis, std::vector<int> &mode)
+  {
+    basis.assign((size_t) n * n, 0);
+    mode.assign(n, 0);
+    for (int row = 0; row < n; row++)
+    {
+      mode[row] = (row + 1) / 2;
+      double norm = 0;
+      for (int i = 0; i < n; i++)
+      {
+        double arg = 2 * M_PI * mode[row] * i / n;
+        double val = (row % 2 == 0 && row > 0) ? std::sin(arg) : std::cos(arg);
+        basis[(size_t) row * n + i] = val;
+        norm += val * val;
+      }
+      norm = std::sqrt(norm);
+      for (int i = 0; i < n; i++)
+      {
+        basis[(size_t) row * n + i] /= norm;
+      }
+    }
+  }
+
+  // orthonormal sine basis for n bins with the potential going to zero half a bin beyond either end (DST-II).
+  // row j has mode j+1.
+  void grounded_basis(int n, std::vector<double> &basis)
+  {
+    basis.assign((size_t) n * n, 0);
+    for (int row = 0; row < n; row++)
+    {
+      double norm = 0;
+      for (int i = 0; i < n; i++)
+      {
+        double val = std::sin(M_PI * (row + 1) * (i + 0.5) / n);
+        basis[(size_t) row * n + i] = val;
+        norm += val * val;
+      }
+      norm = std::sqrt(norm);
+      for (int i = 0; i < n; i++)
+      {
+        basis[(size_t) row * n + i] /= norm;
+      }
+    }
+  }
+
+  // out[row][k]=sum_i basis[row][i]*in[i][k] for the forward transform, out[i][k]=sum_row basis[row][i]*in[row][k] for the inverse.
+  // in and out are n x stride blocks.
+  void apply_basis(const std::vector<double> &basis, int n, int stride, const double *in, double *out, bool inverse)
+  {
+    std::fill(out, out + (size_t) n * stride, 0);
+    for (int row = 0; row < n; row++)
+    {
+      for (int i = 0; i < n; i++)
+      {
+        double b = basis[(size_t) row * n + i];
+        double *dest = inverse ? out + (size_t) i * stride : out + (size_t) row * stride;
+        const double *src = inverse ? in + (size_t) row * stride : in + (size_t) i * stride;
+        for (int k = 0; k < stride; k++)
+        {
+          dest[k] += b * src[k];
+        }
+      }
+    }
+  }
+}  // namespace
+
 AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, float in_outerZ,
                                  int r, int roi_r0, int roi_r1, int /*in_rLowSpacing*/, int /*in_rHighSize*/,
                                  int phi, int roi_phi0, int roi_phi1, int /*in_phiLowSpacing*/, int /*in_phiHighSize*/,
@@ -219,9 +332,9 @@ AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, flo
     q_local = new MultiArray<double>(1);
     *(q_local->GetFlat(0)) = 0;
   }
-  else if (lookupCase == Analytic || lookupCase == NoLookup)
+  else if (lookupCase == Analytic || lookupCase == NoLookup || lookupCase == PoissonSolver)
   {
-    std::cout << "lookupCase==Analytic (or NoLookup)" << std::endl;
+    std::cout << "lookupCase==Analytic (or NoLookup or PoissonSolver)" << std::endl;
 
     // zero them all out:
     Epartial_phislice = new MultiArray<TVector3>(1);
@@ -1545,6 +1658,11 @@ void AnnularFieldSim::populate_fieldmap()
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << boost::str(boost::format("total elements = %llu") % (totalelements * nr * nphi * nz)) << std::endl;
 
+  if (lookupCase == PoissonSolver)
+  {
+    solve_poisson_field();  // sum_field_at reads the result of this
+  }
+
   int el = 0;
 
   TVector3 localF;  // holder for the summed field at the current position.
@@ -1603,6 +1721,10 @@ void AnnularFieldSim::populate_lookup()
   {
     std::cout << "Populating lookup:  lookupCase==NoLookup ===> skipping!" << std::endl;
   }
+  else if (lookupCase == PoissonSolver)
+  {
+    std::cout << "Populating lookup:  lookupCase==PoissonSolver ===> skipping!  (field is solved in populate_fieldmap)" << std::endl;
+  }
   else
   {
     exit(1);
@@ -2004,6 +2126,218 @@ void AnnularFieldSim::populate_phislice_lookup()
   return;
 }
 
+void AnnularFieldSim::solve_poisson_field()
+{
+  // solve laplace(V)=-rho/eps0 on the full (nr x nphi x nz) grid of f-bin centers, with V=0 on the walls at rmin, rmax, zmin and zmax,
+  // which are the same boundary conditions as the Rossegger greens functions.
+  // the finite-difference operator separates:  the phi part is diagonal in a fourier basis and the z part is diagonal in a sine basis,
+  // which leaves one tridiagonal system in r for each (phi mode, z mode) pair.
+  // remember that Epoisson uses relative indices, but the potential is solved over the whole volume.
+  int nthreads = poisson_nthreads;
+  if (nthreads < 1)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  std::cout << boost::str(boost::format("solving poisson equation on (%dx%dx%d) grid for (%dx%dx%d) roi with %d threads") % nr % nphi % nz % nr_roi % nphi_roi % nz_roi % nthreads) << std::endl;
+
+  if (Epoisson == nullptr)
+  {
+    Epoisson = new MultiArray<TVector3>(nr_roi, nphi_roi, nz_roi);
+  }
+  for (int i = 0; i < Epoisson->Length(); i++)
+  {
+    Epoisson->GetFlat(i)->SetXYZ(0, 0, 0);
+  }
+
+  double dr = step.Perp();
+  double dphi = step.Phi();
+  double dz = step.Z();
+  size_t slab = (size_t) nphi * nz;  // one radial bin of the potential, indexed [phi][z]
+  std::vector<double> potential(nr * slab);
+
+  // fill with the right hand side.  q is the charge in each bin, so divide by the bin volume to get the density:
+  for (int ir = 0; ir < nr; ir++)
+  {
+    double rc = rmin + (ir + 0.5) * dr;
+    double volume = rc * dr * dphi * dz;
+    for (int iphi = 0; iphi < nphi; iphi++)
+    {
+      for (int iz = 0; iz < nz; iz++)
+      {
+        potential[ir * slab + iphi * nz + iz] = -q->GetChargeInBin(ir, iphi, iz) / volume * epsinv;
+      }
+    }
+  }
+
+  std::vector<double> phibasis;
+  std::vector<int> phimode;
+  std::vector<double> zbasis;
+  periodic_basis(nphi, phibasis, phimode);
+  grounded_basis(nz, zbasis);
+
+  // transform each radial slab into (phi mode, z mode) space:
+  parallel_for(nr, nthreads, [&](int begin, int end)
+               {
+    std::vector<double> tmp(slab);
+    for (int ir = begin; ir < end; ir++)
+    {
+      double *vslab = &potential[ir * slab];
+      apply_basis(phibasis, nphi, nz, vslab, tmp.data(), false);
+      for (int iphi = 0; iphi < nphi; iphi++)
+      {
+        apply_basis(zbasis, nz, 1, &tmp[iphi * nz], &vslab[iphi * nz], false);
+      }
+    } });
+
+  // solve the radial system for each pair of modes, in place:
+  parallel_for(nphi, nthreads, [&](int begin, int end)
+               {
+    std::vector<double> lower(nr);
+    std::vector<double> diag(nr);
+    std::vector<double> upper(nr);
+    for (int iphi = begin; iphi < end; iphi++)
+    {
+      double lambda_phi = (2 - 2 * std::cos(2 * M_PI * phimode[iphi] / nphi)) / (dphi * dphi);
+      for (int iz = 0; iz < nz; iz++)
+      {
+        double lambda_z = (2 - 2 * std::cos(M_PI * (iz + 1) / nz)) / (dz * dz);
+        for (int ir = 0; ir < nr; ir++)
+        {
+          double rc = rmin + (ir + 0.5) * dr;
+          double a = (rc - dr / 2) / (rc * dr * dr);
+          double c = (rc + dr / 2) / (rc * dr * dr);
+          lower[ir] = a;
+          upper[ir] = c;
+          diag[ir] = -(a + c) - lambda_phi / (rc * rc) - lambda_z;
+        }
+        // the walls are half a bin beyond the first and last bins, so the mirror bin on the other side of the wall holds -V:
+        diag[0] -= lower[0];
+        lower[0] = 0;
+        diag[nr - 1] -= upper[nr - 1];
+        upper[nr - 1] = 0;
+
+        // thomas algorithm.  the system is diagonally dominant, so no pivoting is needed.
+        double *x = &potential[iphi * nz + iz];
+        x[0] /= diag[0];
+        upper[0] /= diag[0];
+        for (int ir = 1; ir < nr; ir++)
+        {
+          double denom = diag[ir] - lower[ir] * upper[ir - 1];
+          upper[ir] /= denom;
+          x[ir * slab] = (x[ir * slab] - lower[ir] * x[(ir - 1) * slab]) / denom;
+        }
+        for (int ir = nr - 2; ir >= 0; ir--)
+        {
+          x[ir * slab] -= upper[ir] * x[(ir + 1) * slab];
+        }
+      }
+    } });
+
+  // and transform back to the potential in each bin:
+  parallel_for(nr, nthreads, [&](int begin, int end)
+               {
+    std::vector<double> tmp(slab);
+    for (int ir = begin; ir < end; ir++)
+    {
+      double *vslab = &potential[ir * slab];
+      for (int iphi = 0; iphi < nphi; iphi++)
+      {
+        apply_basis(zbasis, nz, 1, &vslab[iphi * nz], &tmp[iphi * nz], true);
+      }
+      apply_basis(phibasis, nphi, nz, tmp.data(), vslab, true);
+    } });
+
+  // E=-grad(V) at the center of each roi bin, using the same mirror bins at the walls and wrapping around in phi:
+  auto potential_at = [&](int ir, int iphi, int iz)
+  {
+    double sign = 1;
+    if (ir < 0 || ir >= nr)
+    {
+      ir = (ir < 0) ? 0 : nr - 1;
+      sign = -sign;
+    }
+    if (iz < 0 || iz >= nz)
+    {
+      iz = (iz < 0) ? 0 : nz - 1;
+      sign = -sign;
+    }
+    iphi = (iphi + nphi) % nphi;
+    return sign * potential[ir * slab + iphi * nz + iz];
+  };
+  parallel_for(nr_roi, nthreads, [&](int begin, int end)
+               {
+    for (int ir = rmin_roi + begin; ir < rmin_roi + end; ir++)
+    {
+      double rc = rmin + (ir + 0.5) * dr;
+      for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+      {
+        for (int iz = zmin_roi; iz < zmax_roi; iz++)
+        {
+          double Er = -(potential_at(ir + 1, iphi, iz) - potential_at(ir - 1, iphi, iz)) / (2 * dr);
+          double Ephi = -(potential_at(ir, iphi + 1, iz) - potential_at(ir, iphi - 1, iz)) / (2 * rc * dphi);
+          double Ez = -(potential_at(ir, iphi, iz + 1) - potential_at(ir, iphi, iz - 1)) / (2 * dz);
+          TVector3 field(Er, Ephi, Ez);     // these are the correct components at phi=0,
+          field.RotateZ((iphi + 0.5) * dphi);  // so rotate to the phi of the bin center, same as GetCellCenter.
+          Epoisson->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, field);
+        }
+      }
+    } });
+  return;
+}
+
+float AnnularFieldSim::validate_poisson_field(int r_stride, int phi_stride, int z_stride)
+{
+  // compare the PoissonSolver field to the direct sum of the Rossegger greens functions, which have the same boundary conditions.
+  // every point costs a full sum over the volume, so this is meant for coarse grids and a sparse set of points in the roi.
+  if (green == nullptr)
+  {
+    std::cout << "AnnularFieldSim::validate_poisson_field needs the Rossegger greens functions.  Call load_rossegger() or borrow_rossegger() first." << std::endl;
+    return -1;
+  }
+  r_stride = std::max(1, r_stride);
+  phi_stride = std::max(1, phi_stride);
+  z_stride = std::max(1, z_stride);
+
+  solve_poisson_field();
+
+  std::vector<TVector3> poissonF;
+  std::vector<TVector3> greensF;
+  double maxmag = 0;
+  for (int ir = rmin_roi; ir < rmax_roi; ir += r_stride)
+  {
+    for (int iphi = phimin_roi; iphi < phimax_roi; iphi += phi_stride)
+    {
+      for (int iz = zmin_roi; iz < zmax_roi; iz += z_stride)
+      {
+        poissonF.push_back(Epoisson->Get(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi));
+        greensF.push_back(sum_greens_field_at(ir, iphi, iz));
+        maxmag = std::max(maxmag, greensF.back().Mag());
+        if (debugFlag())
+        {
+          std::cout << boost::str(boost::format("validate_poisson_field (ir=%d,iphi=%d,iz=%d) poisson=(%E,%E,%E) greens=(%E,%E,%E)") % ir % iphi % iz % poissonF.back().X() % poissonF.back().Y() % poissonF.back().Z() % greensF.back().X() % greensF.back().Y() % greensF.back().Z()) << std::endl;
+        }
+      }
+    }
+  }
+  if (maxmag <= 0)
+  {
+    std::cout << "AnnularFieldSim::validate_poisson_field:  greens function field is zero at all test points.  Nothing to compare." << std::endl;
+    return -1;
+  }
+
+  // deviations are relative to the largest field in the sample, since the field can be near zero at individual points:
+  double maxdev = 0;
+  double sumdev = 0;
+  for (size_t i = 0; i < poissonF.size(); i++)
+  {
+    double dev = (poissonF[i] - greensF[i]).Mag() / maxmag;
+    maxdev = std::max(maxdev, dev);
+    sumdev += dev;
+  }
+  std::cout << boost::str(boost::format("validate_poisson_field:  %d points, max |E|=%E V/cm, deviation from greens functions mean=%2.4f max=%2.4f (relative to max |E|)") % poissonF.size() % maxmag % (sumdev / poissonF.size()) % maxdev) << std::endl;
+  return maxdev;
+}
+
 void AnnularFieldSim::load_phislice_lookup(const std::string &sourcefile)
 {
   std::cout << boost::str(boost::format("loading phislice  lookup for (%dx%dx%d)x(%dx%dx%d) grid from %s") % nr_roi % 1 % nz_roi % nr % nphi % nz % sourcefile) << std::endl;
@@ -2248,6 +2582,10 @@ TVector3 AnnularFieldSim::sum_field_at(int r, int phi, int z)
   {
     // do nothing.  We are forcibly assuming E from spacecharge is zero everywhere.
   }
+  else if (lookupCase == PoissonSolver)
+  {
+    sum += Epoisson->Get(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
+  }
   sum += Eexternal->Get(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
   if (debugFlag())
   {
@@ -2678,6 +3016,34 @@ TVector3 AnnularFieldSim::sum_phislice_field_at(int r, int phi, int z)
   return sum;
 }
 
+TVector3 AnnularFieldSim::sum_greens_field_at(int r, int phi, int z)
+{
+  // sum the E field over all nr by ny by nz cells of sources directly from the greens functions, without a lookup table.
+  // this is slow, and only meant to cross-check the other field calculations.
+  TVector3 at = GetCellCenter(r, phi, z);
+  TVector3 sum(0, 0, 0);
+  for (int ir = 0; ir < nr; ir++)
+  {
+    for (int iphi = 0; iphi < nphi; iphi++)
+    {
+      for (int iz = 0; iz < nz; iz++)
+      {
+        if (r == ir && phi == iphi && z == iz)
+        {
+          continue;  // dont' compute self-to-self field.
+        }
+        float charge = q->GetChargeInBin(ir, iphi, iz);
+        if (charge == 0)
+        {
+          continue;
+        }
+        sum += calc_unit_field(at, GetCellCenter(ir, iphi, iz)) * charge;
+      }
+    }
+  }
+  return sum;
+}
+
 TVector3 AnnularFieldSim::swimToInAnalyticSteps(float zdest, TVector3 start, int steps = 1, int *goodToStep = nullptr)
 {
   // assume coordinates are given in native units (cm=1 unless that changed!).
@@ -3076,9 +3442,26 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
   std::cout << boost::str(boost::format("Phi:  %d steps from %f to %f (field has %d steps)") % nph % pih % pfh % GetFieldStepsPhi()) << std::endl;
   std::cout << boost::str(boost::format("R:  %d steps from %f to %f (field has %d steps)") % nrh % rih % rfh % GetFieldStepsR()) << std::endl;
   std::cout << boost::str(boost::format("Z:  %d steps from %f to %f (field has %d steps)") % nzh % zih % zfh % GetFieldStepsZ()) << std::endl;
-  std::string distortionFilename = filebase + ".distortion_map.hist.root";
-  std::string summaryFilename = filebase + "distortion_summary.pdf";
-  std::string diffSummaryFilename = filebase + "differential_summary.pdf";
+
+  // if the map is split across jobs, this job only drifts its own slice of r bins:
+  int ir_begin = 0;
+  int ir_end = nrh;
+  std::string jobbase = filebase;
+  if (distortion_njobs > 1)
+  {
+    if (distortion_job < 0 || distortion_job >= distortion_njobs)
+    {
+      std::cout << boost::str(boost::format("AnnularFieldSim::GenerateSeparateDistortionMaps:  job %d is outside of 0<=job<%d.  Not generating anything.") % distortion_job % distortion_njobs) << std::endl;
+      return;
+    }
+    ir_begin = nrh * distortion_job / distortion_njobs;
+    ir_end = nrh * (distortion_job + 1) / distortion_njobs;
+    jobbase = boost::str(boost::format("%s.part%dof%d") % filebase % distortion_job % distortion_njobs);
+    std::cout << boost::str(boost::format("job %d of %d:  generating r bins %d to %d of %d") % distortion_job % distortion_njobs % ir_begin % (ir_end - 1) % nrh) << std::endl;
+  }
+  std::string distortionFilename = jobbase + ".distortion_map.hist.root";
+  std::string summaryFilename = jobbase + "distortion_summary.pdf";
+  std::string diffSummaryFilename = jobbase + "differential_summary.pdf";
 
   TFile *outf = TFile::Open(distortionFilename.c_str(), "RECREATE");
   outf->cd();
@@ -3230,7 +3613,7 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
   dTree->Branch("dz", &distortZ);
 
   std::cout << boost::str(boost::format("generating separated distortion map with (%dx%dx%d) grid ") % nrh % nph % nzh) << std::endl;
-  unsigned long long totalelements = nrh;
+  unsigned long long totalelements = ir_end - ir_begin;
   totalelements *= nph;
   totalelements *= nzh;  // breaking up this multiplication prevents a 32bit math overflow
   if (hasTwin)
@@ -3238,11 +3621,54 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
     totalelements *= 2;  // if we have a twin, we have twice as many z bins as we thought.
   }
 
-  unsigned long long percent = totalelements / 100;
-  unsigned long long waypoint = percent * debug_npercent;
+  unsigned long long percent = std::max(1ULL, totalelements / 100);
+  unsigned long long waypoint = std::max(1ULL, percent * debug_npercent);
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
 
-  int el = 0;
+  // every bin drifts independently, so one row in r at a time is drifted in parallel and then filled into
+  // the histograms in the same order as before.  The output does not depend on the number of threads.
+  int nthreads = distortion_nthreads;
+  if (nthreads < 1)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  if (rdrswitch && nthreads > 1)
+  {
+    std::cout << "RdeltaR histogram is filled while drifting, which is not thread safe.  Drifting with one thread." << std::endl;
+    nthreads = 1;
+  }
+  std::cout << boost::str(boost::format("drifting with %d threads") % nthreads) << std::endl;
+  auto start_position = [&](int jr, int jp, int jz, int localside)
+  {
+    // same positions as inpart below
+    TVector3 start(1, 0, 0);
+    float startR = (jr + 0.5) * deltar + rih;
+    if (jr == 0)
+    {
+      startR += deltar;
+    }
+    else if (jr == nrh - 1)
+    {
+      startR -= deltar;
+    }
+    start.SetPerp(startR);
+    start.SetPhi((jp + 0.5) * deltap + pih);
+    float startZ = (jz) *deltaz + zih;
+    if (jz == 0)
+    {
+      startZ += deltaz;
+    }
+    else if (jz == nzh - 1)
+    {
+      startZ -= deltaz;
+    }
+    start.SetZ(localside == 0 ? startZ : -startZ);
+    return start;
+  };
+  std::vector<DriftResult> drifted(nph * nzh * nSides);  // one row in r, indexed [phi][z][side]
+  auto start_time = std::chrono::steady_clock::now();
+
+  unsigned long long el = 0;
 
   // we want to loop over the entire region to be mapped, but we also need to include
   // one additional bin at each edge, to allow the mc drift code to interpolate properly.
@@ -3252,8 +3678,24 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
 
   // note that we apply the adjustment to the particle position (inpart) and not the plotted position (partR etc)
   inpart.SetXYZ(1, 0, 0);
-  for (ir = 0; ir < nrh; ir++)
-  {
+  for (ir = ir_begin; ir < ir_end; ir++)
+  {
+    parallel_for_each((int) drifted.size(), nthreads, [&](int i)
+                      {
+      int localside = i % nSides;
+      int jz = (i / nSides) % nzh;
+      int jp = i / nSides / nzh;
+      TVector3 start = start_position(ir, jp, jz, localside);
+      DriftResult &result = drifted[i];
+      if (localside == 0)
+      {
+        result.distortion = GetTotalDistortion(z_readout, start, nSteps, true, &result.validToStep, &result.success);
+      }
+      else
+      {
+        result.distortion = twin->GetTotalDistortion(-z_readout, start, nSteps, true, &result.validToStep, &result.success);
+      } });
+
     partR = (ir + 0.5) * deltar + rih;
     if (ir == 0)
     {
@@ -3290,10 +3732,13 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
         partZ += 0.5 * deltaz;  // move to center of histogram bin.
         for (int localside = 0; localside < nSides; localside++)
         {
+          const DriftResult &result = drifted[(ip * nzh + iz) * nSides + localside];
+          validToStep = result.validToStep;
+          successCheck = result.success;
           if (localside == 0)
           {
             diffdistort = zero_vector;  // GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
+            distort = result.distortion;  // GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
           }
           else
           {
@@ -3302,7 +3747,7 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
             partZ *= -1;                   // position to place in histogram
             inpart.SetZ(-1 * inpart.Z());  // position to seek in sim
             diffdistort = zero_vector;     // twin->GetTotalDistortion(inpart.Z() - deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = twin->GetTotalDistortion(-z_readout, inpart, nSteps, true, &validToStep, &successCheck);
+            distort = result.distortion;   // twin->GetTotalDistortion(-z_readout, inpart, nSteps, true, &validToStep, &successCheck);
           }
 
           diffdistort.RotateZ(-inpart.Phi());  // rotate so that distortion components are wrt the x axis
@@ -3401,14 +3846,19 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
 
           if (!(el % waypoint))
           {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+            double rate = (el + 1) / std::max(elapsed.count(), 1e-9);
             std::cout << boost::str(boost::format("generating distortions %d%%:  ") % ((int) (el / percent)));
-            std::cout << boost::str(boost::format("distortion at (ir=%d,ip=%d,iz=%d) is (%E,%E,%E)") % ir % ip % iz % distortR % distortP % distortZ) << std::endl;
+            std::cout << boost::str(boost::format("distortion at (ir=%d,ip=%d,iz=%d) is (%E,%E,%E)") % ir % ip % iz % distortR % distortP % distortZ);
+            std::cout << boost::str(boost::format(" (%.1f bins/s, %.0fs elapsed, ~%.0fs left)") % rate % elapsed.count() % ((totalelements - el - 1) / rate)) << std::endl;
           }
           el++;
         }
       }
     }
   }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+  std::cout << boost::str(boost::format("drifted %llu bins in %.1fs (%.1f bins/s) with %d threads") % el % elapsed.count() % (el / std::max(elapsed.count(), 1e-9)) % nthreads) << std::endl;
   std::cout << "Completed distortion generation.  Saving outputs..." << std::endl;
 
   TCanvas *canvas = new TCanvas("cdistort", "distortion integrals", 1200, 800);
@@ -3660,9 +4110,26 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
   std::cout << boost::str(boost::format("Phi:  %d steps from %f to %f (field has %d steps)") % nph % pih % pfh % GetFieldStepsPhi()) << std::endl;
   std::cout << boost::str(boost::format("R:  %d steps from %f to %f (field has %d steps)") % nrh % rih % rfh % GetFieldStepsR()) << std::endl;
   std::cout << boost::str(boost::format("Z:  %d steps from %f to %f (field has %d steps)") % nzh % zih % zfh % GetFieldStepsZ()) << std::endl;
-  std::string distortionFilename = filebase + ".distortion_summary.pdf";
-  std::string summaryFilename = filebase + ".distortion_summary.pdf";
-  std::string diffSummaryFilename = filebase + ".differential_summary.pdf";
+
+  // if the map is split across jobs, this job only drifts its own slice of r bins:
+  int ir_begin = 0;
+  int ir_end = nrh;
+  std::string jobbase = filebase;
+  if (distortion_njobs > 1)
+  {
+    if (distortion_job < 0 || distortion_job >= distortion_njobs)
+    {
+      std::cout << boost::str(boost::format("AnnularFieldSim::GenerateDistortionMaps:  job %d is outside of 0<=job<%d.  Not generating anything.") % distortion_job % distortion_njobs) << std::endl;
+      return;
+    }
+    ir_begin = nrh * distortion_job / distortion_njobs;
+    ir_end = nrh * (distortion_job + 1) / distortion_njobs;
+    jobbase = boost::str(boost::format("%s.part%dof%d") % filebase % distortion_job % distortion_njobs);
+    std::cout << boost::str(boost::format("job %d of %d:  generating r bins %d to %d of %d") % distortion_job % distortion_njobs % ir_begin % (ir_end - 1) % nrh) << std::endl;
+  }
+  std::string distortionFilename = jobbase + ".distortion_summary.pdf";
+  std::string summaryFilename = jobbase + ".distortion_summary.pdf";
+  std::string diffSummaryFilename = jobbase + ".differential_summary.pdf";
 
   TFile *outf = TFile::Open(distortionFilename.c_str(), "RECREATE");
   outf->cd();
@@ -3778,13 +4245,57 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
   dTree->Branch("dz", &distortZ);
 
   std::cout << "generating distortion map with (" << nrh << "x" << nph << "x" << nzh << " grid" << std::endl;
-  unsigned long long totalelements = nrh;
+  unsigned long long totalelements = ir_end - ir_begin;
   totalelements *= nph;
   totalelements *= nzh;  // breaking up this multiplication prevents a 32bit math overflow
-  unsigned long long percent = totalelements / 100 * debug_npercent;
+  unsigned long long percent = std::max(1ULL, totalelements / 100 * debug_npercent);
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
 
-  int el = 0;
+  // every bin drifts independently, so one row in r at a time is drifted in parallel and then filled into
+  // the histograms in the same order as before.  The output does not depend on the number of threads.
+  int nthreads = distortion_nthreads;
+  if (nthreads < 1)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  // the twin fills its own RdeltaR histogram when it drifts the negative z side
+  if ((RdeltaRswitch || (hasTwin && twin && twin->RdeltaRswitch)) && nthreads > 1)
+  {
+    std::cout << "RdeltaR histogram is filled while drifting, which is not thread safe.  Drifting with one thread." << std::endl;
+    nthreads = 1;
+  }
+  std::cout << boost::str(boost::format("drifting with %d threads") % nthreads) << std::endl;
+  auto start_position = [&](int jr, int jp, int jz)
+  {
+    // same positions as inpart below
+    TVector3 start(1, 0, 0);
+    float startR = (jr + 0.5) * deltar + rih;
+    if (jr == 0)
+    {
+      startR += deltar;
+    }
+    else if (jr == nrh - 1)
+    {
+      startR -= deltar;
+    }
+    start.SetPerp(startR);
+    start.SetPhi((jp + 0.5) * deltap + pih);
+    float startZ = (jz) *deltaz + zih;
+    if (jz == 0)
+    {
+      startZ += deltaz;
+    }
+    else if (jz == nzh - 1)
+    {
+      startZ -= deltaz;
+    }
+    start.SetZ(startZ);
+    return start;
+  };
+  std::vector<DriftResult> drifted(nph * nzh);  // one row in r, indexed [phi][z]
+  auto start_time = std::chrono::steady_clock::now();
+
+  unsigned long long el = 0;
 
   // we want to loop over the entire region to be mapped, but we also need to include
   // one additional bin at each edge, to allow the mc drift code to interpolate properly.
@@ -3794,8 +4305,31 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
 
   // note that we apply the adjustment to the particle position (inpart) and not the plotted position (partR etc)
   inpart.SetXYZ(1, 0, 0);
-  for (ir = 0; ir < nrh; ir++)
-  {
+  for (ir = ir_begin; ir < ir_end; ir++)
+  {
+    parallel_for_each((int) drifted.size(), nthreads, [&](int i)
+                      {
+      TVector3 start = start_position(ir, i / nzh, i % nzh);
+      DriftResult &result = drifted[i];
+      int validStep;
+      int success;
+      if (hasTwin && start.Z() < 0)
+      {
+        result.differential = twin->GetTotalDistortion(start.Z(), start + stepzvec, nSteps, true, &validStep, &success);
+      }
+      else
+      {
+        result.differential = GetTotalDistortion(start.Z() + deltaz, start, nSteps, true, &validStep, &success);
+      }
+      if (hasTwin && makeUnifiedMap && start.Z() < 0)
+      {
+        result.distortion = twin->GetTotalDistortion(-z_readout, start + stepzvec, nSteps, true, &result.validToStep, &result.success);
+      }
+      else
+      {
+        result.distortion = GetTotalDistortion(z_readout, start, nSteps, true, &result.validToStep, &result.success);
+      } });
+
     partR = (ir + 0.5) * deltar + rih;
     if (ir == 0)
     {
@@ -3835,14 +4369,8 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
 
         // differential distortion:
         // be careful with the math of a distortion.  The R distortion is NOT the perp() component of outpart-inpart -- that's the transverse magnitude of the distortion!
-        if (hasTwin && inpart.Z() < 0)
-        {
-          distort = twin->GetTotalDistortion(inpart.Z(), inpart + stepzvec, nSteps, true, &validToStep, &successCheck);  // step across the cell in the opposite direction, starting at the high side and going to the low side..
-        }
-        else
-        {
-          distort = GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-        }
+        const DriftResult &result = drifted[ip * nzh + iz];
+        distort = result.differential;  // for the twin, this steps across the cell in the opposite direction, starting at the high side and going to the low side..
         distort.RotateZ(-inpart.Phi());  // rotate so that that is on the x axis
         diffdistP = distort.Y();         // the phi component is now the y component.
         diffdistR = distort.X();         // and the r component is the x component
@@ -3853,14 +4381,9 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
         dTree->Fill();
 
         // integral distortion:
-        if (hasTwin && makeUnifiedMap && inpart.Z() < 0)
-        {
-          distort = twin->GetTotalDistortion(-z_readout, inpart + stepzvec, nSteps, true, &validToStep, &successCheck);
-        }
-        else
-        {
-          distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
-        }
+        distort = result.distortion;
+        validToStep = result.validToStep;
+        successCheck = result.success;
         distortX = distort.X();
         distortY = distort.Y();
         distort.RotateZ(-inpart.Phi());  // rotate so that that is on the x axis
@@ -3936,13 +4459,18 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
 
         if (!(el % percent))
         {
+          std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+          double rate = (el + 1) / std::max(elapsed.count(), 1e-9);
           std::cout << boost::str(boost::format("generating distortions %d%%:  ") % ((int) (debug_npercent * (el / percent))));
-          std::cout << boost::str(boost::format("distortion at (ir=%d,ip=%d,iz=%d) is (%E,%E,%E)") % ir % ip % iz % distortR % distortP % distortZ) << std::endl;
+          std::cout << boost::str(boost::format("distortion at (ir=%d,ip=%d,iz=%d) is (%E,%E,%E)") % ir % ip % iz % distortR % distortP % distortZ);
+          std::cout << boost::str(boost::format(" (%.1f bins/s, %.0fs elapsed, ~%.0fs left)") % rate % elapsed.count() % ((totalelements - el - 1) / rate)) << std::endl;
         }
         el++;
       }
     }
   }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+  std::cout << boost::str(boost::format("drifted %llu bins in %.1fs (%.1f bins/s) with %d threads") % el % elapsed.count() % (el / std::max(elapsed.count(), 1e-9)) % nthreads) << std::endl;
 
   TCanvas *canvas = new TCanvas("cdistort", "distortion integrals", 1200, 800);
   // take 10 of the bottom of this for data?
@@ -4305,6 +4833,11 @@ const std::string AnnularFieldSim::GetLookupString()
     return boost::str(boost::format("PhiSlice (%d x %d x %d) with (%d x 1 x %d) roi") % nr % nphi % nz % nr_roi % nz_roi);
   }
 
+  if (lookupCase == LookupCase::PoissonSolver)
+  {
+    return boost::str(boost::format("PoissonSolver (%d x %d x %d) with (%d x %d x %d) roi") % nr % nphi % nz % nr_roi % nphi_roi % nz_roi);
+  }
+
   return "broken";
 }
 const std::string AnnularFieldSim::GetGasString()
@@ -30,7 +30,8 @@ class AnnularFieldSim
     HybridRes,
     PhiSlice,
     Analytic,
-    NoLookup
+    NoLookup,
+    PoissonSolver
   };
   // Full3D = uses (nr x nphi x nz)^2 lookup table
   // Hybrid = uses (nr x nphi x nz) x (nr_local x nphi_local x nz_local) + (nr_low x nphi_low x nz_low)^2 set of tables
@@ -38,6 +39,8 @@ class AnnularFieldSim
   // Analytic = doesn't use lookup tables -- no memory footprint, uses analytic E field at center of each bin.
   //     Note that this is not the same as analytic propagation, which checks the analytic field integrals in each step.
   // NoLookup = Don't build any structures -- effectively ignores any calculated spacecharge field
+  // PoissonSolver = doesn't use lookup tables -- solves for the potential on the (nr x nphi x nz) grid with grounded walls (same boundaries as Rossegger),
+  //     Fourier transform in phi, sine transform in z, tridiagonal solve in r.  Memory and time scale ~linearly with the number of cells.
   enum ChargeCase
   {
     FromFile,
@@ -93,6 +96,22 @@ class AnnularFieldSim
     truncation_length = x;
     return;
   }
+  void SetPoissonThreads(int n)
+  {
+    poisson_nthreads = n;
+    return;
+  }  // number of threads for the PoissonSolver, <1 uses all available cores.
+  void SetDistortionThreads(int n)
+  {
+    distortion_nthreads = n;
+    return;
+  }  // number of threads drifting electrons in Generate*DistortionMaps, <1 uses all available cores.  Output does not depend on this.
+  void SetDistortionJob(int job, int njobs)
+  {
+    distortion_job = job;
+    distortion_njobs = njobs;
+    return;
+  }  // compute only the job'th of njobs slices in r of the distortion maps, written to <filebase>.part<job>of<njobs>.  hadd the parts to get the full map.
 
   // getters for internal states:
   const std::string GetLookupString();
@@ -197,6 +216,8 @@ class AnnularFieldSim
   void populate_highres_lookup();
   void populate_lowres_lookup();
   void populate_phislice_lookup();
+  void solve_poisson_field();
+  float validate_poisson_field(int r_stride = 4, int phi_stride = 4, int z_stride = 4);  // compares the PoissonSolver field to the summed Rossegger greens functions on a coarse subset of the roi.  returns the largest relative deviation.
 
   void load_phislice_lookup(const std::string &sourcefile);
   void save_phislice_lookup(const std::string &destfile);
@@ -211,6 +232,7 @@ class AnnularFieldSim
   TVector3 sum_local_field_at(int r, int phi, int z);
   TVector3 sum_nonlocal_field_at(int r, int phi, int z);
   TVector3 sum_phislice_field_at(int r, int phi, int z);
+  TVector3 sum_greens_field_at(int r, int phi, int z);
   TVector3 swimToInAnalyticSteps(float zdest, TVector3 start, int steps, int *goodToStep);
   TVector3 swimToInSteps(float zdest, const TVector3 &start, int steps, bool interpolate, int *goodToStep);
   TVector3 swimTo(float zdest, const TVector3 &start, bool interpolate = true, bool useAnalytic = false);
@@ -302,6 +324,10 @@ class AnnularFieldSim
   LookupCase lookupCase;  // which lookup system to instantiate and use.
   ChargeCase chargeCase;  // which charge model to use
   int truncation_length;  // distance in cells (full 3D metric in units of bins)
+  int poisson_nthreads = 0;  // threads used by solve_poisson_field, <1 means hardware_concurrency
+  int distortion_nthreads = 1;  // threads used to drift electrons when generating distortion maps, <1 means hardware_concurrency
+  int distortion_job = 0;
+  int distortion_njobs = 1;  // slice of the distortion map (in r) to compute, for splitting a map across batch jobs
 
   // variables related to the region of interest:
   //
@@ -341,6 +367,7 @@ class AnnularFieldSim
   MultiArray<TVector3> *Epartial;           // electric field for the old brute-force model.
   MultiArray<TVector3> *Epartial_phislice;  // electric field in a 2D phi-slice from the full 3D region.
   MultiArray<TVector3> *Eexternal;          // externally applied electric field in each f-bin in the roi
+  MultiArray<TVector3> *Epoisson = nullptr; // spacecharge electric field in each f-bin in the roi from the PoissonSolver
   MultiArray<TVector3> *Bfield;             // magnetic field in each f-bin in the roi
 
   ChargeMapReader *q;            // //class to read and report charge.
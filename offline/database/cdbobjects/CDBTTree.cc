@@ -331,6 +331,10 @@ void CDBTTree::WriteSingleCDBTTree()
 
 void CDBTTree::Print()
 {
+  if (m_ColumnsLoaded && m_FloatEntryMap.empty() && m_DoubleEntryMap.empty() && m_IntEntryMap.empty() && m_UInt64EntryMap.empty())
+  {
+    FillEntryMapsFromColumns();
+  }
   if (!m_FloatEntryMap.empty())
   {
     std::cout << "Number of float entries: " << m_FloatEntryMap.size() << std::endl;
@@ -537,112 +541,83 @@ void CDBTTree::LoadCalibrations()
     }
     m_TTree[SingleEntries]->GetEntry(0);
   }
+  m_Channels.clear();
+  m_ChannelIndex.clear();
+  m_FloatColumns.clear();
+  m_DoubleColumns.clear();
+  m_IntColumns.clear();
+  m_UInt64Columns.clear();
   if (m_TTree[MultipleEntries] != nullptr)
   {
     TObjArray *branches = m_TTree[MultipleEntries]->GetListOfBranches();
+    // the branch buffers must not move once their addresses are given to the tree
+    std::vector<float> floatvals(branches->GetEntriesFast());
+    std::vector<double> doublevals(branches->GetEntriesFast());
+    std::vector<int> intvals(branches->GetEntriesFast());
+    std::vector<uint64_t> uint64vals(branches->GetEntriesFast());
+    int ID = std::numeric_limits<int>::min();
+    bool hasID = false;
     TIter iter(branches);
-    std::map<std::string, float> floatvalmap;
-    std::map<std::string, double> doublevalmap;
-    std::map<std::string, int> intvalmap;
-    std::map<std::string, uint64_t> uint64valmap;
     while (TBranch *thisbranch = static_cast<TBranch *>(iter.Next()))
     {
       // this convoluted expression returns the data type of a split branch
       std::string DataType = thisbranch->GetLeaf(thisbranch->GetName())->GetTypeName();
       if (DataType == "Float_t")
       {
-        auto itermap = floatvalmap.insert(std::make_pair(thisbranch->GetName(), std::numeric_limits<float>::quiet_NaN()));
-        m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &(itermap.first)->second);
+        int handle = m_FloatColumns.add(thisbranch->GetName());
+        m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &floatvals[handle]);
       }
       if (DataType == "Double_t")
       {
-        auto itermap = doublevalmap.insert(std::make_pair(thisbranch->GetName(), std::numeric_limits<double>::quiet_NaN()));
-        m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &(itermap.first)->second);
+        int handle = m_DoubleColumns.add(thisbranch->GetName());
+        m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &doublevals[handle]);
       }
       if (DataType == "Int_t")
       {
-        auto itermap = intvalmap.insert(std::make_pair(thisbranch->GetName(), std::numeric_limits<int>::min()));
-        m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &(itermap.first)->second);
-      }
-      if (DataType == "ULong_t")
-      {
-        auto itermap = uint64valmap.insert(std::make_pair(thisbranch->GetName(), std::numeric_limits<uint64_t>::max()));
-        m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &(itermap.first)->second);
-      }
-    }
-    for (auto entry = 0; entry < m_TTree[MultipleEntries]->GetEntries(); ++entry)
-    {
-      for (auto &field : floatvalmap)
-      {
-        field.second = std::numeric_limits<float>::quiet_NaN();
-      }
-      for (auto &field : doublevalmap)
-      {
-        field.second = std::numeric_limits<double>::quiet_NaN();
-      }
-      for (auto &field : intvalmap)
-      {
-        field.second = std::numeric_limits<int>::min();
-      }
-      for (auto &field : uint64valmap)
-      {
-        field.second = std::numeric_limits<uint64_t>::max();
-      }
-      m_TTree[MultipleEntries]->GetEntry(entry);
-      int ID = intvalmap.find("IID")->second;
-      std::map<std::string, float> tmp_floatvalmap;
-      for (auto &field : floatvalmap)
-      {
-        if (!std::isnan(field.second))
-        {
-          tmp_floatvalmap.insert(std::make_pair(field.first, field.second));
-        }
-      }
-      if (!tmp_floatvalmap.empty())
-      {
-        m_FloatEntryMap.insert(std::make_pair(ID, tmp_floatvalmap));
-      }
-
-      std::map<std::string, double> tmp_doublevalmap;
-      for (auto &field : doublevalmap)
-      {
-        if (!std::isnan(field.second))
-        {
-          tmp_doublevalmap.insert(std::make_pair(field.first, field.second));
-        }
-      }
-      if (!tmp_doublevalmap.empty())
-      {
-        m_DoubleEntryMap.insert(std::make_pair(ID, tmp_doublevalmap));
-      }
-
-      std::map<std::string, int> tmp_intvalmap;
-      for (auto &field : intvalmap)
-      {
-        if (field.second != std::numeric_limits<int>::min() && field.first != "IID")
+        // the channel ID is not a calibration column
+        if (std::string(thisbranch->GetName()) == "IID")
         {
-          tmp_intvalmap.insert(std::make_pair(field.first, field.second));
+          hasID = true;
+          m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &ID);
         }
-      }
-      if (!tmp_intvalmap.empty())
-      {
-        m_IntEntryMap.insert(std::make_pair(ID, tmp_intvalmap));
-      }
-
-      std::map<std::string, uint64_t> tmp_uint64valmap;
-      for (auto &field : uint64valmap)
-      {
-        if (field.second != std::numeric_limits<uint64_t>::max())
+        else
         {
-          tmp_uint64valmap.insert(std::make_pair(field.first, field.second));
+          int handle = m_IntColumns.add(thisbranch->GetName());
+          m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &intvals[handle]);
         }
       }
-      if (!tmp_uint64valmap.empty())
+      if (DataType == "ULong_t")
       {
-        m_UInt64EntryMap.insert(std::make_pair(ID, tmp_uint64valmap));
+        int handle = m_UInt64Columns.add(thisbranch->GetName());
+        m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &uint64vals[handle]);
       }
     }
+    if (!hasID)
+    {
+      std::cout << PHWHERE << " no IID branch in " << m_TTree[MultipleEntries]->GetName()
+                << " from " << f->GetName() << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    const auto nentries = m_TTree[MultipleEntries]->GetEntries();
+    m_Channels.reserve(nentries);
+    m_FloatColumns.reserve(nentries);
+    m_DoubleColumns.reserve(nentries);
+    m_IntColumns.reserve(nentries);
+    m_UInt64Columns.reserve(nentries);
+    for (auto entry = 0; entry < nentries; ++entry)
+    {
+      m_TTree[MultipleEntries]->GetEntry(entry);
+      // like for the maps, the first entry of a channel is the one returned
+      m_ChannelIndex.insert(std::make_pair(ID, static_cast<int>(m_Channels.size())));
+      m_Channels.push_back(ID);
+      m_FloatColumns.append(floatvals);
+      m_DoubleColumns.append(doublevals);
+      m_IntColumns.append(intvals);
+      m_UInt64Columns.append(uint64vals);
+    }
   }
+  m_ColumnsLoaded = true;
   for (auto *ttree : m_TTree)
   {
     delete ttree;
@@ -681,10 +656,20 @@ float CDBTTree::GetSingleFloatValue(const std::string &name, int verbose)
 
 float CDBTTree::GetFloatValue(int channel, const std::string &name, int verbose)
 {
-  if (m_FloatEntryMap.empty())
+  if (!m_ColumnsLoaded && m_FloatEntryMap.empty())
   {
     LoadCalibrations();
   }
+  if (m_ColumnsLoaded)
+  {
+    const float value = m_FloatColumns.value(GetChannelIndex(channel), m_FloatColumns.handle("F" + name), std::numeric_limits<float>::quiet_NaN());
+    if (std::isnan(value) && (verbosity > 0 || verbose > 0))
+    {
+      std::cout << PHWHERE << " Could not find " << name << " for channel " << channel
+                << " in float calibrations" << std::endl;
+    }
+    return value;
+  }
   auto channelmapiter = m_FloatEntryMap.find(channel);
   if (channelmapiter == m_FloatEntryMap.end())
   {
@@ -737,10 +722,20 @@ double CDBTTree::GetSingleDoubleValue(const std::string &name, int verbose)
 
 double CDBTTree::GetDoubleValue(int channel, const std::string &name, int verbose)
 {
-  if (m_DoubleEntryMap.empty())
+  if (!m_ColumnsLoaded && m_DoubleEntryMap.empty())
   {
     LoadCalibrations();
   }
+  if (m_ColumnsLoaded)
+  {
+    const double value = m_DoubleColumns.value(GetChannelIndex(channel), m_DoubleColumns.handle("D" + name), std::numeric_limits<double>::quiet_NaN());
+    if (std::isnan(value) && (verbosity > 0 || verbose > 0))
+    {
+      std::cout << PHWHERE << " Could not find " << name << " for channel " << channel
+                << " in double calibrations" << std::endl;
+    }
+    return value;
+  }
   auto channelmapiter = m_DoubleEntryMap.find(channel);
   if (channelmapiter == m_DoubleEntryMap.end())
   {
@@ -793,10 +788,20 @@ int CDBTTree::GetSingleIntValue(const std::string &name, int verbose)
 
 int CDBTTree::GetIntValue(int channel, const std::string &name, int verbose)
 {
-  if (m_IntEntryMap.empty())
+  if (!m_ColumnsLoaded && m_IntEntryMap.empty())
   {
     LoadCalibrations();
   }
+  if (m_ColumnsLoaded)
+  {
+    const int value = m_IntColumns.value(GetChannelIndex(channel), m_IntColumns.handle("I" + name), std::numeric_limits<int>::min());
+    if (value == std::numeric_limits<int>::min() && (verbosity > 0 || verbose > 0))
+    {
+      std::cout << PHWHERE << " Could not find " << name << " for channel " << channel
+                << " in int calibrations" << std::endl;
+    }
+    return value;
+  }
   auto channelmapiter = m_IntEntryMap.find(channel);
   if (channelmapiter == m_IntEntryMap.end())
   {
@@ -849,10 +854,20 @@ uint64_t CDBTTree::GetSingleUInt64Value(const std::string &name, int verbose)
 
 uint64_t CDBTTree::GetUInt64Value(int channel, const std::string &name, int verbose)
 {
-  if (m_UInt64EntryMap.empty())
+  if (!m_ColumnsLoaded && m_UInt64EntryMap.empty())
   {
     LoadCalibrations();
   }
+  if (m_ColumnsLoaded)
+  {
+    const uint64_t value = m_UInt64Columns.value(GetChannelIndex(channel), m_UInt64Columns.handle("g" + name), std::numeric_limits<uint64_t>::max());
+    if (value == std::numeric_limits<uint64_t>::max() && (verbosity > 0 || verbose > 0))
+    {
+      std::cout << PHWHERE << " Could not find " << name << " for channel " << channel
+                << " in uint64 calibrations" << std::endl;
+    }
+    return value;
+  }
   auto channelmapiter = m_UInt64EntryMap.find(channel);
   if (channelmapiter == m_UInt64EntryMap.end())
   {
@@ -875,3 +890,127 @@ uint64_t CDBTTree::GetUInt64Value(int channel, const std::string &name, int verb
   }
   return calibiter->second;
 }
+
+int CDBTTree::GetFloatColumnHandle(const std::string &name)
+{
+  if (!m_ColumnsLoaded)
+  {
+    LoadCalibrations();
+  }
+  return m_FloatColumns.handle("F" + name);
+}
+
+int CDBTTree::GetDoubleColumnHandle(const std::string &name)
+{
+  if (!m_ColumnsLoaded)
+  {
+    LoadCalibrations();
+  }
+  return m_DoubleColumns.handle("D" + name);
+}
+
+int CDBTTree::GetIntColumnHandle(const std::string &name)
+{
+  if (!m_ColumnsLoaded)
+  {
+    LoadCalibrations();
+  }
+  return m_IntColumns.handle("I" + name);
+}
+
+int CDBTTree::GetUInt64ColumnHandle(const std::string &name)
+{
+  if (!m_ColumnsLoaded)
+  {
+    LoadCalibrations();
+  }
+  return m_UInt64Columns.handle("g" + name);
+}
+
+float CDBTTree::GetFloatColumnValue(int channel, int handle) const
+{
+  return m_FloatColumns.value(GetChannelIndex(channel), handle, std::numeric_limits<float>::quiet_NaN());
+}
+
+double CDBTTree::GetDoubleColumnValue(int channel, int handle) const
+{
+  return m_DoubleColumns.value(GetChannelIndex(channel), handle, std::numeric_limits<double>::quiet_NaN());
+}
+
+int CDBTTree::GetIntColumnValue(int channel, int handle) const
+{
+  return m_IntColumns.value(GetChannelIndex(channel), handle, std::numeric_limits<int>::min());
+}
+
+uint64_t CDBTTree::GetUInt64ColumnValue(int channel, int handle) const
+{
+  return m_UInt64Columns.value(GetChannelIndex(channel), handle, std::numeric_limits<uint64_t>::max());
+}
+
+const std::vector<int> &CDBTTree::GetChannels()
+{
+  if (!m_ColumnsLoaded)
+  {
+    LoadCalibrations();
+  }
+  return m_Channels;
+}
+
+int CDBTTree::GetChannelIndex(int channel) const
+{
+  auto iter = m_ChannelIndex.find(channel);
+  return iter == m_ChannelIndex.end() ? -1 : iter->second;
+}
+
+const std::vector<float> &CDBTTree::GetFloatColumn(int handle) const
+{
+  static const std::vector<float> empty;
+  return handle < 0 ? empty : m_FloatColumns.column(handle);
+}
+
+bool CDBTTree::GetFloatColumn(const std::string &name, const std::vector<int> &channels, std::vector<float> &values)
+{
+  const int handle = GetFloatColumnHandle(name);
+  values.resize(channels.size());
+  for (size_t i = 0; i < channels.size(); ++i)
+  {
+    values[i] = GetFloatColumnValue(channels[i], handle);
+  }
+  return handle >= 0;
+}
+
+namespace
+{
+  // copy the set values of all columns into per channel maps, skipping the missing ones
+  template <class T, class C>
+  void fill_entry_map(std::map<int, std::map<std::string, T>> &entrymap, const C &columns,
+                      const std::unordered_map<int, int> &channelindex,
+                      const T missing)
+  {
+    for (const auto &[channel, index] : channelindex)
+    {
+      std::map<std::string, T> values;
+      for (int handle = 0; handle < columns.size(); ++handle)
+      {
+        const T value = columns.column(handle)[index];
+        const bool is_missing = (value != value) || value == missing;  // NaN test for floating point types
+        if (!is_missing)
+        {
+          values.insert(std::make_pair(columns.name(handle), value));
+        }
+      }
+      if (!values.empty())
+      {
+        entrymap.insert(std::make_pair(channel, values));
+      }
+    }
+  }
+}  // namespace
+
+void CDBTTree::FillEntryMapsFromColumns()
+{
+  fill_entry_map(m_FloatEntryMap, m_FloatColumns, m_ChannelIndex, std::numeric_limits<float>::quiet_NaN());
+  fill_entry_map(m_DoubleEntryMap, m_DoubleColumns, m_ChannelIndex, std::numeric_limits<double>::quiet_NaN());
+  fill_entry_map(m_IntEntryMap, m_IntColumns, m_ChannelIndex, std::numeric_limits<int>::min());
+  fill_entry_map(m_UInt64EntryMap, m_UInt64Columns, m_ChannelIndex, std::numeric_limits<uint64_t>::max());
+}
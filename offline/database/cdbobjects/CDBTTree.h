@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class TTree;
 
@@ -39,7 +41,106 @@ class CDBTTree
   uint64_t GetSingleUInt64Value(const std::string &name, int verbose = 0);
   uint64_t GetUInt64Value(int channel, const std::string &name, int verbose = 0);
 
+  //!@name columnar access to the per channel values
+  /**
+   * LoadCalibrations() stores each per channel field as one contiguous array
+   * with one value per tree entry, GetChannels() giving the channel of each entry.
+   * A field name is resolved once into a column handle (-1 if the field does not exist),
+   * the values are then read without string lookups.
+   * Missing values are returned as by GetFloatValue() etc.: NaN for float and double,
+   * the smallest int and the largest uint64_t
+   */
+  //@{
+  int GetFloatColumnHandle(const std::string &name);
+  int GetDoubleColumnHandle(const std::string &name);
+  int GetIntColumnHandle(const std::string &name);
+  int GetUInt64ColumnHandle(const std::string &name);
+
+  float GetFloatColumnValue(int channel, int handle) const;
+  double GetDoubleColumnValue(int channel, int handle) const;
+  int GetIntColumnValue(int channel, int handle) const;
+  uint64_t GetUInt64ColumnValue(int channel, int handle) const;
+
+  //! channel of each entry
+  const std::vector<int> &GetChannels();
+
+  //! entry of a channel, -1 if the channel does not exist
+  int GetChannelIndex(int channel) const;
+
+  //! all values of a float field, in the order of GetChannels(). Empty for an invalid handle
+  const std::vector<float> &GetFloatColumn(int handle) const;
+
+  //! values of a float field for a list of channels. Returns false if the field does not exist
+  bool GetFloatColumn(const std::string &name, const std::vector<int> &channels, std::vector<float> &values);
+  //@}
+
  private:
+  //! per channel values of one type, one vector per field
+  template <class T>
+  class ColumnSet
+  {
+   public:
+    //! add a column, returns its handle
+    int add(const std::string &fieldname)
+    {
+      int handle = m_columns.size();
+      m_handles.insert(std::make_pair(fieldname, handle));
+      m_names.push_back(fieldname);
+      m_columns.emplace_back();
+      return handle;
+    }
+
+    //! handle of a column, -1 if it does not exist
+    int handle(const std::string &fieldname) const
+    {
+      auto iter = m_handles.find(fieldname);
+      return iter == m_handles.end() ? -1 : iter->second;
+    }
+
+    void reserve(size_t n)
+    {
+      for (auto &column : m_columns)
+      {
+        column.reserve(n);
+      }
+    }
+
+    //! append one entry, values are indexed by handle
+    void append(const std::vector<T> &values)
+    {
+      for (size_t i = 0; i < m_columns.size(); ++i)
+      {
+        m_columns[i].push_back(values[i]);
+      }
+    }
+
+    //! value of a column at a given entry, missing if either is invalid
+    T value(int index, int handle, T missing) const
+    {
+      return (index < 0 || handle < 0) ? missing : m_columns[handle][index];
+    }
+
+    const std::vector<T> &column(int handle) const { return m_columns[handle]; }
+    const std::string &name(int handle) const { return m_names[handle]; }
+    int size() const { return m_columns.size(); }
+
+    void clear()
+    {
+      m_handles.clear();
+      m_names.clear();
+      m_columns.clear();
+    }
+
+   private:
+    std::unordered_map<std::string, int> m_handles;
+    std::vector<std::string> m_names;
+    std::vector<std::vector<T>> m_columns;
+  };
+
+  //! fill the per channel maps from the columns, used for printing loaded calibrations
+  void FillEntryMapsFromColumns();
+
+
   enum
   {
     SingleEntries = 0,
@@ -59,6 +160,15 @@ class CDBTTree
   std::map<std::string, int> m_SingleIntEntryMap;
   std::map<int, std::map<std::string, uint64_t>> m_UInt64EntryMap;
   std::map<std::string, uint64_t> m_SingleUInt64EntryMap;
+
+  //! true once the per channel values were read from file
+  bool m_ColumnsLoaded = false;
+  std::vector<int> m_Channels;
+  std::unordered_map<int, int> m_ChannelIndex;
+  ColumnSet<float> m_FloatColumns;
+  ColumnSet<double> m_DoubleColumns;
+  ColumnSet<int> m_IntColumns;
+  ColumnSet<uint64_t> m_UInt64Columns;
 };
 
 #endif
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <utility>  // for make_pair
 
 SphenixClient::SphenixClient(const std::string& gt_name)
   : nopayloadclient::NoPayloadClient(gt_name)
@@ -100,6 +101,31 @@ std::string SphenixClient::getCalibration(const std::string& pl_type, long long
   return resp["msg"];
 }
 
+int SphenixClient::getCalibrations(long long iov, std::map<std::string, std::string>& urls)
+{
+  urls.clear();
+  nlohmann::json resp = getPayloadIOVs(iov);
+  if (resp["code"] != 0)
+  {
+    if (m_Verbosity > 0)
+    {
+      std::cout << resp << std::endl;
+    }
+    return resp["code"];
+  }
+  for (auto& piov : resp["msg"].items())
+  {
+    // same validity condition as in getUrl()
+    if (piov.value()["minor_iov_end"] <= iov)
+    {
+      continue;
+    }
+    std::string payloadurl = piov.value()["payload_url"];
+    urls.insert(std::make_pair(piov.key(), payloadurl));
+  }
+  return 0;
+}
+
 nlohmann::json SphenixClient::unlockGlobalTag(const std::string& gt_name)
 {
   if (existGlobalTag(gt_name))
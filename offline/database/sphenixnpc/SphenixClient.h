@@ -5,6 +5,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <map>
 #include <set>
 #include <string>
 
@@ -29,6 +30,8 @@ class SphenixClient : public nopayloadclient::NoPayloadClient
   nlohmann::json insertPayload(const std::string& pl_type, const std::string& file_url, long long iov_start, long long iov_end) override;
   nlohmann::json setGlobalTag(const std::string& name) override;
   std::string getCalibration(const std::string& pl_type, long long iov);
+  // all payload urls valid for iov (domain -> url) from a single db query, returns the db response code
+  int getCalibrations(long long iov, std::map<std::string, std::string>& urls);
   nlohmann::json unlockGlobalTag(const std::string& tagname) override;
   nlohmann::json lockGlobalTag(const std::string& tagname) override;
   nlohmann::json deletePayloadIOV(const std::string& pl_type, long long iov_start, long long iov_end) override;
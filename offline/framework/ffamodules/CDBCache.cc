@@ -0,0 +1,167 @@
+#include "CDBCache.h"
+
+#include <phool/phool.h>
+
+#include <nlohmann/json.hpp>
+
+#include <TMD5.h>
+#include <TSystem.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>  // for operator<<, basic_ostream, endl
+#include <system_error>  // for error_code
+#include <utility>       // for pair
+
+namespace
+{
+  // payloads are immutable once they are in the db, so the url is good enough
+  // to find an already cached copy
+  std::string md5_string(const std::string &str)
+  {
+    TMD5 md5;
+    md5.Update(reinterpret_cast<const UChar_t *>(str.data()), str.size());
+    md5.Final();
+    return md5.AsString();
+  }
+
+  std::string tmp_suffix()
+  {
+    return std::string(".tmp.") + gSystem->HostName() + "." + std::to_string(gSystem->GetPid());
+  }
+}  // namespace
+
+CDBCache::CDBCache(const std::string &cachedir)
+  : m_CacheDir(cachedir)
+{
+}
+
+std::string CDBCache::urlFileName(const std::string &globaltag, uint64_t timestamp) const
+{
+  return m_CacheDir + "/urls/" + globaltag + "/" + std::to_string(timestamp) + ".json";
+}
+
+bool CDBCache::getUrls(const std::string &globaltag, uint64_t timestamp, std::map<std::string, std::string> &urls) const
+{
+  urls.clear();
+  std::string filename = urlFileName(globaltag, timestamp);
+  std::ifstream infile(filename);
+  if (!infile.is_open())
+  {
+    return false;
+  }
+  nlohmann::json urldict = nlohmann::json::parse(infile, nullptr, false);
+  if (urldict.is_discarded() || !urldict.is_object())
+  {
+    std::cout << PHWHERE << " cannot parse " << filename << ", ignoring it" << std::endl;
+    return false;
+  }
+  for (auto &item : urldict.items())
+  {
+    if (item.value().is_string())
+    {
+      urls.insert(std::make_pair(item.key(), item.value().get<std::string>()));
+    }
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "CDBCache: read " << urls.size() << " urls from " << filename << std::endl;
+  }
+  return true;
+}
+
+void CDBCache::saveUrls(const std::string &globaltag, uint64_t timestamp, const std::map<std::string, std::string> &urls) const
+{
+  std::string filename = urlFileName(globaltag, timestamp);
+  nlohmann::json urldict(urls);
+  if (!atomicWrite(filename, urldict.dump(1)))
+  {
+    std::cout << PHWHERE << " could not write " << filename << std::endl;
+    return;
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "CDBCache: saved " << urls.size() << " urls to " << filename << std::endl;
+  }
+}
+
+std::string CDBCache::getPayload(const std::string &url) const
+{
+  std::error_code ec;
+  std::string indexfile = m_CacheDir + "/payloads/index/" + md5_string(url) + ".json";
+  std::ifstream infile(indexfile);
+  if (infile.is_open())
+  {
+    nlohmann::json index = nlohmann::json::parse(infile, nullptr, false);
+    if (!index.is_discarded() && index.value("url", "") == url)
+    {
+      std::string cachedfile = m_CacheDir + "/" + index.value("file", "");
+      if (std::filesystem::is_regular_file(cachedfile, ec))
+      {
+        return cachedfile;
+      }
+    }
+  }
+  // only local files (including cvmfs) can be cached
+  if (!std::filesystem::is_regular_file(url, ec))
+  {
+    return url;
+  }
+  TMD5 *md5 = TMD5::FileChecksum(url.c_str());
+  if (!md5)
+  {
+    return url;
+  }
+  std::string relname = "payloads/" + std::string(md5->AsString()) + "/" + std::filesystem::path(url).filename().string();
+  delete md5;
+  std::string cachedfile = m_CacheDir + "/" + relname;
+  if (!std::filesystem::is_regular_file(cachedfile, ec))
+  {
+    std::filesystem::create_directories(std::filesystem::path(cachedfile).parent_path(), ec);
+    std::string tmpname = cachedfile + tmp_suffix();
+    std::filesystem::copy_file(url, tmpname, std::filesystem::copy_options::overwrite_existing, ec);
+    if (!ec)
+    {
+      std::filesystem::rename(tmpname, cachedfile, ec);
+    }
+    if (ec)
+    {
+      std::cout << PHWHERE << " could not cache " << url << ": " << ec.message() << std::endl;
+      std::filesystem::remove(tmpname, ec);
+      return url;
+    }
+  }
+  nlohmann::json index = {{"url", url}, {"file", relname}};
+  atomicWrite(indexfile, index.dump());
+  if (m_Verbosity > 0)
+  {
+    std::cout << "CDBCache: " << url << " cached as " << cachedfile << std::endl;
+  }
+  return cachedfile;
+}
+
+bool CDBCache::atomicWrite(const std::string &filename, const std::string &content)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(filename).parent_path(), ec);
+  std::string tmpname = filename + tmp_suffix();
+  {
+    std::ofstream outfile(tmpname);
+    if (!outfile.is_open())
+    {
+      return false;
+    }
+    outfile << content << std::endl;
+    if (!outfile.good())
+    {
+      return false;
+    }
+  }
+  std::filesystem::rename(tmpname, filename, ec);
+  if (ec)
+  {
+    std::filesystem::remove(tmpname, ec);
+    return false;
+  }
+  return true;
+}
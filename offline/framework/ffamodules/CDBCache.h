@@ -0,0 +1,53 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAMODULES_CDBCACHE_H
+#define FFAMODULES_CDBCACHE_H
+
+#include <cstdint>  // for uint64_t
+#include <map>
+#include <string>
+
+/**
+ * Local, file based cache for the conditions db used by CDBInterface.
+ *
+ * Layout of the cache directory:
+ *   urls/<global tag>/<timestamp>.json   all payload urls (domain -> url) valid
+ *                                        for this global tag and timestamp
+ *   payloads/<md5>/<file name>           copies of payload files, addressed by their content
+ *   payloads/index/<md5 of url>.json     payload url -> md5 of its content
+ *
+ * Files are written to a temporary name and renamed, so many jobs can share
+ * one cache directory. A cache directory filled by hand (or by running once
+ * with database access) can be used without any database access.
+ */
+class CDBCache
+{
+ public:
+  explicit CDBCache(const std::string &cachedir);
+  ~CDBCache() = default;
+
+  //! read the payload urls for a global tag and timestamp, false if they are not cached
+  bool getUrls(const std::string &globaltag, uint64_t timestamp, std::map<std::string, std::string> &urls) const;
+
+  //! store the payload urls for a global tag and timestamp
+  void saveUrls(const std::string &globaltag, uint64_t timestamp, const std::map<std::string, std::string> &urls) const;
+
+  //! local copy of a payload file, the url is returned unchanged if it cannot be cached
+  std::string getPayload(const std::string &url) const;
+
+  const std::string &CacheDir() const { return m_CacheDir; }
+
+  void Verbosity(int i) { m_Verbosity = i; }
+  int Verbosity() const { return m_Verbosity; }
+
+ private:
+  //! write to a temporary file first so concurrent readers never see partial files
+  static bool atomicWrite(const std::string &filename, const std::string &content);
+
+  std::string urlFileName(const std::string &globaltag, uint64_t timestamp) const;
+
+  std::string m_CacheDir;
+  int m_Verbosity{0};
+};
+
+#endif  // FFAMODULES_CDBCACHE_H
@@ -1,4 +1,5 @@
 #include "CDBInterface.h"
+#include "CDBCache.h"
 
 #include <sphenixnpc/SphenixClient.h>
 
@@ -22,6 +23,7 @@
 
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <map>
 #include <utility>   // for pair
 #include <vector>    // for vector
 
@@ -50,6 +52,20 @@ CDBInterface::CDBInterface(const std::string &name)
 CDBInterface::~CDBInterface()
 {
   delete cdbclient;
+  delete m_Cache;
+}
+
+//____________________________________________________________________________..
+int CDBInterface::InitRun(PHCompositeNode * /*topNode*/)
+{
+  recoConsts *rc = recoConsts::instance();
+  // modules which need the flags complain in getUrl() if they are not set
+  if (disable || !rc->FlagExist("CDB_GLOBALTAG") || !rc->FlagExist("TIMESTAMP"))
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  prefetch(rc->get_uint64Flag("TIMESTAMP"));
+  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 //____________________________________________________________________________..
@@ -121,37 +137,28 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
   }
   std::string domain_noconst = domain;
   recoConsts *rc = recoConsts::instance();
-  if (!rc->FlagExist("CDB_GLOBALTAG"))
-  {
-    std::cout << PHWHERE << "CDB_GLOBALTAG flag needs to be set via" << std::endl;
-    std::cout << "rc->set_StringFlag(\"CDB_GLOBALTAG\",<global tag>)" << std::endl;
-    gSystem->Exit(1);
-  }
+  std::string globaltag = globalTag();
   if (!rc->FlagExist("TIMESTAMP"))
   {
     std::cout << PHWHERE << "TIMESTAMP flag needs to be set via" << std::endl;
     std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
     gSystem->Exit(1);
   }
-  if (cdbclient == nullptr)
-  {
-    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
-  }
   uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
   if (Verbosity() > 0)
   {
-    std::cout << "Global Tag: " << rc->get_StringFlag("CDB_GLOBALTAG")
+    std::cout << "Global Tag: " << globaltag
               << ", domain: " << domain_noconst
               << ", timestamp: " << timestamp;
   }
-  std::string return_url = cdbclient->getCalibration(domain_noconst, timestamp);
+  std::string return_url = lookupUrl(globaltag, domain_noconst, timestamp);
   if (return_url.empty())
   {
     if (!disable_default)
     {
       std::string domain_copy = domain_noconst;
       domain_noconst = domain_noconst + "_default";
-      return_url = cdbclient->getCalibration(domain_noconst, timestamp);
+      return_url = lookupUrl(globaltag, domain_noconst, timestamp);
       if (return_url.empty())
       {
         if (Verbosity() > 0)
@@ -184,5 +191,104 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
     std::cout << PHWHERE << "not adding again " << domain_noconst << ", url: " << return_url
               << ", time stamp: " << timestamp << std::endl;
   }
+  // the original url is saved above, the job only reads the local copy
+  if (m_Cache && cache_payloads && !return_url.empty())
+  {
+    return m_Cache->getPayload(return_url);
+  }
   return return_url;
 }
+
+int CDBInterface::prefetch(uint64_t timestamp)
+{
+  std::string globaltag = globalTag();
+  auto key = std::make_pair(globaltag, timestamp);
+  if (m_UrlDict.contains(key))
+  {
+    return 0;
+  }
+  std::map<std::string, std::string> urls;
+  if (m_Cache && m_Cache->getUrls(globaltag, timestamp, urls))
+  {
+    m_UrlDict.insert(std::make_pair(key, urls));
+    return 0;
+  }
+  if (offline)
+  {
+    std::cout << PHWHERE << " running offline but no cached urls for global tag " << globaltag
+              << ", timestamp " << timestamp;
+    if (m_Cache)
+    {
+      std::cout << " in " << m_Cache->CacheDir();
+    }
+    std::cout << std::endl;
+    gSystem->Exit(1);
+  }
+  if (cdbclient == nullptr)
+  {
+    cdbclient = new SphenixClient(globaltag);
+  }
+  int iret = cdbclient->getCalibrations(timestamp, urls);
+  // failed queries are not remembered, lookupUrl() then asks the database for each domain
+  if (iret != 0)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "CDBInterface: prefetch failed for global tag " << globaltag
+                << ", timestamp " << timestamp << std::endl;
+    }
+    return iret;
+  }
+  if (m_Cache)
+  {
+    m_Cache->saveUrls(globaltag, timestamp, urls);
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "CDBInterface: prefetched " << urls.size() << " urls for global tag " << globaltag
+              << ", timestamp " << timestamp << std::endl;
+  }
+  m_UrlDict.insert(std::make_pair(key, urls));
+  return iret;
+}
+
+void CDBInterface::UseCache(const std::string &cachedir, bool cache_pl)
+{
+  delete m_Cache;
+  m_Cache = new CDBCache(cachedir);
+  m_Cache->Verbosity(Verbosity());
+  cache_payloads = cache_pl;
+}
+
+std::string CDBInterface::globalTag() const
+{
+  recoConsts *rc = recoConsts::instance();
+  if (!rc->FlagExist("CDB_GLOBALTAG"))
+  {
+    std::cout << PHWHERE << "CDB_GLOBALTAG flag needs to be set via" << std::endl;
+    std::cout << "rc->set_StringFlag(\"CDB_GLOBALTAG\",<global tag>)" << std::endl;
+    gSystem->Exit(1);
+  }
+  return rc->get_StringFlag("CDB_GLOBALTAG");
+}
+
+std::string CDBInterface::lookupUrl(const std::string &globaltag, const std::string &domain, uint64_t timestamp)
+{
+  auto dictiter = m_UrlDict.find(std::make_pair(globaltag, timestamp));
+  if (dictiter == m_UrlDict.end())
+  {
+    prefetch(timestamp);
+    dictiter = m_UrlDict.find(std::make_pair(globaltag, timestamp));
+    if (dictiter == m_UrlDict.end())
+    {
+      // prefetch failed, single lookup like without prefetching
+      return cdbclient->getCalibration(domain, timestamp);
+    }
+  }
+  auto urliter = dictiter->second.find(domain);
+  if (urliter == dictiter->second.end())
+  {
+    return "";
+  }
+  return urliter->second;
+}
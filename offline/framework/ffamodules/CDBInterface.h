@@ -6,10 +6,13 @@
 #include <fun4all/SubsysReco.h>
 
 #include <cstdint>  // for uint64_t
+#include <map>
 #include <set>
 #include <string>
-#include <tuple>  // for tuple
+#include <tuple>    // for tuple
+#include <utility>  // for pair
 
+class CDBCache;
 class PHCompositeNode;
 class SphenixClient;
 
@@ -20,6 +23,9 @@ class CDBInterface : public SubsysReco
 
   ~CDBInterface() override;
 
+  /// Prefetch the payload urls of all domains for the current TIMESTAMP
+  int InitRun(PHCompositeNode *topNode) override;
+
   /// Called at the end of all processing.
   int End(PHCompositeNode *topNode) override;
 
@@ -33,14 +39,31 @@ class CDBInterface : public SubsysReco
 
   std::string getUrl(const std::string &domain, const std::string &filename = "");
 
+  /// Resolve the payload urls of all domains for a timestamp with a single db query
+  int prefetch(uint64_t timestamp);
+
+  /// Keep resolved urls (and copies of the payload files if cache_payloads is set) in a local directory
+  void UseCache(const std::string &cachedir, bool cache_payloads = true);
+
+  /// Resolve urls only from the local cache, no db access at all
+  void Offline(bool b = true) { offline = b; }
+
  private:
   CDBInterface(const std::string &name = "CDBInterface");
 
   static CDBInterface *__instance;
+  std::string globalTag() const;
+  std::string lookupUrl(const std::string &globaltag, const std::string &domain, uint64_t timestamp);
+
   SphenixClient *cdbclient{nullptr};
+  CDBCache *m_Cache{nullptr};
   bool disable{false};
   bool disable_default{false};
+  bool offline{false};
+  bool cache_payloads{false};
   std::set<std::tuple<std::string, std::string, uint64_t>> m_UrlVector;
+  // (global tag, timestamp) -> (domain -> url)
+  std::map<std::pair<std::string, uint64_t>, std::map<std::string, std::string>> m_UrlDict;
 };
 
 #endif  // FFAMODULES_CDBINTERFACE_H
@@ -10,14 +10,77 @@
 
 #include <boost/tokenizer.hpp>
 
+#include <algorithm>  // for min
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <random>  // For retrying connections
+#include <set>
+#include <sstream>
 #include <string>
 #include <thread>
 
+std::map<FROG::CatalogKey, std::string> FROG::m_CatalogCache;
+bool FROG::m_SnapshotLoaded{false};
+bool FROG::m_SnapshotEnvChecked{false};
+unsigned long FROG::m_CacheHits{0};
+unsigned long FROG::m_CacheMisses{0};
+unsigned long FROG::m_BulkQueries{0};
+
+namespace
+{
+  // catalog database and selection of one storage class
+  struct StorageClass
+  {
+    std::string database;
+    std::string condition;
+  };
+
+  const std::map<std::string, StorageClass> &storage_classes()
+  {
+    static const std::map<std::string, StorageClass> classes = {
+        {"PG", {"FileCatalog_read", "full_host_name <> 'hpss' and full_host_name <> 'dcache' and full_host_name <> 'lustre'"}},
+        {"DCACHE", {"FileCatalog_read", "full_host_name = 'dcache'"}},
+        {"LUSTRE", {"FileCatalog_read", "full_host_name = 'lustre'"}},
+        {"RAWDATA", {"RawdataCatalog_read", "full_host_name = 'lustre'"}},
+        {"HPSSRAW", {"RawdataCatalog_read", "full_host_name = 'hpss'"}}};
+    return classes;
+  }
+
+  // storage class used by a GSEARCHPATH entry, empty for local paths
+  std::string storage_class(const std::string &searchpath)
+  {
+    // XRootD and MinIO access the files on lustre
+    if (searchpath == "XROOTD" || searchpath == "MINIO")
+    {
+      return "LUSTRE";
+    }
+    if (storage_classes().contains(searchpath))
+    {
+      return searchpath;
+    }
+    return "";
+  }
+
+  std::string sql_quote(const std::string &str)
+  {
+    std::string quoted = "'";
+    for (char c : str)
+    {
+      if (c == '\'')
+      {
+        quoted += '\'';
+      }
+      quoted += c;
+    }
+    return quoted + "'";
+  }
+
+  // maximum number of lfns in a single bulk query
+  const size_t max_bulk_size = 1000;
+}  // namespace
+
 const char *
 FROG::location(const std::string &logical_name)
 {
@@ -250,15 +313,33 @@ void FROG::Disconnect()
   m_OdbcConnectionMap.clear();
 }
 
-bool FROG::PGSearch(const std::string &lname)
+bool FROG::catalogLookup(const std::string &storage, const std::string &lname, std::string &path)
 {
-  bool bret = false;
-  odbc::Connection *odbc_connection = GetConnection("FileCatalog_read");
+  loadSnapshotFromEnv();
+  CatalogKey key = std::make_pair(storage, lname);
+  auto iter = m_CatalogCache.find(key);
+  if (iter != m_CatalogCache.end())
+  {
+    ++m_CacheHits;
+    path = iter->second;
+    return !path.empty();
+  }
+  ++m_CacheMisses;
+  if (m_SnapshotLoaded)
+  {
+    if (Verbosity() > 1)
+    {
+      std::cout << "FROG: " << lname << " (" << storage << ") not in snapshot" << std::endl;
+    }
+    return false;
+  }
+  const StorageClass &storageclass = storage_classes().at(storage);
+  odbc::Connection *odbc_connection = GetConnection(storageclass.database);
   if (!odbc_connection)
   {
-    return bret;
+    return false;
   }
-  std::string sqlquery = "SELECT full_file_path from files where lfn='" + lname + "' and full_host_name <> 'hpss' and full_host_name <> 'dcache' and full_host_name <> 'lustre'";
+  std::string sqlquery = "SELECT full_file_path from files where lfn=" + sql_quote(lname) + " and " + storageclass.condition;
 
   if (Verbosity() > 1)
   {
@@ -268,184 +349,289 @@ bool FROG::PGSearch(const std::string &lname)
   odbc::Statement *stmt = odbc_connection->createStatement();
   odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
 
+  path.clear();
   if (rs->next())
   {
-    pfn = rs->getString(1);
-    bret = true;
+    path = rs->getString(1);
   }
   delete rs;
   delete stmt;
-  return bret;
+  m_CatalogCache[key] = path;
+  return !path.empty();
 }
 
-bool FROG::dCacheSearch(const std::string &lname)
+int FROG::resolve(const std::vector<std::string> &logical_names)
 {
-  bool bret = false;
-  odbc::Connection *odbc_connection = GetConnection("FileCatalog_read");
-  if (!odbc_connection)
+  loadSnapshotFromEnv();
+  char *gsearchpath_env = getenv("GSEARCHPATH");
+  if (gsearchpath_env == nullptr || m_SnapshotLoaded)
   {
-    return bret;
+    return 0;
   }
-  std::string sqlquery = "SELECT full_file_path from files where lfn='" + lname + "' and full_host_name = 'dcache'";
-
-  if (Verbosity() > 1)
+  std::string gsearchpath(gsearchpath_env);
+  std::set<std::string> storages;
+  boost::char_separator<char> sep(":");
+  boost::tokenizer<boost::char_separator<char> > tok(gsearchpath, sep);
+  for (const auto &iter : tok)
   {
-    std::cout << "sql query:" << std::endl
-              << sqlquery << std::endl;
+    std::string storage = storage_class(iter);
+    if (!storage.empty())
+    {
+      storages.insert(storage);
+    }
   }
-  odbc::Statement *stmt = odbc_connection->createStatement();
-  odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
-
-  if (rs->next())
+  int nqueries = 0;
+  for (const auto &storage : storages)
   {
-    std::string dcachefile = rs->getString(1);
-    if (std::ifstream(dcachefile))
+    // same selection of logical names as in location()
+    std::set<std::string> lfnset;
+    std::vector<std::string> lfns;
+    for (const auto &lname : logical_names)
+    {
+      if (lname.empty() || lname.find('/') != std::string::npos ||
+          m_CatalogCache.contains(std::make_pair(storage, lname)) ||
+          !lfnset.insert(lname).second)
+      {
+        continue;
+      }
+      lfns.push_back(lname);
+    }
+    if (lfns.empty())
+    {
+      continue;
+    }
+    const StorageClass &storageclass = storage_classes().at(storage);
+    odbc::Connection *odbc_connection = GetConnection(storageclass.database);
+    if (!odbc_connection)
+    {
+      continue;
+    }
+    for (size_t first = 0; first < lfns.size(); first += max_bulk_size)
+    {
+      size_t last = std::min(first + max_bulk_size, lfns.size());
+      std::string sqlquery = "SELECT lfn, full_file_path from files where lfn in (";
+      for (size_t i = first; i < last; ++i)
+      {
+        if (i > first)
+        {
+          sqlquery += ",";
+        }
+        sqlquery += sql_quote(lfns[i]);
+      }
+      sqlquery += ") and " + storageclass.condition;
+      if (Verbosity() > 2)
+      {
+        std::cout << "sql query:" << std::endl
+                  << sqlquery << std::endl;
+      }
+      std::map<std::string, std::string> found;
+      try
+      {
+        odbc::Statement *stmt = odbc_connection->createStatement();
+        odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+        while (rs->next())
+        {
+          // like the single lookup, the first match is used
+          found.insert(std::make_pair(rs->getString(1), rs->getString(2)));
+        }
+        delete rs;
+        delete stmt;
+      }
+      catch (odbc::SQLException &e)
+      {
+        std::cout << PHWHERE << " Exception caught during bulk query for " << storage << std::endl;
+        std::cout << "Message: " << e.getMessage() << std::endl;
+        continue;
+      }
+      ++nqueries;
+      ++m_BulkQueries;
+      for (size_t i = first; i < last; ++i)
+      {
+        auto iter = found.find(lfns[i]);
+        m_CatalogCache[std::make_pair(storage, lfns[i])] = (iter == found.end()) ? "" : iter->second;
+      }
+    }
+    if (Verbosity() > 0)
     {
-      pfn = "dcache:" + dcachefile;
-      bret = true;
+      std::cout << "FROG: resolved " << lfns.size() << " files for " << storage << std::endl;
     }
   }
-  delete rs;
-  delete stmt;
-  return bret;
+  Disconnect();
+  return nqueries;
 }
 
-bool FROG::XRootDSearch(const std::string &lname)
+void FROG::loadSnapshotFromEnv()
 {
-  bool bret = false;
-  odbc::Connection *odbc_connection = GetConnection("FileCatalog_read");
-  if (!odbc_connection)
+  if (m_SnapshotEnvChecked)
   {
-    return bret;
+    return;
   }
-  std::string sqlquery = "SELECT full_file_path from files where lfn='" + lname + "' and full_host_name = 'lustre'";
-  if (Verbosity() > 1)
+  m_SnapshotEnvChecked = true;
+  char *snapshot_env = getenv("FROG_SNAPSHOT");
+  if (snapshot_env != nullptr)
   {
-    std::cout << "sql query:" << std::endl
-              << sqlquery << std::endl;
+    LoadSnapshot(snapshot_env);
   }
-  odbc::Statement *stmt = odbc_connection->createStatement();
-  odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+}
 
-  if (rs->next())
+bool FROG::LoadSnapshot(const std::string &filename)
+{
+  std::ifstream infile(filename);
+  if (!infile.is_open())
   {
-    std::string xrootdfile = rs->getString(1);
-    pfn = "root://xrdsphenix.rcf.bnl.gov/" + xrootdfile;
-    bret = true;
+    std::cout << PHWHERE << " could not open FROG snapshot " << filename << std::endl;
+    return false;
   }
-  delete rs;
-  delete stmt;
-  return bret;
+  std::string line;
+  int nentries = 0;
+  while (std::getline(infile, line))
+  {
+    std::istringstream linestream(line);
+    std::string storage;
+    std::string lname;
+    std::string path;
+    linestream >> storage >> lname >> path;
+    if (lname.empty() || !storage_classes().contains(storage))
+    {
+      continue;
+    }
+    m_CatalogCache[std::make_pair(storage, lname)] = path;
+    ++nentries;
+  }
+  m_SnapshotLoaded = true;
+  std::cout << "FROG: loaded " << nentries << " catalog entries from snapshot " << filename << std::endl;
+  return true;
 }
 
-bool FROG::LustreSearch(const std::string &lname)
+bool FROG::SaveSnapshot(const std::string &filename)
 {
-  bool bret = false;
-  odbc::Connection *odbc_connection = GetConnection("FileCatalog_read");
-  if (!odbc_connection)
+  std::ofstream outfile(filename);
+  if (!outfile.is_open())
   {
-    return bret;
+    std::cout << PHWHERE << " could not open FROG snapshot " << filename << std::endl;
+    return false;
   }
-  std::string sqlquery = "SELECT full_file_path from files where lfn='" + lname + "' and full_host_name = 'lustre'";
-
-  odbc::Statement *stmt = odbc_connection->createStatement();
-  odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
-
-  if (rs->next())
+  for (const auto &[key, path] : m_CatalogCache)
   {
-    pfn = rs->getString(1);
-    bret = true;
+    outfile << key.first << " " << key.second;
+    if (!path.empty())
+    {
+      outfile << " " << path;
+    }
+    outfile << "\n";
   }
-  delete rs;
-  delete stmt;
-  return bret;
+  return outfile.good();
 }
 
-bool FROG::MinIOSearch(const std::string &lname)
+void FROG::PrintStatistics()
 {
-  bool bret = false;
-  odbc::Connection *odbc_connection = GetConnection("FileCatalog_read");
-  if (!odbc_connection)
+  if (m_CacheHits + m_CacheMisses + m_BulkQueries == 0)
   {
-    return bret;
+    return;
   }
-  std::string sqlquery = "SELECT full_file_path from files where lfn='" + lname + "' and full_host_name = 'lustre'";
-
-  if (Verbosity() > 1)
+  std::cout << "FROG catalog lookups: " << m_CacheHits << " cache hits, "
+            << m_CacheMisses << " cache misses, "
+            << m_BulkQueries << " bulk queries, "
+            << m_CatalogCache.size() << " cached entries";
+  if (m_SnapshotLoaded)
   {
-    std::cout << "sql query:" << std::endl
-              << sqlquery << std::endl;
+    std::cout << " (from snapshot)";
   }
-  odbc::Statement *stmt = odbc_connection->createStatement();
-  odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+  std::cout << std::endl;
+}
 
-  if (rs->next())
+bool FROG::PGSearch(const std::string &lname)
+{
+  std::string path;
+  if (!catalogLookup("PG", lname, path))
   {
-    pfn = rs->getString(1);
-    std::string toreplace("/sphenix/lustre01/sphnxpro");
-    size_t strpos = pfn.find(toreplace);
-    if (strpos == std::string::npos)
-    {
-      std::cout << " could not locate " << toreplace
-                << " in full file path " << pfn << std::endl;
-      exit(1);
-    }
-    else if (strpos > 0)
-    {
-      std::cout << "full file path " << pfn
-                << "does not start with " << toreplace << std::endl;
-      exit(1);
-    }
-    pfn.replace(pfn.begin(), pfn.begin() + toreplace.size(), "s3://sphenixs3.rcf.bnl.gov:9000");
-    bret = true;
+    return false;
   }
-  delete rs;
-  delete stmt;
-  return bret;
+  pfn = path;
+  return true;
 }
 
-bool FROG::RawDataSearch(const std::string &lname)
+bool FROG::dCacheSearch(const std::string &lname)
 {
-  bool bret = false;
-  odbc::Connection *odbc_connection = GetConnection("RawdataCatalog_read");
-  if (!odbc_connection)
+  std::string dcachefile;
+  if (!catalogLookup("DCACHE", lname, dcachefile))
   {
-    return bret;
+    return false;
   }
-  std::string sqlquery = "SELECT full_file_path from files where lfn='" + lname + "' and full_host_name = 'lustre'";
+  if (std::ifstream(dcachefile))
+  {
+    pfn = "dcache:" + dcachefile;
+    return true;
+  }
+  return false;
+}
 
-  odbc::Statement *stmt = odbc_connection->createStatement();
-  odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+bool FROG::XRootDSearch(const std::string &lname)
+{
+  std::string xrootdfile;
+  if (!catalogLookup("LUSTRE", lname, xrootdfile))
+  {
+    return false;
+  }
+  pfn = "root://xrdsphenix.rcf.bnl.gov/" + xrootdfile;
+  return true;
+}
 
-  if (rs->next())
+bool FROG::LustreSearch(const std::string &lname)
+{
+  std::string path;
+  if (!catalogLookup("LUSTRE", lname, path))
   {
-    pfn = rs->getString(1);
-    bret = true;
+    return false;
   }
-  delete rs;
-  delete stmt;
-  return bret;
+  pfn = path;
+  return true;
 }
 
-bool FROG::HpssRawDataSearch(const std::string &lname)
+bool FROG::MinIOSearch(const std::string &lname)
 {
-  bool bret = false;
-  odbc::Connection *odbc_connection = GetConnection("RawdataCatalog_read");
-  if (!odbc_connection)
+  std::string path;
+  if (!catalogLookup("LUSTRE", lname, path))
+  {
+    return false;
+  }
+  pfn = path;
+  std::string toreplace("/sphenix/lustre01/sphnxpro");
+  size_t strpos = pfn.find(toreplace);
+  if (strpos == std::string::npos)
+  {
+    std::cout << " could not locate " << toreplace
+              << " in full file path " << pfn << std::endl;
+    exit(1);
+  }
+  else if (strpos > 0)
   {
-    return bret;
+    std::cout << "full file path " << pfn
+              << "does not start with " << toreplace << std::endl;
+    exit(1);
   }
-  std::string sqlquery = "SELECT full_file_path from files where lfn='" + lname + "' and full_host_name = 'hpss'";
+  pfn.replace(pfn.begin(), pfn.begin() + toreplace.size(), "s3://sphenixs3.rcf.bnl.gov:9000");
+  return true;
+}
 
-  odbc::Statement *stmt = odbc_connection->createStatement();
-  odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+bool FROG::RawDataSearch(const std::string &lname)
+{
+  std::string path;
+  if (!catalogLookup("RAWDATA", lname, path))
+  {
+    return false;
+  }
+  pfn = path;
+  return true;
+}
 
-  if (rs->next())
+bool FROG::HpssRawDataSearch(const std::string &lname)
+{
+  std::string path;
+  if (!catalogLookup("HPSSRAW", lname, path))
   {
-    pfn = rs->getString(1);
-    bret = true;
+    return false;
   }
-  delete rs;
-  delete stmt;
-  return bret;
+  pfn = path;
+  return true;
 }
@@ -5,6 +5,8 @@
 
 #include <map>
 #include <string>
+#include <utility>  // for pair
+#include <vector>
 
 namespace odbc
 {
@@ -29,7 +31,36 @@ class FROG
   void Verbosity(const int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
+  /**
+   * Resolve a list of logical file names for all catalog searches in GSEARCHPATH
+   * with one query per storage class. The results are kept for the lifetime of the job
+   * and used by location(). Returns the number of queries sent to the catalog
+   */
+  int resolve(const std::vector<std::string> &logical_names);
+
+  //!@name local catalog snapshot
+  /**
+   * A snapshot is a text file with one "<storage class> <lfn> [<full file path>]" line
+   * per lookup (no path if the file is not in this storage). Once a snapshot is loaded
+   * the catalog lookups are served from it only, without any database connection.
+   * If the environment variable FROG_SNAPSHOT is set, it is loaded on first use
+   */
+  //@{
+  static bool LoadSnapshot(const std::string &filename);
+  static bool SaveSnapshot(const std::string &filename);
+  //@}
+
+  //! print cache hit/miss statistics of catalog lookups
+  static void PrintStatistics();
+
  private:
+  //! storage class, logical name
+  using CatalogKey = std::pair<std::string, std::string>;
+
+  //! catalog lookup of the full file path of lname in a storage class, false if not found
+  bool catalogLookup(const std::string &storage, const std::string &lname, std::string &path);
+  static void loadSnapshotFromEnv();
+
   odbc::Connection *GetConnection(const std::string &database);
   void Disconnect();
   static const int m_MAX_NUM_RETRIES{3000};
@@ -39,6 +70,16 @@ class FROG
   std::map<std::string, odbc::Connection *> m_OdbcConnectionMap;
   int m_Verbosity{0};
   std::string pfn;
+
+  //!@name catalog results, shared by all FROG instances of a job. Empty path for files not found
+  //@{
+  static std::map<CatalogKey, std::string> m_CatalogCache;
+  static bool m_SnapshotLoaded;
+  static bool m_SnapshotEnvChecked;
+  static unsigned long m_CacheHits;
+  static unsigned long m_CacheMisses;
+  static unsigned long m_BulkQueries;
+  //@}
 };
 
 #endif
@@ -116,6 +116,52 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
   {
     outfile_open_first_write();  //    outfileopen(OutFileName());
   }
+  MarkNodesToWrite(startNode);
+  dstOut->write(startNode);
+  PHNodeIterator nodeiter(startNode);
+  // to save some cpu cycles we only make it globally transient if
+  // all nodes have been written (savenodes set is empty)
+  // else we only make the nodes transient which we have written (all
+  // others are transient by construction)
+  if (savenodes.empty())
+  {
+    Fun4AllServer *se = Fun4AllServer::instance();
+    se->MakeNodesTransient(startNode);
+  }
+  else
+  {
+    for (const auto &nodename : savenodes)
+    {
+      PHNode *ChosenNode = nodeiter.findFirst("PHIODataNode", nodename);
+      if (ChosenNode)
+      {
+        ChosenNode->makeTransient();
+      }
+    }
+  }
+  return 0;
+}
+
+int Fun4AllDstOutputManager::WriteMarkedNodes(PHCompositeNode *startNode)
+{
+  if (!m_SaveDstNodeFlag)
+  {
+    return 0;
+  }
+  if (!dstOut)
+  {
+    outfile_open_first_write();
+  }
+  dstOut->write(startNode);
+  return 0;
+}
+
+void Fun4AllDstOutputManager::MarkNodesToWrite(PHCompositeNode *startNode)
+{
+  if (!m_SaveDstNodeFlag)
+  {
+    return;
+  }
   PHNodeIterator nodeiter(startNode);
   if (savenodes.empty())
   {
@@ -171,28 +217,6 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
       }
     }
   }
-  dstOut->write(startNode);
-  // to save some cpu cycles we only make it globally transient if
-  // all nodes have been written (savenodes set is empty)
-  // else we only make the nodes transient which we have written (all
-  // others are transient by construction)
-  if (savenodes.empty())
-  {
-    Fun4AllServer *se = Fun4AllServer::instance();
-    se->MakeNodesTransient(startNode);
-  }
-  else
-  {
-    for (const auto &nodename : savenodes)
-    {
-      PHNode *ChosenNode = nodeiter.findFirst("PHIODataNode", nodename);
-      if (ChosenNode)
-      {
-        ChosenNode->makeTransient();
-      }
-    }
-  }
-  return 0;
 }
 
 int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
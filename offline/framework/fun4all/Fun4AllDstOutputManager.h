@@ -32,6 +32,9 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   void Print(const std::string &what = "ALL") const override;
 
   int Write(PHCompositeNode *startNode) override;
+  void MarkNodesToWrite(PHCompositeNode *startNode) override;
+  //! write the nodes below startNode as they are marked, does not change their persistency (used by the event slots)
+  int WriteMarkedNodes(PHCompositeNode *startNode);
   int WriteNode(PHCompositeNode *thisNode) override;
   const std::string &UsedOutFileName() const { return m_UsedOutFileName; }
   void CompressionSetting(const int i) override { m_CompressionSetting = i; }
@@ -0,0 +1,203 @@
+#include "Fun4AllEventSlotWriter.h"
+
+#include "Fun4AllDstOutputManager.h"
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHPointerListIterator.h>
+#include <phool/phool.h>
+
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TObject.h>
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+  // same as TObject::Clone() which is disabled for PHObjects
+  TObject *streamer_copy(TObject *obj)
+  {
+    TClass *cl = obj->IsA();
+    TObject *newobj = static_cast<TObject *>(cl->New());
+    if (!newobj)
+    {
+      return nullptr;
+    }
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.MapObject(obj);
+    obj->Streamer(buffer);
+    buffer.SetReadMode();
+    buffer.ResetMap();
+    buffer.SetBufferOffset(0);
+    buffer.MapObject(newobj);
+    newobj->Streamer(buffer);
+    newobj->ResetBit(kIsReferenced);
+    newobj->ResetBit(kCanDelete);
+    return newobj;
+  }
+}  // namespace
+
+Fun4AllEventSlotWriter::Fun4AllEventSlotWriter(const unsigned int nslots)
+  : Fun4AllBase("Fun4AllEventSlotWriter")
+  , m_NSlots(std::max(nslots, 2U))
+{
+  m_WriterThread = std::thread(&Fun4AllEventSlotWriter::WriterLoop, this);
+}
+
+Fun4AllEventSlotWriter::~Fun4AllEventSlotWriter()
+{
+  Drain();
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_QueueCondition.notify_all();
+  m_WriterThread.join();
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+PHCompositeNode *Fun4AllEventSlotWriter::CopyNodeTree(PHCompositeNode *startNode, const std::set<PHNode *> &nodes, std::map<PHNode *, PHNode *> &copies)
+{
+  PHCompositeNode *copyNode = new PHCompositeNode(startNode->getName());
+  PHNodeIterator nodeiter(startNode);
+  PHPointerListIterator<PHNode> iterat(nodeiter.ls());
+  PHNode *thisNode;
+  while ((thisNode = iterat()))
+  {
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      copyNode->addNode(CopyNodeTree(static_cast<PHCompositeNode *>(thisNode), nodes, copies));
+    }
+    else if (thisNode->getType() == "PHIODataNode" && nodes.contains(thisNode))
+    {
+      // nodes which are not written by any output manager are not copied
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      PHIODataNode<TObject> *ionode = static_cast<PHIODataNode<TObject> *>(thisNode);
+      TObject *obj = ionode->getData();
+      if (!obj)
+      {
+        continue;
+      }
+      TObject *objcopy = streamer_copy(obj);
+      if (!objcopy)
+      {
+        std::cout << PHWHERE << " cannot copy " << thisNode->getName()
+                  << " of class " << obj->ClassName() << std::endl;
+        continue;
+      }
+      PHIODataNode<TObject> *newnode = new PHIODataNode<TObject>(objcopy, thisNode->getName(), thisNode->getObjectType());
+      newnode->BufferSize(ionode->BufferSize());
+      newnode->SplitLevel(ionode->SplitLevel());
+      copyNode->addNode(newnode);
+      copies[thisNode] = newnode;
+    }
+  }
+  return copyNode;
+}
+
+void Fun4AllEventSlotWriter::Push(PHCompositeNode *dstNode, const WriteList &writelist)
+{
+  // the copy is made by the calling thread, the slot is only
+  // handed over when it is complete
+  std::set<PHNode *> allnodes;
+  for (const auto &writer : writelist)
+  {
+    allnodes.insert(writer.second.begin(), writer.second.end());
+  }
+  std::map<PHNode *, PHNode *> copies;
+  EventSlot slot;
+  slot.dstNode = CopyNodeTree(dstNode, allnodes, copies);
+  slot.nodes.reserve(copies.size());
+  for (const auto &copy : copies)
+  {
+    slot.nodes.push_back(copy.second);
+  }
+  for (const auto &[manager, nodes] : writelist)
+  {
+    auto &writer = slot.writers.emplace_back();
+    writer.first = manager;
+    for (auto *node : nodes)
+    {
+      auto iter = copies.find(node);
+      if (iter != copies.end())
+      {
+        writer.second.push_back(iter->second);
+      }
+    }
+  }
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  // one slot is always taken by the event which is being reconstructed
+  m_QueueCondition.wait(lock, [this]
+                        { return m_Queue.size() + (m_Busy ? 1 : 0) < m_NSlots - 1; });
+  m_Queue.push_back(std::move(slot));
+  m_MaxQueued = std::max(m_MaxQueued, static_cast<unsigned int>(m_Queue.size()));
+  lock.unlock();
+  m_QueueCondition.notify_all();
+}
+
+void Fun4AllEventSlotWriter::Drain()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_QueueCondition.wait(lock, [this]
+                        { return m_Queue.empty() && !m_Busy; });
+}
+
+void Fun4AllEventSlotWriter::WriterLoop()
+{
+  while (true)
+  {
+    EventSlot slot;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_QueueCondition.wait(lock, [this]
+                            { return m_Stop || !m_Queue.empty(); });
+      if (m_Queue.empty())
+      {
+        return;
+      }
+      slot = std::move(m_Queue.front());
+      m_Queue.pop_front();
+      m_Busy = true;
+    }
+    WriteSlot(slot);
+    delete slot.dstNode;
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_EventsWritten++;
+      m_Busy = false;
+    }
+    m_QueueCondition.notify_all();
+  }
+}
+
+void Fun4AllEventSlotWriter::WriteSlot(const EventSlot &slot)
+{
+  // the nodes of the slot belong to this thread, each manager
+  // writes the ones which were selected for it by the Fun4AllServer
+  for (const auto &[manager, nodes] : slot.writers)
+  {
+    for (auto *node : slot.nodes)
+    {
+      node->makeTransient();
+    }
+    for (auto *node : nodes)
+    {
+      node->makePersistent();
+    }
+    manager->IncrementEvents(1);
+    manager->WriteMarkedNodes(slot.dstNode);
+  }
+}
+
+void Fun4AllEventSlotWriter::Print(const std::string & /*what*/) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::cout << Name() << ": " << m_NSlots << " event slots, wrote " << m_EventsWritten
+            << " events, max queued: " << m_MaxQueued << std::endl;
+}
@@ -0,0 +1,85 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLEVENTSLOTWRITER_H
+#define FUN4ALL_FUN4ALLEVENTSLOTWRITER_H
+
+#include "Fun4AllBase.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>  // for pair
+#include <vector>
+
+class Fun4AllDstOutputManager;
+class PHCompositeNode;
+class PHNode;
+
+/** Writes events of Fun4AllDstOutputManagers on a background thread.
+ *
+ *  The nodes an event is written with are copied into their own node tree (an
+ *  event slot) which is handed to the writer thread, so the Fun4AllServer can reset
+ *  the node tree and read and reconstruct the next event while the previous ones
+ *  are written. With n slots, up to n-1 events are queued for writing, if all slots
+ *  are taken Push() blocks until the writer frees one.
+ *
+ *  The copy is a streamer round trip of every written object on the calling thread,
+ *  only the basket compression and the file io of the output managers run on the
+ *  writer thread. This pays off for compressed DSTs where these dominate the write,
+ *  an uncompressed write costs about as much as the copy.
+ *
+ *  Which nodes each output manager writes is decided on the calling thread, the
+ *  writer thread only sets the persistency of the nodes of its own copy and does not
+ *  use the Fun4AllServer. Closing output files (which writes the RUN node) is left
+ *  to the Fun4AllServer after Drain().
+ */
+
+class Fun4AllEventSlotWriter : public Fun4AllBase
+{
+ public:
+  //! output managers writing this event with the nodes below the dst node they write
+  using WriteList = std::vector<std::pair<Fun4AllDstOutputManager *, std::set<PHNode *>>>;
+
+  explicit Fun4AllEventSlotWriter(const unsigned int nslots);
+  ~Fun4AllEventSlotWriter() override;
+
+  void Print(const std::string &what = "ALL") const override;
+
+  //! copy the nodes of the write list into a free slot and queue it for writing
+  void Push(PHCompositeNode *dstNode, const WriteList &writelist);
+
+  //! wait until all queued events are written
+  void Drain();
+
+  //! deep copy of a node tree, only the PHIODataNodes in nodes are copied, copies maps them to their copies
+  static PHCompositeNode *CopyNodeTree(PHCompositeNode *startNode, const std::set<PHNode *> &nodes, std::map<PHNode *, PHNode *> &copies);
+
+ private:
+  struct EventSlot
+  {
+    PHCompositeNode *dstNode{nullptr};
+    //! all copied nodes
+    std::vector<PHNode *> nodes;
+    //! output managers with the copied nodes they write
+    std::vector<std::pair<Fun4AllDstOutputManager *, std::vector<PHNode *>>> writers;
+  };
+
+  void WriterLoop();
+  static void WriteSlot(const EventSlot &slot);
+
+  unsigned int m_NSlots{2};
+  unsigned int m_MaxQueued{0};
+  unsigned long m_EventsWritten{0};
+  bool m_Busy{false};
+  bool m_Stop{false};
+  std::deque<EventSlot> m_Queue;
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_QueueCondition;
+  std::thread m_WriterThread;
+};
+
+#endif
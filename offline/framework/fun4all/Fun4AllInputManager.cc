@@ -3,6 +3,8 @@
 #include "Fun4AllServer.h"
 #include "SubsysReco.h"
 
+#include <frog/FROG.h>
+
 #include <phool/phool.h>
 
 #include <boost/filesystem.hpp>
@@ -10,6 +12,7 @@
 #include <cstdint>  // for uintmax_t
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 Fun4AllInputManager::Fun4AllInputManager(const std::string &name, const std::string &nodename, const std::string &topnodename)
   : Fun4AllBase(name)
@@ -83,12 +86,14 @@ int Fun4AllInputManager::AddListFile(const std::string &filename, const int do_i
   }
   std::string FullLine;
   int nfiles = 0;
+  std::vector<std::string> filelist;
   getline(infile, FullLine);
   while (!infile.eof())
   {
     if (!FullLine.empty() && FullLine[0] != '#')  // remove comments
     {
       AddFile(FullLine);
+      filelist.push_back(FullLine);
       nfiles++;
     }
     else if (!FullLine.empty())
@@ -106,6 +111,12 @@ int Fun4AllInputManager::AddListFile(const std::string &filename, const int do_i
     std::cout << Name() << " listfile " << filename << " does not contain filenames "
               << "if this is the only list you load into this Input Manager your code will exit very soon" << std::endl;
   }
+  else
+  {
+    // resolve the whole list in the file catalog at once instead of one query per file
+    FROG frog;
+    frog.resolve(filelist);
+  }
   return 0;
 }
 
@@ -3,6 +3,7 @@
 #include <TSystem.h>
 
 #include <iostream>
+#include <mutex>
 #include <utility>  // for pair, make_pair
 
 Fun4AllMemoryTracker *Fun4AllMemoryTracker::mInstance = nullptr;
@@ -27,6 +28,7 @@ Fun4AllMemoryTracker::~Fun4AllMemoryTracker()
 
 void Fun4AllMemoryTracker::Snapshot(const std::string &trackername, const std::string &group)
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   std::string name = CreateFullTrackerName(trackername, group);
   auto iter = mMemoryTrackerMap.find(name);
   if (iter != mMemoryTrackerMap.end())
@@ -48,6 +50,7 @@ void Fun4AllMemoryTracker::Snapshot(const std::string &trackername, const std::s
 
 void Fun4AllMemoryTracker::Start(const std::string &trackername, const std::string &group)
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   std::string name = CreateFullTrackerName(trackername, group);
   auto iter = mStartMem.find(name);
   int RSSMemory = GetRSSMemory();
@@ -67,6 +70,7 @@ void Fun4AllMemoryTracker::Start(const std::string &trackername, const std::stri
 
 void Fun4AllMemoryTracker::Stop(const std::string &trackername, const std::string &group)
 {
+  std::lock_guard<std::mutex> lock(mMutex);
   std::string name = CreateFullTrackerName(trackername, group);
   auto iter = mStartMem.find(name);
   int RSSMemory = GetRSSMemory();
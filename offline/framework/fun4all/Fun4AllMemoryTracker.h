@@ -6,6 +6,7 @@
 #include "Fun4AllBase.h"
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,8 @@ class Fun4AllMemoryTracker : public Fun4AllBase
   static Fun4AllMemoryTracker *mInstance;
   std::map<std::string, std::vector<int>> mMemoryTrackerMap;
   std::map<std::string, int> mStartMem;
+  // modules can be run concurrently by the Fun4AllServer
+  std::mutex mMutex;
 };
 
 #endif
@@ -1,5 +1,7 @@
 #include "Fun4AllOutputManager.h"
 
+#include "Fun4AllServer.h"
+
 #include <phool/phool.h>
 
 #include <TSystem.h>
@@ -52,6 +54,13 @@ int Fun4AllOutputManager::WriteGeneric(PHCompositeNode *startNode)
   return iret;
 }
 
+//___________________________________________________________________
+void Fun4AllOutputManager::MarkNodesToWrite(PHCompositeNode *startNode)
+{
+  Fun4AllServer *se = Fun4AllServer::instance();
+  se->MakeNodesPersistent(startNode);
+}
+
 //___________________________________________________________________
 void Fun4AllOutputManager::Print(const std::string &what) const
 {
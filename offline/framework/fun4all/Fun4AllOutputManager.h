@@ -71,6 +71,10 @@ class Fun4AllOutputManager : public Fun4AllBase
     return 0;
   }
 
+  //! make the nodes below startNode which Write() saves persistent (used by the event slots of the
+  //! Fun4AllServer to copy only those nodes), the default is all nodes
+  virtual void MarkNodesToWrite(PHCompositeNode *startNode);
+
   //! write specified node
   virtual int WriteNode(PHCompositeNode * /*thisNode*/)
   {
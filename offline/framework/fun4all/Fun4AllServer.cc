@@ -1,15 +1,19 @@
 #include "Fun4AllServer.h"
 
 #include "Fun4AllDstOutputManager.h"
+#include "Fun4AllEventSlotWriter.h"
 #include "Fun4AllHistoBinDefs.h"
 #include "Fun4AllHistoManager.h"  // for Fun4AllHistoManager
 #include "Fun4AllMemoryTracker.h"
 #include "Fun4AllMonitoring.h"
 #include "Fun4AllOutputManager.h"
 #include "Fun4AllReturnCodes.h"
+#include "Fun4AllSubsysScheduler.h"
 #include "Fun4AllSyncManager.h"
 #include "SubsysReco.h"
 
+#include <frog/FROG.h>
+
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
@@ -35,6 +39,7 @@
 #include <exception>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
+#include <set>
 #include <sstream>
 
 // #define FFAMEMTRACKER
@@ -63,6 +68,9 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
 
 Fun4AllServer::~Fun4AllServer()
 {
+  // finish writing queued events before the output managers go away
+  delete m_EventSlotWriter;
+  m_EventSlotWriter = nullptr;
   Reset();
   delete beginruntimestamp;
   while (Subsystems.begin() != Subsystems.end())
@@ -115,6 +123,7 @@ Fun4AllServer::~Fun4AllServer()
   recoConsts *rc = recoConsts::instance();
   delete rc;
   delete ffamemtracker;
+  delete m_SubsysScheduler;
   __instance = nullptr;
   return;
 }
@@ -264,6 +273,7 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
     std::cout << "Registering Subsystem " << subsystem->Name() << std::endl;
   }
   Subsystems.push_back(newsubsyspair);
+  m_SubsysSchedulerRebuild = true;
   std::string timer_name;
   timer_name = subsystem->Name() + "_" + topnodename;
   PHTimer timer(timer_name);
@@ -275,6 +285,58 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
   return 0;
 }
 
+void Fun4AllServer::ParallelSubsystems(const unsigned int nthreads)
+{
+  delete m_SubsysScheduler;
+  m_SubsysScheduler = nullptr;
+  if (nthreads > 1)
+  {
+    // modules write their histograms into their own TDirectory,
+    // gDirectory has to be thread local
+    ROOT::EnableThreadSafety();
+    m_SubsysScheduler = new Fun4AllSubsysScheduler(nthreads);
+    m_SubsysScheduler->Verbosity(Verbosity());
+    m_SubsysSchedulerRebuild = true;
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllServer: running modules on " << std::max(nthreads, 1U) << " threads" << std::endl;
+  }
+  return;
+}
+
+void Fun4AllServer::EventSlots(const unsigned int nslots)
+{
+  if (m_EventSlotWriter)
+  {
+    m_EventSlotWriter->Drain();
+    delete m_EventSlotWriter;
+    m_EventSlotWriter = nullptr;
+  }
+  if (nslots > 1)
+  {
+    for (auto *manager : OutputManager)
+    {
+      if (!dynamic_cast<Fun4AllDstOutputManager *>(manager))
+      {
+        std::cout << PHWHERE << " OutputManager " << manager->Name()
+                  << " is not a Fun4AllDstOutputManager, event slots cannot be used" << std::endl;
+        return;
+      }
+    }
+    ROOT::EnableThreadSafety();
+    // the writer thread only writes events, the files are closed by PushEventSlot()
+    m_EventSlotWriter = new Fun4AllEventSlotWriter(nslots);
+    m_EventSlotWriter->Verbosity(Verbosity());
+    SyncEventSlotCounts();
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllServer: using " << std::max(nslots, 1U) << " event slots" << std::endl;
+  }
+  return;
+}
+
 int Fun4AllServer::unregisterSubsystem(SubsysReco *subsystem)
 {
   std::pair<SubsysReco *, PHCompositeNode *> subsyspair(subsystem, 0);
@@ -316,6 +378,7 @@ int Fun4AllServer::unregisterSubsystemsNow()
                 << " at index " << index << std::endl;
     }
     Subsystems.erase(Subsystems.begin() + index);
+    m_SubsysSchedulerRebuild = true;
     delete (*removeiter).first;
     // also update the vector with return codes
     RetCodes.erase(RetCodes.begin() + index);
@@ -381,8 +444,22 @@ int Fun4AllServer::registerOutputManager(Fun4AllOutputManager *manager)
   {
     std::cout << "Registering OutputManager " << manager->Name() << std::endl;
   }
+  if (m_EventSlotWriter && !dynamic_cast<Fun4AllDstOutputManager *>(manager))
+  {
+    std::cout << PHWHERE << " OutputManager " << manager->Name()
+              << " is not a Fun4AllDstOutputManager, it cannot be used with event slots" << std::endl;
+    return -1;
+  }
   UpdateEventSelector(manager);
+  if (m_EventSlotWriter)
+  {
+    m_EventSlotWriter->Drain();
+  }
   OutputManager.push_back(manager);
+  if (m_EventSlotWriter)
+  {
+    SyncEventSlotCounts();
+  }
   return 0;
 }
 
@@ -532,142 +609,88 @@ int Fun4AllServer::process_event()
   }
   gROOT->cd(default_Tdirectory.c_str());
   std::string currdir = gDirectory->GetPath();
-  for (auto &Subsystem : Subsystems)
-  {
-    if (Verbosity() >= VERBOSITY_MORE)
-    {
-      std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
-    }
-    std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
-    if (!gROOT->cd(newdirname.c_str()))
-    {
-      std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
-                << Subsystem.second->getName()
-                << " - send e-mail to off-l with your macro" << std::endl;
-      exit(1);
-    }
-    else
-    {
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
-      {
-        std::cout << "process_event: cded to " << newdirname << std::endl;
-      }
-    }
-
-    PHTimer subsystem_timer("SubsystemTimer");
-    subsystem_timer.restart();
-
-    try
-    {
-      std::string timer_name;
-      timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
-      {
-        timer_found = true;
-        titer->second.restart();
-      }
-      else
+  if (m_SubsysScheduler)
+  {
+    if (m_SubsysSchedulerRebuild)
+    {
+      m_SubsysScheduler->Build(Subsystems);
+      m_SubsysSchedulerRebuild = false;
+    }
+    for (const auto &level : m_SubsysScheduler->Levels())
+    {
+      // modules are started in registration order, once one of them did not return
+      // EVENT_OK or DISCARDEVENT the modules of this level not yet started are skipped.
+      // Modules registered after it which were already running still complete, this
+      // is why only modules without side effects besides their declared output nodes
+      // should declare their nodes (see SubsysReco::DeclareInputNode)
+      m_SubsysScheduler->RunLevel(level, [this](unsigned int index)
+                                  {
+                                    RunSubsystem(Subsystems[index], index);
+                                    return (RetCodes[index] == Fun4AllReturnCodes::EVENT_OK ||
+                                            RetCodes[index] == Fun4AllReturnCodes::DISCARDEVENT); });
+      // return codes are checked in the order the modules were registered
+      // after all modules of this level are done. Skipped modules come
+      // after the one which stopped the level so their (old) return codes are not looked at
+      bool abortevent = false;
+      for (auto index : level)
       {
-        std::cout << "could not find timer for " << timer_name << std::endl;
-      }
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Start(timer_name, "SubsysReco");
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-#endif
-      int retcode = Subsystem.first->process_event(Subsystem.second);
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-#endif
-      // we have observed an index overflow in RetCodes. I assume it is some
-      // memory corruption elsewhere which hits the icnt variable. Rather than
-      // the previous [], use at() which does bounds checking and throws an
-      // exception which will allow us to catch this and print out icnt and the size
-      try
-      {
-        RetCodes.at(icnt) = retcode;
-      }
-      catch (const std::exception &e)
-      {
-        std::cout << PHWHERE << " caught exception thrown during RetCodes.at(icnt)" << std::endl;
-        std::cout << "RetCodes.size(): " << RetCodes.size() << ", icnt: " << icnt << std::endl;
-        std::cout << "error: " << e.what() << std::endl;
-        gSystem->Exit(1);
+        if (Verbosity() >= VERBOSITY_MORE)
+        {
+          // the module timers are stopped by RunSubsystem, elapsed() is the time of this event
+          std::string timer_name = Subsystems[index].first->Name() + "_" + Subsystems[index].second->getName();
+          auto titer = timer_map.find(timer_name);
+          if (titer != timer_map.end())
+          {
+            std::cout << "Fun4AllServer::process_event processing " << Subsystems[index].first->Name()
+                      << " processing total time: " << titer->second.elapsed() << " ms" << std::endl;
+          }
+        }
+        int iret = CheckRetCode(Subsystems[index], index, eventbad);
+        if (iret == Fun4AllReturnCodes::ABORTEVENT)
+        {
+          abortevent = true;
+          break;
+        }
+        if (iret)
+        {
+          return iret;
+        }
       }
-      if (timer_found)
+      if (abortevent)
       {
-        titer->second.stop();
+        break;
       }
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Stop(timer_name, "SubsysReco");
-#endif
     }
-    catch (const std::exception &e)
-    {
-      std::cout << PHWHERE << " caught exception thrown during process_event from "
-                << Subsystem.first->Name() << std::endl;
-      std::cout << "error: " << e.what() << std::endl;
-      gSystem->Exit(1);
-    }
-    catch (...)
-    {
-      std::cout << PHWHERE << " caught unknown type exception thrown during process_event from "
-                << Subsystem.first->Name() << std::endl;
-      exit(1);
-    }
-    if (RetCodes[icnt])
+  }
+  else
+  {
+    for (auto &Subsystem : Subsystems)
     {
-      if (RetCodes[icnt] == Fun4AllReturnCodes::DISCARDEVENT)
+      if (Verbosity() >= VERBOSITY_MORE)
       {
-        if (Verbosity() >= VERBOSITY_EVEN_MORE)
-        {
-          std::cout << "Fun4AllServer::Discard Event by " << Subsystem.first->Name() << std::endl;
-        }
+        std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
       }
-      else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTEVENT)
+      PHTimer subsystem_timer("SubsystemTimer");
+      subsystem_timer.restart();
+      RunSubsystem(Subsystem, icnt);
+      int iret = CheckRetCode(Subsystem, icnt, eventbad);
+      if (iret == Fun4AllReturnCodes::ABORTEVENT)
       {
-        retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
-        eventbad = 1;
-        if (Verbosity() >= VERBOSITY_MORE)
-        {
-          std::cout << "Fun4AllServer::Abort Event by " << Subsystem.first->Name() << std::endl;
-        }
         break;
       }
-      else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTRUN)
+      if (iret)
       {
-        retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
-        std::cout << "Fun4AllServer::Abort Run by " << Subsystem.first->Name() << std::endl;
-        return Fun4AllReturnCodes::ABORTRUN;
+        return iret;
       }
-      else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTPROCESSING)
-      {
-        eventbad = 1;
-        retcodesmap[Fun4AllReturnCodes::ABORTPROCESSING]++;
-        std::cout << "Fun4AllServer::Abort Processing by " << Subsystem.first->Name() << std::endl;
-        return Fun4AllReturnCodes::ABORTPROCESSING;
-      }
-      else
+      subsystem_timer.stop();
+      double TimeSubsystem = subsystem_timer.elapsed();
+      if (Verbosity() >= VERBOSITY_MORE)
       {
-        std::cout << "Fun4AllServer::Unknown return code: "
-                  << RetCodes[icnt] << " from process_event method of "
-                  << Subsystem.first->Name() << std::endl;
-        std::cout << "This smells like an uninitialized return code and" << std::endl;
-        std::cout << "it is too dangerous to continue, this Run will be aborted" << std::endl;
-        std::cout << "If you do not know how to fix this please send mail to" << std::endl;
-        std::cout << "phenix-off-l with this message" << std::endl;
-        return Fun4AllReturnCodes::ABORTRUN;
+        std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name()
+                  << " processing total time: " << TimeSubsystem << " ms" << std::endl;
       }
+      icnt++;
     }
-    subsystem_timer.stop();
-    double TimeSubsystem = subsystem_timer.elapsed();
-    if (Verbosity() >= VERBOSITY_MORE)
-    {
-      std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name()
-                << " processing total time: " << TimeSubsystem << " ms" << std::endl;
-    }
-    icnt++;
   }
   if (!eventbad)
   {
@@ -675,7 +698,6 @@ int Fun4AllServer::process_event()
   }
 
   gROOT->cd(currdir.c_str());
-  bool writing = false;
   int segment = std::numeric_limits<int>::min();
   //  mainIter.print();
   if (!OutputManager.empty() && !eventbad)  // there are registered IO managers and
@@ -704,52 +726,17 @@ int Fun4AllServer::process_event()
         std::cout << PHWHERE << " FATAL: Someone changed the number of Output Nodes on the fly, from " << OutNodeCount << " to " << newcount << std::endl;
         exit(1);
       }
-      std::vector<Fun4AllOutputManager *>::iterator iterOutMan;
-
-      for (iterOutMan = OutputManager.begin(); iterOutMan != OutputManager.end(); ++iterOutMan)
+      if (m_EventSlotWriter)
       {
-        if (!(*iterOutMan)->DoNotWriteEvent(&RetCodes))
-        {
-          if (Verbosity() >= VERBOSITY_MORE)
-          {
-            std::cout << "Writing Event for " << (*iterOutMan)->Name() << std::endl;
-          }
-#ifdef FFAMEMTRACKER
-          ffamemtracker->Snapshot("Fun4AllServerOutputManager");
-          ffamemtracker->Start((*iterOutMan)->Name(), "OutputManager");
-#endif
-          (*iterOutMan)->WriteGeneric(dstNode);
-#ifdef FFAMEMTRACKER
-          ffamemtracker->Stop((*iterOutMan)->Name(), "OutputManager");
-          ffamemtracker->Snapshot("Fun4AllServerOutputManager");
-#endif
-          if ((*iterOutMan)->EventsWritten() >= (*iterOutMan)->GetNEvents())
-          {
-            if (Verbosity() > 0)
-            {
-              std::cout << PHWHERE << (*iterOutMan)->Name() << " wrote " << (*iterOutMan)->EventsWritten()
-                        << " events, closing " << (*iterOutMan)->OutFileName() << std::endl;
-            }
-            PHNodeIterator nodeiter(TopNode);
-            PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
-            MakeNodesTransient(runNode);  // make all nodes transient by default
-            (*iterOutMan)->WriteNode(runNode);
-            (*iterOutMan)->RunAfterClosing();
-            segment = (*iterOutMan)->Segment();
-            writing = true;
-          }
-        }
-        else
-        {
-          if (Verbosity() >= VERBOSITY_MORE)
-          {
-            std::cout << "Not Writing Event for " << (*iterOutMan)->Name() << std::endl;
-          }
-        }
+        segment = PushEventSlot(dstNode);
+      }
+      else
+      {
+        segment = WriteOutputManagers(dstNode, &RetCodes);
       }
     }
   }
-  if (!HistoManager.empty() && !eventbad && writing)
+  if (!HistoManager.empty() && segment != std::numeric_limits<int>::min())
   {
     for (const auto &histit : HistoManager)
     {
@@ -789,6 +776,272 @@ int Fun4AllServer::process_event()
   return 0;
 }
 
+void Fun4AllServer::RunSubsystem(std::pair<SubsysReco *, PHCompositeNode *> &Subsystem, const unsigned int icnt)
+{
+  std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
+  if (!gROOT->cd(newdirname.c_str()))
+  {
+    std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
+              << Subsystem.second->getName()
+              << " - send e-mail to off-l with your macro" << std::endl;
+    exit(1);
+  }
+  else
+  {
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "process_event: cded to " << newdirname << std::endl;
+    }
+  }
+
+  try
+  {
+    std::string timer_name;
+    timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
+    std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
+    bool timer_found = false;
+    if (titer != timer_map.end())
+    {
+      timer_found = true;
+      titer->second.restart();
+    }
+    else
+    {
+      std::cout << "could not find timer for " << timer_name << std::endl;
+    }
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Start(timer_name, "SubsysReco");
+    ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+#endif
+    int retcode = Subsystem.first->process_event(Subsystem.second);
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+#endif
+    // we have observed an index overflow in RetCodes. I assume it is some
+    // memory corruption elsewhere which hits the icnt variable. Rather than
+    // the previous [], use at() which does bounds checking and throws an
+    // exception which will allow us to catch this and print out icnt and the size
+    try
+    {
+      RetCodes.at(icnt) = retcode;
+    }
+    catch (const std::exception &e)
+    {
+      std::cout << PHWHERE << " caught exception thrown during RetCodes.at(icnt)" << std::endl;
+      std::cout << "RetCodes.size(): " << RetCodes.size() << ", icnt: " << icnt << std::endl;
+      std::cout << "error: " << e.what() << std::endl;
+      gSystem->Exit(1);
+    }
+    if (timer_found)
+    {
+      titer->second.stop();
+    }
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Stop(timer_name, "SubsysReco");
+#endif
+  }
+  catch (const std::exception &e)
+  {
+    std::cout << PHWHERE << " caught exception thrown during process_event from "
+              << Subsystem.first->Name() << std::endl;
+    std::cout << "error: " << e.what() << std::endl;
+    gSystem->Exit(1);
+  }
+  catch (...)
+  {
+    std::cout << PHWHERE << " caught unknown type exception thrown during process_event from "
+              << Subsystem.first->Name() << std::endl;
+    exit(1);
+  }
+}
+
+int Fun4AllServer::CheckRetCode(const std::pair<SubsysReco *, PHCompositeNode *> &Subsystem, const unsigned int icnt, int &eventbad)
+{
+  if (RetCodes[icnt])
+  {
+    if (RetCodes[icnt] == Fun4AllReturnCodes::DISCARDEVENT)
+    {
+      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      {
+        std::cout << "Fun4AllServer::Discard Event by " << Subsystem.first->Name() << std::endl;
+      }
+    }
+    else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTEVENT)
+    {
+      retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
+      eventbad = 1;
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        std::cout << "Fun4AllServer::Abort Event by " << Subsystem.first->Name() << std::endl;
+      }
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTRUN)
+    {
+      retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
+      std::cout << "Fun4AllServer::Abort Run by " << Subsystem.first->Name() << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    else if (RetCodes[icnt] == Fun4AllReturnCodes::ABORTPROCESSING)
+    {
+      eventbad = 1;
+      retcodesmap[Fun4AllReturnCodes::ABORTPROCESSING]++;
+      std::cout << "Fun4AllServer::Abort Processing by " << Subsystem.first->Name() << std::endl;
+      return Fun4AllReturnCodes::ABORTPROCESSING;
+    }
+    else
+    {
+      std::cout << "Fun4AllServer::Unknown return code: "
+                << RetCodes[icnt] << " from process_event method of "
+                << Subsystem.first->Name() << std::endl;
+      std::cout << "This smells like an uninitialized return code and" << std::endl;
+      std::cout << "it is too dangerous to continue, this Run will be aborted" << std::endl;
+      std::cout << "If you do not know how to fix this please send mail to" << std::endl;
+      std::cout << "phenix-off-l with this message" << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int Fun4AllServer::WriteOutputManagers(PHCompositeNode *dstNode, std::vector<int> *retcodes)
+{
+  int segment = std::numeric_limits<int>::min();
+  std::vector<Fun4AllOutputManager *>::iterator iterOutMan;
+
+  for (iterOutMan = OutputManager.begin(); iterOutMan != OutputManager.end(); ++iterOutMan)
+  {
+    if (!(*iterOutMan)->DoNotWriteEvent(retcodes))
+    {
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        std::cout << "Writing Event for " << (*iterOutMan)->Name() << std::endl;
+      }
+#ifdef FFAMEMTRACKER
+      ffamemtracker->Snapshot("Fun4AllServerOutputManager");
+      ffamemtracker->Start((*iterOutMan)->Name(), "OutputManager");
+#endif
+      (*iterOutMan)->WriteGeneric(dstNode);
+#ifdef FFAMEMTRACKER
+      ffamemtracker->Stop((*iterOutMan)->Name(), "OutputManager");
+      ffamemtracker->Snapshot("Fun4AllServerOutputManager");
+#endif
+      if ((*iterOutMan)->EventsWritten() >= (*iterOutMan)->GetNEvents())
+      {
+        segment = CloseOutputFile(*iterOutMan);
+      }
+    }
+    else
+    {
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        std::cout << "Not Writing Event for " << (*iterOutMan)->Name() << std::endl;
+      }
+    }
+  }
+  return segment;
+}
+
+int Fun4AllServer::CloseOutputFile(Fun4AllOutputManager *manager)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << PHWHERE << manager->Name() << " wrote " << manager->EventsWritten()
+              << " events, closing " << manager->OutFileName() << std::endl;
+  }
+  PHNodeIterator nodeiter(TopNode);
+  PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
+  MakeNodesTransient(runNode);  // make all nodes transient by default
+  manager->WriteNode(runNode);
+  manager->RunAfterClosing();
+  return manager->Segment();
+}
+
+int Fun4AllServer::PushEventSlot(PHCompositeNode *dstNode)
+{
+  // the nodes each output manager writes are selected here, the writer thread
+  // only copies this selection to the nodes of its slot
+  Fun4AllEventSlotWriter::WriteList writelist;
+  std::vector<Fun4AllOutputManager *> writers;
+  for (auto *manager : OutputManager)
+  {
+    if (manager->DoNotWriteEvent(&RetCodes))
+    {
+      continue;
+    }
+    writers.push_back(manager);
+    MakeNodesTransient(dstNode);
+    manager->MarkNodesToWrite(dstNode);
+    auto &writer = writelist.emplace_back();
+    // only Fun4AllDstOutputManagers are registered with event slots
+    writer.first = static_cast<Fun4AllDstOutputManager *>(manager);  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+    CollectPersistentNodes(dstNode, writer.second);
+  }
+  MakeNodesTransient(dstNode);
+  if (writelist.empty())
+  {
+    return std::numeric_limits<int>::min();
+  }
+  m_EventSlotWriter->Push(dstNode, writelist);
+
+  // EventsWritten() of the managers is only read when the writer is idle, the counts
+  // including the queued events are an upper limit (the managers reset it for a new file)
+  bool closing = false;
+  for (auto *manager : writers)
+  {
+    if (++m_EventSlotCounts[manager] >= manager->GetNEvents())
+    {
+      closing = true;
+    }
+  }
+  int segment = std::numeric_limits<int>::min();
+  if (!closing)
+  {
+    return segment;
+  }
+  // the RUN node is written and the files are closed here and not by the writer thread,
+  // the RUN node is used by the modules on this thread
+  m_EventSlotWriter->Drain();
+  for (auto *manager : writers)
+  {
+    if (manager->EventsWritten() >= manager->GetNEvents())
+    {
+      segment = CloseOutputFile(manager);
+    }
+  }
+  SyncEventSlotCounts();
+  return segment;
+}
+
+void Fun4AllServer::SyncEventSlotCounts()
+{
+  m_EventSlotCounts.clear();
+  for (auto *manager : OutputManager)
+  {
+    m_EventSlotCounts[manager] = manager->EventsWritten();
+  }
+}
+
+int Fun4AllServer::CollectPersistentNodes(PHCompositeNode *startNode, std::set<PHNode *> &nodes)  // NOLINT(misc-no-recursion)
+{
+  PHNodeIterator nodeiter(startNode);
+  PHPointerListIterator<PHNode> iterat(nodeiter.ls());
+  PHNode *thisNode;
+  while ((thisNode = iterat()))
+  {
+    if ((thisNode->getType() == "PHCompositeNode"))
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      CollectPersistentNodes(static_cast<PHCompositeNode *>(thisNode), nodes);
+    }
+    else if (thisNode->isPersistent())
+    {
+      nodes.insert(thisNode);
+    }
+  }
+  return 0;
+}
+
 int Fun4AllServer::ResetNodeTree()
 {
   std::vector<std::string> ResetNodeList;
@@ -892,6 +1145,8 @@ int Fun4AllServer::BeginRun(const int runno)
     registerSubsystem((NewSubsystems.front()).first, (NewSubsystems.front()).second);
     BeginRunSubsystem(std::make_pair(NewSubsystems.front().first, topNode(NewSubsystems.front().second)));
   }
+  // modules declare the nodes they use in InitRun, once their configuration is known
+  m_SubsysSchedulerRebuild = true;
   gROOT->cd(currdir.c_str());
   // print out all node trees
   Print("NODETREE");
@@ -1037,6 +1292,10 @@ int Fun4AllServer::MakeNodesPersistent(PHCompositeNode *startNode) // NOLINT(mis
 
 int Fun4AllServer::EndRun(const int runno)
 {
+  if (m_EventSlotWriter)
+  {
+    m_EventSlotWriter->Drain();
+  }
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>>::iterator iter;
   gROOT->cd(default_Tdirectory.c_str());
   std::string currdir = gDirectory->GetPath();
@@ -1155,6 +1414,8 @@ int Fun4AllServer::End()
   // done inside outfileclose())
   outfileclose();
 
+  FROG::PrintStatistics();
+
   if (ScreamEveryEvent)
   {
     std::cout << "*******************************************************************************" << std::endl;
@@ -1277,6 +1538,10 @@ void Fun4AllServer::identify(std::ostream &out) const
 
 int Fun4AllServer::outfileclose()
 {
+  if (m_EventSlotWriter)
+  {
+    m_EventSlotWriter->Drain();
+  }
   while (!OutputManager.empty())
   {
     if (Verbosity() >= VERBOSITY_MORE)
@@ -1288,6 +1553,7 @@ int Fun4AllServer::outfileclose()
     delete *(OutputManager.begin());
     OutputManager.erase(OutputManager.begin());
   }
+  m_EventSlotCounts.clear();
   return 0;
 }
 
@@ -12,15 +12,19 @@
 #include <deque>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
 
+class Fun4AllEventSlotWriter;
 class Fun4AllInputManager;
 class Fun4AllMemoryTracker;
+class Fun4AllSubsysScheduler;
 class Fun4AllSyncManager;
 class Fun4AllOutputManager;
 class PHCompositeNode;
+class PHNode;
 class PHTimeStamp;
 class SubsysReco;
 class TDirectory;
@@ -46,6 +50,23 @@ class Fun4AllServer : public Fun4AllBase
   int registerSubsystem(SubsysReco *subsystem, const std::string &topnodename = "TOP");
   void addNewSubsystem(SubsysReco *subsystem, const std::string &topnodename = "TOP") { NewSubsystems.push_back(std::make_pair(subsystem, topnodename)); }
   int unregisterSubsystem(SubsysReco *subsystem);
+  /*!
+    \brief run independent modules concurrently on nthreads threads (1 = serial, the default).
+    Modules are only run in parallel if they declare the nodes they read and write
+    (see SubsysReco::DeclareInputNode/DeclareOutputNode)
+  */
+  void ParallelSubsystems(const unsigned int nthreads);
+  /*!
+    \brief number of events in flight (1 = no pipelining, the default).
+    The nodes the output managers write are copied and written on a background
+    thread while the next event is read and reconstructed, up to nslots-1 events
+    are queued. Output files are closed (and the RUN node written) on the main
+    thread once the queue is drained. Only for Fun4AllDstOutputManagers, other
+    output managers are rejected.
+    The copy is a streamer round trip of the written objects on the main thread,
+    only the compression and the file io overlap with the next event.
+  */
+  void EventSlots(const unsigned int nslots);
   SubsysReco *getSubsysReco(const std::string &name);
   int registerOutputManager(Fun4AllOutputManager *manager);
   Fun4AllOutputManager *getOutputManager(const std::string &name);
@@ -125,6 +146,13 @@ class Fun4AllServer : public Fun4AllBase
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
   int setRun(const int runno);
+  void RunSubsystem(std::pair<SubsysReco *, PHCompositeNode *> &Subsystem, const unsigned int icnt);
+  int CheckRetCode(const std::pair<SubsysReco *, PHCompositeNode *> &Subsystem, const unsigned int icnt, int &eventbad);
+  int WriteOutputManagers(PHCompositeNode *dstNode, std::vector<int> *retcodes);
+  int CloseOutputFile(Fun4AllOutputManager *manager);
+  int PushEventSlot(PHCompositeNode *dstNode);
+  void SyncEventSlotCounts();
+  int CollectPersistentNodes(PHCompositeNode *startNode, std::set<PHNode *> &nodes);
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars{nullptr};
   Fun4AllMemoryTracker *ffamemtracker{nullptr};
@@ -132,6 +160,8 @@ class Fun4AllServer : public Fun4AllBase
   PHTimeStamp *beginruntimestamp{nullptr};
   PHCompositeNode *TopNode{nullptr};
   Fun4AllSyncManager *defaultSyncManager{nullptr};
+  Fun4AllSubsysScheduler *m_SubsysScheduler{nullptr};
+  Fun4AllEventSlotWriter *m_EventSlotWriter{nullptr};
 
   int OutNodeCount{0};
   int bortime_override{0};
@@ -141,8 +171,11 @@ class Fun4AllServer : public Fun4AllBase
   int eventnumber{0};
   int eventcounter{0};
   int keep_db_connected{0};
+  bool m_SubsysSchedulerRebuild{true};
 
   std::vector<std::string> ComplaintList;
+  //! events written by the output managers including the ones queued in the event slots
+  std::map<Fun4AllOutputManager *, unsigned int> m_EventSlotCounts;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>> Subsystems;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>> DeleteSubsystems;
   std::deque<std::pair<SubsysReco *, std::string>> NewSubsystems;
@@ -0,0 +1,203 @@
+#include "Fun4AllSubsysScheduler.h"
+
+#include "SubsysReco.h"
+
+#include <phool/PHCompositeNode.h>
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+
+namespace
+{
+  bool overlap(const std::set<std::string> &set1, const std::set<std::string> &set2)
+  {
+    auto iter1 = set1.begin();
+    auto iter2 = set2.begin();
+    while (iter1 != set1.end() && iter2 != set2.end())
+    {
+      if (*iter1 < *iter2)
+      {
+        ++iter1;
+      }
+      else if (*iter2 < *iter1)
+      {
+        ++iter2;
+      }
+      else
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::set<std::string> qualify(const std::set<std::string> &nodes, const std::string &topnode)
+  {
+    std::set<std::string> qualified;
+    for (const auto &node : nodes)
+    {
+      qualified.insert(topnode + "/" + node);
+    }
+    return qualified;
+  }
+}  // namespace
+
+Fun4AllSubsysScheduler::Fun4AllSubsysScheduler(const unsigned int nthreads)
+  : Fun4AllBase("Fun4AllSubsysScheduler")
+{
+  // the thread calling RunLevel() does work as well
+  for (unsigned int i = 1; i < nthreads; i++)
+  {
+    m_Workers.emplace_back(&Fun4AllSubsysScheduler::WorkerLoop, this);
+  }
+}
+
+Fun4AllSubsysScheduler::~Fun4AllSubsysScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_StartCondition.notify_all();
+  for (auto &worker : m_Workers)
+  {
+    worker.join();
+  }
+}
+
+void Fun4AllSubsysScheduler::Build(const std::vector<std::pair<SubsysReco *, PHCompositeNode *>> &subsystems)
+{
+  m_Names.clear();
+  m_Levels.clear();
+  std::vector<std::set<std::string>> inputs;
+  std::vector<std::set<std::string>> outputs;
+  std::vector<unsigned int> modlevel(subsystems.size(), 0);
+  for (unsigned int i = 0; i < subsystems.size(); i++)
+  {
+    SubsysReco *subsys = subsystems[i].first;
+    std::string topnode = subsystems[i].second->getName();
+    m_Names.push_back(subsys->Name());
+    inputs.push_back(qualify(subsys->InputNodes(), topnode));
+    outputs.push_back(qualify(subsys->OutputNodes(), topnode));
+    bool declared = subsys->NodesDeclared();
+    for (unsigned int j = 0; j < i; j++)
+    {
+      // module i has to run after module j if j writes what i reads or writes
+      // or if i writes what j reads. Undeclared modules depend on everything
+      if (!declared || !subsystems[j].first->NodesDeclared() ||
+          overlap(outputs[j], inputs[i]) || overlap(outputs[j], outputs[i]) ||
+          overlap(inputs[j], outputs[i]))
+      {
+        modlevel[i] = std::max(modlevel[i], modlevel[j] + 1);
+      }
+    }
+    if (modlevel[i] >= m_Levels.size())
+    {
+      m_Levels.resize(modlevel[i] + 1);
+    }
+    m_Levels[modlevel[i]].push_back(i);
+  }
+  if (Verbosity() > 0)
+  {
+    Print();
+  }
+}
+
+void Fun4AllSubsysScheduler::RunLevel(const std::vector<unsigned int> &level, const std::function<bool(unsigned int)> &func)
+{
+  if (level.size() == 1 || m_Workers.empty())
+  {
+    for (auto index : level)
+    {
+      if (!func(index))
+      {
+        break;
+      }
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_CurrentLevel = &level;
+    m_CurrentFunc = &func;
+    m_NextTask = 0;
+    m_Cancelled = false;
+    m_TasksDone = 0;
+    m_Generation++;
+  }
+  m_StartCondition.notify_all();
+  DrainTasks();
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_DoneCondition.wait(lock, [this, &level]
+                       { return m_TasksDone == level.size() && m_ActiveWorkers == 0; });
+  // late workers see a nullptr and go back to sleep
+  m_CurrentLevel = nullptr;
+  m_CurrentFunc = nullptr;
+}
+
+void Fun4AllSubsysScheduler::WorkerLoop()
+{
+  unsigned int seen = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_StartCondition.wait(lock, [this, seen]
+                            { return m_Stop || m_Generation != seen; });
+      if (m_Stop)
+      {
+        return;
+      }
+      seen = m_Generation;
+      if (!m_CurrentLevel)
+      {
+        continue;
+      }
+      m_ActiveWorkers++;
+    }
+    DrainTasks();
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_ActiveWorkers--;
+    }
+    m_DoneCondition.notify_all();
+  }
+}
+
+void Fun4AllSubsysScheduler::DrainTasks()
+{
+  const std::vector<unsigned int> &level = *m_CurrentLevel;
+  const std::function<bool(unsigned int)> &func = *m_CurrentFunc;
+  while (true)
+  {
+    unsigned int itask = m_NextTask++;
+    if (itask >= level.size())
+    {
+      break;
+    }
+    // tasks are taken in order, after a cancel the remaining ones are only counted
+    if (!m_Cancelled && !func(level[itask]))
+    {
+      m_Cancelled = true;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_TasksDone++;
+  }
+  m_DoneCondition.notify_all();
+}
+
+void Fun4AllSubsysScheduler::Print(const std::string & /*what*/) const
+{
+  std::cout << Name() << " running " << m_Levels.size() << " levels on "
+            << NThreads() << " threads" << std::endl;
+  for (unsigned int ilevel = 0; ilevel < m_Levels.size(); ilevel++)
+  {
+    std::cout << "level " << ilevel << ":";
+    for (auto index : m_Levels[ilevel])
+    {
+      std::cout << " " << m_Names.at(index);
+    }
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,75 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLSUBSYSSCHEDULER_H
+#define FUN4ALL_FUN4ALLSUBSYSSCHEDULER_H
+
+#include "Fun4AllBase.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>  // for pair
+#include <vector>
+
+class PHCompositeNode;
+class SubsysReco;
+
+/** Runs the process_event of independent SubsysReco modules concurrently.
+ *
+ *  The modules declare the nodes they read and write (SubsysReco::DeclareInputNode,
+ *  SubsysReco::DeclareOutputNode). From this the scheduler builds a DAG of the
+ *  registered modules and groups them into levels. All modules within one level
+ *  are independent and are run on a persistent pool of worker threads, the levels
+ *  themselves are run one after the other. A module which does not declare its nodes
+ *  is put into a level of its own, so it keeps its place in the serial order.
+ *
+ *  The modules of a level are started in the order they were registered. Once a
+ *  module asks to stop (e.g. it returned ABORTEVENT) no further modules of the level
+ *  are started, but modules registered after it which are already running finish.
+ */
+
+class Fun4AllSubsysScheduler : public Fun4AllBase
+{
+ public:
+  explicit Fun4AllSubsysScheduler(const unsigned int nthreads);
+  ~Fun4AllSubsysScheduler() override;
+
+  void Print(const std::string &what = "ALL") const override;
+
+  //! (re)build the execution levels, the vector indices are kept as module ids
+  void Build(const std::vector<std::pair<SubsysReco *, PHCompositeNode *>> &subsystems);
+
+  //! indices (into the subsystem vector given to Build()) of the modules in each level
+  const std::vector<std::vector<unsigned int>> &Levels() const { return m_Levels; }
+
+  //! call func(index) for the modules of a level and wait until all are done.
+  //! If func returns false the modules of this level not yet started are skipped
+  void RunLevel(const std::vector<unsigned int> &level, const std::function<bool(unsigned int)> &func);
+
+  unsigned int NThreads() const { return m_Workers.size() + 1; }
+
+ private:
+  void WorkerLoop();
+  void DrainTasks();
+
+  std::vector<std::string> m_Names;
+  std::vector<std::vector<unsigned int>> m_Levels;
+
+  std::vector<std::thread> m_Workers;
+  std::mutex m_Mutex;
+  std::condition_variable m_StartCondition;
+  std::condition_variable m_DoneCondition;
+  const std::vector<unsigned int> *m_CurrentLevel{nullptr};
+  const std::function<bool(unsigned int)> *m_CurrentFunc{nullptr};
+  std::atomic<unsigned int> m_NextTask{0};
+  std::atomic<bool> m_Cancelled{false};
+  unsigned int m_TasksDone{0};
+  unsigned int m_ActiveWorkers{0};
+  unsigned int m_Generation{0};
+  bool m_Stop{false};
+};
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "Fun4AllBase.h"
 
+#include <set>
 #include <string>
 
 class PHCompositeNode;
@@ -60,6 +61,24 @@ class SubsysReco : public Fun4AllBase
 
   void Print(const std::string & /*what*/ = "ALL") const override {}
 
+  /** Declare a node (by name, under this module's topNode) which is read
+      in process_event(). Only used by the parallel scheduler of the
+      Fun4AllServer, modules which do not declare any nodes are always
+      run serially in the order they were registered.
+      Declared modules may run concurrently with modules registered before
+      them, even if one of those aborts the event. So only modules whose
+      process_event() has no effects besides their declared output nodes
+      (no histograms, output files or event counters) should declare nodes.
+   */
+  void DeclareInputNode(const std::string &name) { m_InputNodes.insert(name); }
+
+  /// Declare a node which is created or modified in process_event()
+  void DeclareOutputNode(const std::string &name) { m_OutputNodes.insert(name); }
+
+  const std::set<std::string> &InputNodes() const { return m_InputNodes; }
+  const std::set<std::string> &OutputNodes() const { return m_OutputNodes; }
+  bool NodesDeclared() const { return (!m_InputNodes.empty() || !m_OutputNodes.empty()); }
+
  protected:
   /** ctor.
       @param name is the reference used inside the Fun4AllServer
@@ -68,6 +87,10 @@ class SubsysReco : public Fun4AllBase
     : Fun4AllBase(name)
   {
   }
+
+ private:
+  std::set<std::string> m_InputNodes;
+  std::set<std::string> m_OutputNodes;
 };
 
 #endif
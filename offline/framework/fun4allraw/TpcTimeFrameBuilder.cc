@@ -40,10 +40,12 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
   }
 
   m_feeData.resize(MAX_FEECOUNT);
+  m_feeDecodeStat.resize(MAX_FEECOUNT);
 
   // cppcheck-suppress noCopyConstructor
   // cppcheck-suppress noOperatorEq
   m_packetTimer = new PHTimer("TpcTimeFrameBuilder_Packet" + to_string(packet_id));
+  m_feeTimer = new PHTimer("TpcTimeFrameBuilder_Packet" + to_string(packet_id) + "_FEE");
 
   Fun4AllHistoManager* hm = QAHistManagerDef::getHistoManager();
   assert(hm);
@@ -166,6 +168,12 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
                                       " Time cost to run ProcessPacket();Call counts;Time elapsed per call [ms];Count",
                                   100, 0, 30e6, 100, 0, 10);
   hm->registerHisto(h_ProcessPacket_Time);
+
+  h_FEEDecode_Time = new TH1D(TString(m_HistoPrefix.c_str()) + "_FEEDecode_Time",  //
+                              TString(m_HistoPrefix.c_str()) +
+                                  " Time spent decoding FEE data;FEE ID;Time [ms]",
+                              MAX_FEECOUNT, -.5, MAX_FEECOUNT - .5);
+  hm->registerHisto(h_FEEDecode_Time);
 }
 
 TpcTimeFrameBuilder::~TpcTimeFrameBuilder()
@@ -179,17 +187,78 @@ TpcTimeFrameBuilder::~TpcTimeFrameBuilder()
     }
   }
 
+  for (auto hit : m_rawHitPool)
+  {
+    delete hit;
+  }
+
+  if (m_verbosity >= 1)
+  {
+    printFeeDecodeStat();
+  }
+
   if (m_packetTimer)
   {
     delete m_packetTimer;
   }
 
+  delete m_feeTimer;
+
   if (m_digitalCurrentDebugTTree)
   {
     delete m_digitalCurrentDebugTTree;
   }
 }
 
+void TpcTimeFrameBuilder::printFeeDecodeStat(std::ostream& os) const
+{
+  os << "TpcTimeFrameBuilder - packet " << m_packet_id << " FEE decoding statistics:" << std::endl;
+  for (unsigned int fee = 0; fee < m_feeDecodeStat.size(); ++fee)
+  {
+    const auto& stat = m_feeDecodeStat[fee];
+    if (stat.words == 0)
+    {
+      continue;
+    }
+    os << "- FEE " << fee
+       << " words: " << stat.words
+       << " packets: " << stat.packets
+       << " hits: " << stat.hits
+       << " time: " << stat.time << " ms";
+    if (stat.time > 0)
+    {
+      os << " (" << stat.words / stat.time / 1e3 << " Mwords/s)";
+    }
+    os << std::endl;
+  }
+}
+
+TpcRawHitv3* TpcTimeFrameBuilder::getRawHit()
+{
+  if (m_rawHitPool.empty())
+  {
+    return new TpcRawHitv3();
+  }
+
+  TpcRawHitv3* hit = m_rawHitPool.back();
+  m_rawHitPool.pop_back();
+  return hit;
+}
+
+void TpcTimeFrameBuilder::recycleRawHit(TpcRawHit* hit)
+{
+  // only hits of the type created here can be handed out again
+  if (m_rawHitPool.size() < kMaxRawHitPoolSize && hit->IsA() == TpcRawHitv3::Class())
+  {
+    hit->Clear();
+    m_rawHitPool.push_back(static_cast<TpcRawHitv3*>(hit));  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+  }
+  else
+  {
+    delete hit;
+  }
+}
+
 void TpcTimeFrameBuilder::setVerbosity(const int i)
 {
   m_verbosity = i;
@@ -273,7 +342,7 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
       h_GTMClockDiff_Dropped->Fill(int64_t(it->first) - int64_t(bclk_rollover_corrected));
       for (const auto& hit : it->second)
       {
-        delete hit;
+        recycleRawHit(hit);
       }
       it = m_timeFrameMap.erase(it);
     }
@@ -372,7 +441,7 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
     {
       while (!it->second.empty())
       {
-        delete it->second.back();
+        recycleRawHit(it->second.back());
         it->second.pop_back();
       }
       m_timeFrameMap.erase(it);
@@ -391,7 +460,7 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
       while (!it->second.empty())
       {
         m_hFEEDataStream->Fill(it->second.back()->get_fee(), "HitUnusedBeforeCleanup", 1);
-        delete it->second.back();
+        recycleRawHit(it->second.back());
         it->second.pop_back();
         ++count;
       }
@@ -531,7 +600,8 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
   }
 
   size_t dma_words_buffer = static_cast<size_t>(data_length) * 2 / DAM_DMA_WORD_LENGTH + 1;
-  vector<dma_word> buffer(dma_words_buffer);
+  vector<dma_word>& buffer = m_packetBuffer;
+  buffer.resize(dma_words_buffer);
 
   int l2 = 0;
   packet->fillIntArray(reinterpret_cast<int*>(buffer.data()), data_length + DAM_DMA_WORD_LENGTH / 2, &l2, "DATA");
@@ -605,10 +675,16 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 
       if (fee_id < MAX_FEECOUNT)
       {
-        for (const uint16_t& i : dma_word_data.data)
+        if (!m_feeData[fee_id].push(dma_word_data.data, DAM_DMA_WORD_LENGTH - 1))
         {
-          m_feeData[fee_id].push_back(i);
+          // cannot happen with valid data, as complete packets are consumed right away
+          cout << __PRETTY_FUNCTION__ << "\t- : Error : FEE " << fee_id << " buffer overflow, dropping "
+               << m_feeData[fee_id].size() << " words" << endl;
+          m_hFEEDataStream->Fill(fee_id, "WordSkipped", m_feeData[fee_id].size());
+          m_feeData[fee_id].clear();
+          m_feeData[fee_id].push(dma_word_data.data, DAM_DMA_WORD_LENGTH - 1);
         }
+        m_feeDecodeStat[fee_id].words += DAM_DMA_WORD_LENGTH - 1;
         m_hNorm->Fill("DMA_WORD_FEE", 1);
 
         // immediate fee buffer processing to reduce memory consuption
@@ -649,7 +725,7 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 
       while (!timeframe.second.empty())
       {
-        delete timeframe.second.back();
+        recycleRawHit(timeframe.second.back());
         timeframe.second.pop_back();
       }
     }
@@ -659,6 +735,12 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
   assert(h_ProcessPacket_Time);
   h_ProcessPacket_Time->Fill(call_count, m_packetTimer->elapsed());
 
+  assert(h_FEEDecode_Time);
+  for (unsigned int fee = 0; fee < m_feeDecodeStat.size(); ++fee)
+  {
+    h_FEEDecode_Time->SetBinContent(fee + 1, m_feeDecodeStat[fee].time);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -672,7 +754,9 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   }
 
   assert(fee < m_feeData.size());
-  std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  FeeRingBuffer& data_buffer = m_feeData[fee];
+  FeeDecodeStat& stat = m_feeDecodeStat[fee];
+  m_feeTimer->restart();
 
   while (HEADER_LENGTH <= data_buffer.size())
   {
@@ -702,7 +786,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
           cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE magic key at position 1 0x" << hex << data_buffer[1] << dec << endl;
         }
         m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
-        data_buffer.pop_front();
+        data_buffer.pop(1);
         continue;
       }
       assert(data_buffer[1] == FEE_PACKET_MAGIC_KEY_1);
@@ -714,7 +798,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
           cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE magic key at position 2 0x" << hex << data_buffer[2] << dec << endl;
         }
         m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
-        data_buffer.pop_front();
+        data_buffer.pop(1);
         continue;
       }
       assert(data_buffer[2] == FEE_PACKET_MAGIC_KEY_2);
@@ -722,7 +806,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
     }
 
     // valid packet
-    const uint16_t & pkt_length = data_buffer[0];  // this is indeed the number of 10-bit words + 5 in this packet
+    const uint16_t pkt_length = data_buffer[0];  // this is indeed the number of 10-bit words + 5 in this packet
     if (pkt_length > MAX_PACKET_LENGTH)
     {
       if (m_verbosity > 1)
@@ -730,7 +814,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE pkt_length " << pkt_length << endl;
       }
       m_hFEEDataStream->Fill(fee, "InvalidLength", 1);
-      data_buffer.pop_front();
+      data_buffer.pop(1);
       continue;
     }
 
@@ -755,15 +839,19 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
     {
       process_fee_data_waveform(fee, data_buffer);
     }
-    data_buffer.erase(data_buffer.begin(), data_buffer.begin() + pkt_length + 1);
     m_hFEEDataStream->Fill(fee, "WordValid", pkt_length + 1);
+    ++stat.packets;
+    data_buffer.pop(pkt_length + 1);
 
   }  //     while (HEADER_LENGTH < data_buffer.size())
 
+  m_feeTimer->stop();
+  stat.time += m_feeTimer->elapsed();
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int & fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int & fee, const FeeRingBuffer& data_buffer)
 {
   const uint16_t & pkt_length = data_buffer[0];
 
@@ -924,16 +1012,12 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int & fee, st
 
     // Format is (N sample) (start time), (1st sample)... (Nth sample)
     size_t pos = HEADER_LENGTH;
-    std::deque<uint16_t>::const_iterator data_buffer_iterator = data_buffer.cbegin();
-    std::advance(data_buffer_iterator, pos);
     while (pos + 2 < pkt_length)
     {
-      const uint16_t& nsamp = *data_buffer_iterator;
+      const uint16_t nsamp = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
-      const uint16_t& start_t = *data_buffer_iterator;
+      const uint16_t start_t = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
       if (m_verbosity > 3)
       {
         cout << __PRETTY_FUNCTION__ << ": nsamp: " << nsamp
@@ -964,13 +1048,12 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int & fee, st
       std::vector<uint16_t> adc(nsamp);
       for (int j = 0; j < nsamp; j++)
       {
-        const uint16_t& adc_value = *data_buffer_iterator;
+        const uint16_t adc_value = data_buffer[pos];
 
         adc[j] = adc_value;
         m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc_value);
 
         ++pos;
-        ++data_buffer_iterator;  //data_buffer[pos++];
       }
       payload.waveforms.emplace_back(start_t, std::move(adc));
 
@@ -992,8 +1075,9 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int & fee, st
     // valid packet in the buffer, create a new hit
     if (payload.type != m_bcoMatchingInformation.HEARTBEAT_T)
     {
-      TpcRawHitv3* hit = new TpcRawHitv3();
+      TpcRawHitv3* hit = getRawHit();
       m_timeFrameMap[payload.gtm_bco].push_back(hit);
+      ++m_feeDecodeStat[fee].hits;
 
       hit->set_bco(payload.bx_timestamp);
       hit->set_packetid(m_packet_id);
@@ -1015,7 +1099,7 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int & fee, st
   return  ;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int & fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int & fee, const FeeRingBuffer& data_buffer)
 {
   if (m_verbosity > 2)
   {
@@ -1265,17 +1349,15 @@ uint16_t TpcTimeFrameBuilder::reverseBits(const uint16_t x) const
 
 std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint32_t fee, const uint16_t l) const
 {
-  const std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  const FeeRingBuffer& data_buffer = m_feeData[fee];
   assert(l < data_buffer.size());
 
-  std::deque<uint16_t>::const_iterator it = data_buffer.begin();
-
   uint16_t crc = 0xffffU;
   uint16_t data_parity = 0U;
 
-  for (int i = 0; i < l; ++i, ++it)
+  for (int i = 0; i < l; ++i)
   {
-    const uint16_t& x = *it;
+    const uint16_t x = data_buffer[i];
 
     crc ^= reverseBits(x);
     for (uint16_t k = 0; k < 16U; k++)
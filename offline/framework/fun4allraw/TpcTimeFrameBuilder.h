@@ -3,7 +3,6 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <iostream>
 #include <limits>
@@ -18,6 +17,7 @@
 
 class Packet;
 class TpcRawHit;
+class TpcRawHitv3;
 class PHTimer;
 class TH1;
 class TH2;
@@ -44,6 +44,28 @@ class TpcTimeFrameBuilder
   // enable saving of digital current debug TTree with file name `name`
   void SaveDigitalCurrentDebugTTree(const std::string &name);
 
+  //! per FEE decoding statistics
+  struct FeeDecodeStat
+  {
+    //! 16 bit words received
+    uint64_t words = 0;
+    //! FEE packets decoded
+    uint64_t packets = 0;
+    //! TpcRawHit created
+    uint64_t hits = 0;
+    //! time spent decoding [ms]
+    double time = 0;
+  };
+
+  //! decoding statistics, indexed by FEE
+  const std::vector<FeeDecodeStat> &getFeeDecodeStat() const
+  {
+    return m_feeDecodeStat;
+  }
+
+  //! print per FEE decoding statistics
+  void printFeeDecodeStat(std::ostream &os = std::cout) const;
+
  protected:
   // Length for the 256-bit wide Round Robin Multiplexer for the data stream
   static const size_t DAM_DMA_WORD_LENGTH = 16;
@@ -79,10 +101,81 @@ class TpcTimeFrameBuilder
     uint16_t data[DAM_DMA_WORD_LENGTH - 1] = {0};
   };
 
+  //! fixed capacity ring buffer of the 16 bit words received from one FEE
+  /*!
+   * FEE packets are decoded in place from the buffer and the words are released
+   * once the packet is processed, without moving the remaining data
+   */
+  class FeeRingBuffer
+  {
+   public:
+    //! capacity, a power of 2 well above the longest FEE packet
+    static const size_t CAPACITY = 1U << 14U;
+
+    FeeRingBuffer()
+      : m_data(CAPACITY, 0)
+    {
+    }
+
+    //! number of words in the buffer
+    size_t size() const
+    {
+      return m_tail - m_head;
+    }
+
+    //! word at position i from the front
+    const uint16_t &operator[](const size_t i) const
+    {
+      return m_data[(m_head + i) & MASK];
+    }
+
+    //! append n words. Returns false, without adding anything, if they do not fit
+    bool push(const uint16_t *data, const size_t n)
+    {
+      if (size() + n > CAPACITY)
+      {
+        return false;
+      }
+      for (size_t i = 0; i < n; ++i)
+      {
+        m_data[(m_tail + i) & MASK] = data[i];
+      }
+      m_tail += n;
+      return true;
+    }
+
+    //! release n words from the front
+    void pop(const size_t n)
+    {
+      m_head += std::min(n, size());
+    }
+
+    //! release all words
+    void clear()
+    {
+      m_head = m_tail;
+    }
+
+   private:
+    static const size_t MASK = CAPACITY - 1;
+
+    std::vector<uint16_t> m_data;
+
+    //! positions of the first and past the last word, never wrapped
+    size_t m_head = 0;
+    size_t m_tail = 0;
+  };
+
   int decode_gtm_data(const dma_word &gtm_word);
   int process_fee_data(unsigned int fee_id);
-  void process_fee_data_waveform(const unsigned int & fee_id, std::deque<uint16_t>& data_buffer);
-  void process_fee_data_digital_current(const unsigned int & fee_id, std::deque<uint16_t>& data_buffer);
+  void process_fee_data_waveform(const unsigned int & fee_id, const FeeRingBuffer& data_buffer);
+  void process_fee_data_digital_current(const unsigned int & fee_id, const FeeRingBuffer& data_buffer);
+
+  //! get a TpcRawHit from the pool, or a new one if the pool is empty
+  TpcRawHitv3 *getRawHit();
+
+  //! clear a TpcRawHit and return it to the pool
+  void recycleRawHit(TpcRawHit *hit);
 
   struct gtm_payload
   {
@@ -369,7 +462,14 @@ class TpcTimeFrameBuilder
   };  //   class BcoMatchingInformation
 
  private:
-  std::vector<std::deque<uint16_t>> m_feeData;
+  std::vector<FeeRingBuffer> m_feeData;
+
+  //! DMA words of the current packet, reused from packet to packet
+  std::vector<dma_word> m_packetBuffer;
+
+  //! per FEE decoding statistics
+  std::vector<FeeDecodeStat> m_feeDecodeStat;
+  PHTimer *m_feeTimer = nullptr;
 
   int m_verbosity = 0;
   int m_packet_id = 0;
@@ -384,6 +484,10 @@ class TpcTimeFrameBuilder
   static const size_t kMaxRawHitLimit = 10000;  // 10k hits per event > 256ch/fee * 26fee
   std::queue<uint64_t> m_UsedTimeFrameSet;
 
+  //! cleared TpcRawHit available for reuse by the next time frames
+  std::vector<TpcRawHitv3 *> m_rawHitPool;
+  static const size_t kMaxRawHitPoolSize = 4 * kMaxRawHitLimit;
+
   //! fast skip mode when searching for particular GL1 BCO over long segment of files
   bool m_fastBCOSkip = false;
 
@@ -410,6 +514,7 @@ class TpcTimeFrameBuilder
   TH1 *h_TimeFrame_Matched_Size = nullptr;
 
   TH2 *h_ProcessPacket_Time = nullptr;
+  TH1 *h_FEEDecode_Time = nullptr;
 };
 
 #endif
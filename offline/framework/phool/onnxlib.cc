@@ -1,130 +1,132 @@
 #include "onnxlib.h"
-#include <iostream>
-
-Ort::Session *onnxSession(std::string &modelfile)
-{
-  Ort::Env env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "fit");
-  Ort::SessionOptions sessionOptions;
-  sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
 
-  return new Ort::Session(env, modelfile.c_str(), sessionOptions);
-}
+#include <algorithm>
+#include <iostream>
 
-std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nsamp, int Nreturn)
+namespace
 {
-  Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-
-  Ort::AllocatorWithDefaultOptions allocator;
-
-  std::vector<Ort::Value> inputTensors;
-  std::vector<Ort::Value> outputTensors;
-
-  std::vector<int64_t> inputDimsN = {N, Nsamp};
-  std::vector<int64_t> outputDimsN = {N, Nreturn};
-  int inputlen = N * Nsamp;
-  int outputlen = N * Nreturn;
-
-  std::vector<float> outputTensorValuesN(outputlen);
-
-  inputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, input.data(), inputlen, inputDimsN.data(), inputDimsN.size()));
-  outputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, outputTensorValuesN.data(), outputlen, outputDimsN.data(), outputDimsN.size()));
-
-#if ORT_API_VERSION == 12
-  std::vector<const char *> inputNames{session->GetInputName(0, allocator)};
-  std::vector<const char *> outputNames{session->GetOutputName(0, allocator)};
-#elif ORT_API_VERSION == 22
-  std::vector<const char *> inputNames;
-  std::vector<const char *> outputNames;
-
-  char *name{nullptr};
-  for (const std::string &s : session->GetInputNames())
+  // the environment has to outlive all sessions created with it
+  Ort::Env &onnxEnv()
   {
-    name = new char[s.size() + 1];
-    sprintf(name, "%s", s.c_str());
-    inputNames.push_back(name);
+    static Ort::Env env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "fit");
+    return env;
   }
-  for (const std::string &s : session->GetOutputNames())
+
+  void onnxNames(Ort::Session *session, std::vector<std::string> &inputNames, std::vector<std::string> &outputNames)
   {
-    name = new char[s.size() + 1];
-    sprintf(name, "%s", s.c_str());
-    outputNames.push_back(name);
-  }
+#if ORT_API_VERSION == 12
+    Ort::AllocatorWithDefaultOptions allocator;
+    char *name = session->GetInputName(0, allocator);
+    inputNames.emplace_back(name);
+    allocator.Free(name);
+    name = session->GetOutputName(0, allocator);
+    outputNames.emplace_back(name);
+    allocator.Free(name);
+#elif ORT_API_VERSION == 22
+    inputNames = session->GetInputNames();
+    outputNames = session->GetOutputNames();
 #else
 #define XSTR(x) STR(x)
 #define STR(x) #x
 #pragma message "ORT_API_VERSION " XSTR(ORT_API_VERSION) " not implemented"
 #endif
-  session->Run(Ort::RunOptions{nullptr}, inputNames.data(), inputTensors.data(), 1, outputNames.data(), outputTensors.data(), 1);
+  }
 
-#if ORT_API_VERSION == 22
-  for (auto iter : inputNames)
+  // batch size the model was exported with, -1 if it is dynamic
+  int64_t onnxBatchSize(Ort::Session *session)
   {
-    delete[] iter;
+    std::vector<int64_t> shape = session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+    return shape.empty() ? -1 : shape[0];
   }
-  for (auto iter : outputNames)
+}  // namespace
+
+Ort::Session *onnxSession(std::string &modelfile, int intraOpThreads)
+{
+  Ort::SessionOptions sessionOptions;
+  sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+  if (intraOpThreads > 0)
   {
-    delete[] iter;
+    sessionOptions.SetIntraOpNumThreads(intraOpThreads);
   }
-#endif
+
+  return new Ort::Session(onnxEnv(), modelfile.c_str(), sessionOptions);
+}
+
+std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nsamp, int Nreturn)
+{
+  std::vector<float> outputTensorValuesN;
+  onnxInference(session, input, N, {Nsamp}, Nreturn, outputTensorValuesN);
   return outputTensorValuesN;
 }
 
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nx, int Ny, int Nz, int Nreturn)
 {
-  // Define the memory information for ONNX Runtime
-  Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-
-  Ort::AllocatorWithDefaultOptions allocator;
-
-  std::vector<int64_t> inputDims = {N, Nx, Ny, Nz};
-  std::vector<int64_t> outputDimsN = {N, Nreturn};
-  int inputlen = N * Nx * Ny * Nz;
-  int outputlen = N * Nreturn;
-
-  std::vector<float> outputTensorValues(outputlen);
-
-  std::vector<Ort::Value> inputTensors;
-  std::vector<Ort::Value> outputTensors;
+  std::vector<float> outputTensorValues;
+  onnxInference(session, input, N, {Nx, Ny, Nz}, Nreturn, outputTensorValues);
+  return outputTensorValues;
+}
 
-  inputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, input.data(), inputlen, inputDims.data(), inputDims.size()));
+void onnxInference(Ort::Session *session, std::vector<float> &input, int N, const std::vector<int64_t> &shape, int Nreturn, std::vector<float> &output)
+{
+  output.resize(static_cast<size_t>(N) * Nreturn);
+  if (N <= 0)
+  {
+    return;
+  }
 
-  outputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, outputTensorValues.data(), outputlen, outputDimsN.data(), outputDimsN.size()));
+  int64_t itemlen = 1;
+  for (auto dim : shape)
+  {
+    itemlen *= dim;
+  }
 
-#if ORT_API_VERSION == 12
-  std::vector<const char *> inputNames{session->GetInputName(0, allocator)};
-  std::vector<const char *> outputNames{session->GetOutputName(0, allocator)};
-#elif ORT_API_VERSION == 22
+  std::vector<std::string> inputNameStrings;
+  std::vector<std::string> outputNameStrings;
+  onnxNames(session, inputNameStrings, outputNameStrings);
   std::vector<const char *> inputNames;
   std::vector<const char *> outputNames;
-  char *name{nullptr};
-  for (const std::string &s : session->GetInputNames())
+  for (const auto &s : inputNameStrings)
   {
-    name = new char[s.size() + 1];
-    sprintf(name, "%s", s.c_str());
-    inputNames.push_back(name);
+    inputNames.push_back(s.c_str());
   }
-  for (const std::string &s : session->GetOutputNames())
+  for (const auto &s : outputNameStrings)
   {
-    name = new char[s.size() + 1];
-    sprintf(name, "%s", s.c_str());
-    outputNames.push_back(name);
+    outputNames.push_back(s.c_str());
   }
-#else
-#define XSTR(x) STR(x)
-#define STR(x) #x
-#pragma message "ORT_API_VERSION " XSTR(ORT_API_VERSION) " not implemented"
-#endif
-  session->Run(Ort::RunOptions{nullptr}, inputNames.data(), inputTensors.data(), 1, outputNames.data(), outputTensors.data(), 1);
-#if ORT_API_VERSION == 22
-  for (auto iter : inputNames)
+
+  // a fixed batch size needs the last chunk padded with zeros
+  const int64_t modelbatch = onnxBatchSize(session);
+  const int64_t chunk = (modelbatch > 0) ? modelbatch : N;
+  const int64_t nchunks = (N + chunk - 1) / chunk;
+  if (static_cast<int64_t>(input.size()) < nchunks * chunk * itemlen)
   {
-    delete[] iter;
+    input.resize(nchunks * chunk * itemlen, 0);
   }
-  for (auto iter : outputNames)
+  std::vector<float> padded;
+  if (nchunks * chunk > N)
   {
-    delete[] iter;
+    padded.resize(chunk * Nreturn);
   }
-#endif
 
-  return outputTensorValues;
+  Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+  std::vector<int64_t> inputDims{chunk};
+  inputDims.insert(inputDims.end(), shape.begin(), shape.end());
+  std::vector<int64_t> outputDims{chunk, Nreturn};
+  for (int64_t ichunk = 0; ichunk < nchunks; ++ichunk)
+  {
+    const int64_t first = ichunk * chunk;
+    const bool last_padded = (first + chunk > N);
+    float *outputdata = last_padded ? padded.data() : output.data() + first * Nreturn;
+
+    std::vector<Ort::Value> inputTensors;
+    std::vector<Ort::Value> outputTensors;
+    inputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, input.data() + first * itemlen, chunk * itemlen, inputDims.data(), inputDims.size()));
+    outputTensors.push_back(Ort::Value::CreateTensor<float>(memoryInfo, outputdata, chunk * Nreturn, outputDims.data(), outputDims.size()));
+    session->Run(Ort::RunOptions{nullptr}, inputNames.data(), inputTensors.data(), 1, outputNames.data(), outputTensors.data(), 1);
+
+    if (last_padded)
+    {
+      std::copy(padded.begin(), padded.begin() + (N - first) * Nreturn, output.begin() + first * Nreturn);
+    }
+  }
 }
@@ -3,12 +3,25 @@
 
 #include <onnxruntime_c_api.h>
 #include <onnxruntime_cxx_api.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
 // This is a stub for some ONNX code refactoring
 
-Ort::Session *onnxSession(std::string &modelfile);
+//! intraOpThreads is the number of threads onnxruntime uses inside one inference, 0 is the onnxruntime default
+Ort::Session *onnxSession(std::string &modelfile, int intraOpThreads = 0);
 
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nsamp, int Nreturn);
 
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nx, int Ny, int Nz, int Nreturn);
 
+//! Batched inference: runs all N inputs of the given shape (without the batch dimension)
+//! in one call, input holds N * product(shape) values. output is resized to N * Nreturn,
+//! keep input and output from event to event to reuse their memory.
+//! Models with a fixed batch size are run in chunks of this size, input is then
+//! grown to a multiple of the batch size
+void onnxInference(Ort::Session *session, std::vector<float> &input, int N, const std::vector<int64_t> &shape, int Nreturn, std::vector<float> &output);
+
 #endif
@@ -0,0 +1,233 @@
+#include "TowerInfoContainerv5.h"
+
+#include <algorithm>
+
+void TowerInfoView::Reset()
+{
+  m_container->set_energy(m_channel, 0);
+  m_container->set_time(m_channel, 0);
+  m_container->set_chi2(m_channel, 0);
+  m_container->set_pedestal(m_channel, 0);
+  m_container->set_status(m_channel, 0);
+}
+
+void TowerInfoView::Clear(Option_t* /*unused*/)
+{
+  Reset();
+}
+
+void TowerInfoView::set_time(float t)
+{
+  m_container->set_time(m_channel, t);
+}
+
+float TowerInfoView::get_time()
+{
+  return m_container->get_time(m_channel);
+}
+
+void TowerInfoView::set_time_short(short t)
+{
+  m_container->set_time_short(m_channel, t);
+}
+
+short TowerInfoView::get_time_short()
+{
+  return m_container->get_time_short(m_channel);
+}
+
+void TowerInfoView::set_energy(float energy)
+{
+  m_container->set_energy(m_channel, energy);
+}
+
+float TowerInfoView::get_energy()
+{
+  return m_container->get_energy(m_channel);
+}
+
+void TowerInfoView::set_chi2(float chi2)
+{
+  m_container->set_chi2(m_channel, chi2);
+}
+
+float TowerInfoView::get_chi2()
+{
+  return m_container->get_chi2(m_channel);
+}
+
+void TowerInfoView::set_pedestal(float pedestal)
+{
+  m_container->set_pedestal(m_channel, pedestal);
+}
+
+float TowerInfoView::get_pedestal()
+{
+  return m_container->get_pedestal(m_channel);
+}
+
+uint8_t TowerInfoView::get_status() const
+{
+  return m_container->get_status(m_channel);
+}
+
+void TowerInfoView::set_status(uint8_t status)
+{
+  m_container->set_status(m_channel, status);
+}
+
+void TowerInfoView::set_status_bit(int bit, bool value)
+{
+  m_container->set_status_bit(m_channel, bit, value);
+}
+
+bool TowerInfoView::get_status_bit(int bit) const
+{
+  return m_container->get_status_bit(m_channel, bit);
+}
+
+void TowerInfoView::copy_tower(TowerInfo* tower)
+{
+  set_time(tower->get_time());
+  set_energy(tower->get_energy());
+  set_chi2(tower->get_chi2());
+  set_pedestal(tower->get_pedestal());
+  set_status(tower->get_status());
+}
+
+TowerInfoContainerv5::TowerInfoContainerv5(DETECTOR detec)
+  : _detector(detec)
+{
+  int nchannels = 744;
+  if (_detector == DETECTOR::SEPD)
+  {
+    nchannels = 744;
+  }
+  else if (_detector == DETECTOR::EMCAL)
+  {
+    nchannels = 24576;
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    nchannels = 1536;
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    nchannels = 256;
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    nchannels = 52;
+  }
+  resize(nchannels);
+}
+
+TowerInfoContainerv5::TowerInfoContainerv5(const TowerInfoContainerv5& source)
+  : TowerInfoContainer(source)
+  , _detector(source.get_detectorid())
+{
+  // like the other containers, the copy has the same channels, cleared for first use
+  resize(source.size());
+}
+
+void TowerInfoContainerv5::resize(size_t nchannels)
+{
+  _energy.assign(nchannels, 0);
+  _time.assign(nchannels, 0);
+  _chi2.assign(nchannels, 0);
+  _pedestal.assign(nchannels, 0);
+  _status.assign(nchannels, 0);
+}
+
+void TowerInfoContainerv5::identify(std::ostream& os) const
+{
+  os << "TowerInfoContainerv5 of size " << size() << std::endl;
+}
+
+void TowerInfoContainerv5::Reset()
+{
+  // clear content of all channels for the next event
+  std::fill(_energy.begin(), _energy.end(), 0);
+  std::fill(_time.begin(), _time.end(), 0);
+  std::fill(_chi2.begin(), _chi2.end(), 0);
+  std::fill(_pedestal.begin(), _pedestal.end(), 0);
+  std::fill(_status.begin(), _status.end(), 0);
+}
+
+TowerInfo* TowerInfoContainerv5::get_tower_at_channel(int pos)
+{
+  if (pos < 0 || pos >= static_cast<int>(size()))
+  {
+    return nullptr;
+  }
+  // the number of channels only changes when reading from file
+  if (_views.size() != size())
+  {
+    _views.clear();
+    _views.reserve(size());
+    for (unsigned int channel = 0; channel < size(); ++channel)
+    {
+      _views.emplace_back(this, channel);
+    }
+  }
+  return &_views[pos];
+}
+
+TowerInfo* TowerInfoContainerv5::get_tower_at_key(int pos)
+{
+  int index = decode_key(pos);
+  return get_tower_at_channel(index);
+}
+
+unsigned int TowerInfoContainerv5::encode_key(unsigned int towerIndex)
+{
+  int key = 0;
+  if (_detector == DETECTOR::EMCAL)
+  {
+    key = TowerInfoContainer::encode_emcal(towerIndex);
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    key = TowerInfoContainer::encode_hcal(towerIndex);
+  }
+  else if (_detector == DETECTOR::SEPD)
+  {
+    key = TowerInfoContainer::encode_epd(towerIndex);
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    key = TowerInfoContainer::encode_mbd(towerIndex);
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    key = TowerInfoContainer::encode_zdc(towerIndex);
+  }
+  return key;
+}
+
+unsigned int TowerInfoContainerv5::decode_key(unsigned int tower_key)
+{
+  int index = 0;
+
+  if (_detector == DETECTOR::EMCAL)
+  {
+    index = TowerInfoContainer::decode_emcal(tower_key);
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    index = TowerInfoContainer::decode_hcal(tower_key);
+  }
+  else if (_detector == DETECTOR::SEPD)
+  {
+    index = TowerInfoContainer::decode_epd(tower_key);
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    index = TowerInfoContainer::decode_mbd(tower_key);
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    index = TowerInfoContainer::decode_zdc(tower_key);
+  }
+  return index;
+}
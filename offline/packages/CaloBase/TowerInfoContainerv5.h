@@ -0,0 +1,182 @@
+#ifndef TOWERINFOCONTAINERV5_H
+#define TOWERINFOCONTAINERV5_H
+
+#include "TowerInfo.h"
+#include "TowerInfoContainer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+class PHObject;
+class TowerInfoContainerv5;
+
+// TowerInfo interface to one channel of a TowerInfoContainerv5 for existing code,
+// all values are read from and written to the arrays of the container
+class TowerInfoView : public TowerInfo
+{
+ public:
+  TowerInfoView() = default;
+  TowerInfoView(TowerInfoContainerv5 *container, unsigned int channel)
+    : m_container(container)
+    , m_channel(channel)
+  {
+  }
+
+  ~TowerInfoView() override = default;
+
+  void Reset() override;
+  void Clear(Option_t * = "") override;
+
+  void set_time(float t) override;
+  float get_time() override;
+  void set_time_short(short t) override;
+  short get_time_short() override;
+  void set_energy(float energy) override;
+  float get_energy() override;
+  void set_chi2(float chi2) override;
+  float get_chi2() override;
+  void set_pedestal(float pedestal) override;
+  float get_pedestal() override;
+
+  void set_isHot(bool isHot) override { set_status_bit(0, isHot); }
+  bool get_isHot() const override { return get_status_bit(0); }
+
+  void set_isBadTime(bool isBadTime) override { set_status_bit(1, isBadTime); }
+  bool get_isBadTime() const override { return get_status_bit(1); }
+
+  void set_isBadChi2(bool isBadChi2) override { set_status_bit(2, isBadChi2); }
+  bool get_isBadChi2() const override { return get_status_bit(2); }
+
+  void set_isNotInstr(bool isNotInstr) override { set_status_bit(3, isNotInstr); }
+  bool get_isNotInstr() const override { return get_status_bit(3); }
+
+  void set_isNoCalib(bool isNoCalib) override { set_status_bit(4, isNoCalib); }
+  bool get_isNoCalib() const override { return get_status_bit(4); }
+
+  void set_isZS(bool isZS) override { set_status_bit(5, isZS); }
+  bool get_isZS() const override { return get_status_bit(5); }
+
+  void set_isRecovered(bool isRecovered) override { set_status_bit(6, isRecovered); }
+  bool get_isRecovered() const override { return get_status_bit(6); }
+
+  void set_isSaturated(bool isSaturated) override { set_status_bit(7, isSaturated); }
+  bool get_isSaturated() const override { return get_status_bit(7); }
+
+  bool get_isGood() const override { return !(get_isHot() || get_isBadChi2() || get_isNoCalib()); }
+
+  uint8_t get_status() const override;
+  void set_status(uint8_t status) override;
+
+  void copy_tower(TowerInfo *tower) override;
+
+ private:
+  void set_status_bit(int bit, bool value);
+  bool get_status_bit(int bit) const;
+
+  TowerInfoContainerv5 *m_container = nullptr;
+  unsigned int m_channel = 0;
+};
+
+// same content as TowerInfoContainerv2 (time, energy, chi2, pedestal and status per channel)
+// but stored as one array per quantity instead of a TClonesArray of towers
+class TowerInfoContainerv5 : public TowerInfoContainer
+{
+ public:
+  TowerInfoContainerv5(DETECTOR detec);
+
+  // default constructor for ROOT IO
+  TowerInfoContainerv5() = default;
+  PHObject *CloneMe() const override { return new TowerInfoContainerv5(*this); }
+  TowerInfoContainerv5(const TowerInfoContainerv5 &);
+
+  ~TowerInfoContainerv5() override = default;
+
+  void identify(std::ostream &os = std::cout) const override;
+
+  void Reset() override;
+
+  //! the returned towers are views on the arrays, valid as long as the container
+  TowerInfo *get_tower_at_channel(int pos) override;
+  TowerInfo *get_tower_at_key(int pos) override;
+
+  unsigned int encode_key(unsigned int towerIndex) override;
+  unsigned int decode_key(unsigned int tower_key) override;
+
+  size_t size() const override { return _energy.size(); }
+  DETECTOR get_detectorid() const override { return _detector; }
+
+  //!@name per channel access, without going through TowerInfo
+  //@{
+  float get_energy(unsigned int channel) const { return _energy[channel]; }
+  void set_energy(unsigned int channel, float energy) { _energy[channel] = energy; }
+
+  // time is stored in 1/1000 of its unit as short, like in TowerInfov1 and TowerInfov2
+  float get_time(unsigned int channel) const { return _time[channel] / 1000.; }
+  void set_time(unsigned int channel, float t) { _time[channel] = t * 1000; }
+  short get_time_short(unsigned int channel) const { return short(_time[channel] / 1000); }
+  void set_time_short(unsigned int channel, short t) { _time[channel] = t * 1000; }
+
+  float get_chi2(unsigned int channel) const { return _chi2[channel]; }
+  void set_chi2(unsigned int channel, float chi2) { _chi2[channel] = chi2; }
+
+  float get_pedestal(unsigned int channel) const { return _pedestal[channel]; }
+  void set_pedestal(unsigned int channel, float pedestal) { _pedestal[channel] = pedestal; }
+
+  uint8_t get_status(unsigned int channel) const { return _status[channel]; }
+  void set_status(unsigned int channel, uint8_t status) { _status[channel] = status; }
+
+  //! status bits as in TowerInfov2 (0: hot, 1: bad time, 2: bad chi2, 3: not instrumented, 4: no calib, 5: ZS, 6: recovered, 7: saturated)
+  bool get_status_bit(unsigned int channel, int bit) const
+  {
+    if (bit < 0 || bit > 7)
+    {
+      return false;  // default behavior
+    }
+    return (_status[channel] & ((uint8_t) 1 << bit)) != 0;
+  }
+  void set_status_bit(unsigned int channel, int bit, bool value)
+  {
+    if (bit < 0 || bit > 7)
+    {
+      return;
+    }
+    _status[channel] &= ~((uint8_t) 1 << bit);
+    _status[channel] |= (uint8_t) value << bit;
+  }
+  //@}
+
+  //!@name bulk access to all channels, indexed by channel
+  //@{
+  std::span<float> get_energy_array() { return _energy; }
+  std::span<const float> get_energy_array() const { return _energy; }
+  std::span<short> get_time_array() { return _time; }
+  std::span<const short> get_time_array() const { return _time; }
+  std::span<float> get_chi2_array() { return _chi2; }
+  std::span<const float> get_chi2_array() const { return _chi2; }
+  std::span<float> get_pedestal_array() { return _pedestal; }
+  std::span<const float> get_pedestal_array() const { return _pedestal; }
+  std::span<uint8_t> get_status_array() { return _status; }
+  std::span<const uint8_t> get_status_array() const { return _status; }
+  //@}
+
+ protected:
+  std::vector<float> _energy;
+  std::vector<short> _time;
+  std::vector<float> _chi2;
+  std::vector<float> _pedestal;
+  std::vector<uint8_t> _status;
+  DETECTOR _detector = DETECTOR_INVALID;
+
+ private:
+  void resize(size_t nchannels);
+
+  //! TowerInfo views, created on first use
+  std::vector<TowerInfoView> _views;  //!
+
+  ClassDefOverride(TowerInfoContainerv5, 1);
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include <calobase/TowerInfoContainerv2.h>
 #include <calobase/TowerInfoContainerv3.h>
 #include <calobase/TowerInfoContainerv4.h>
+#include <calobase/TowerInfoContainerv5.h>
 
 #include <ffarawobjects/CaloPacket.h>
 #include <ffarawobjects/CaloPacketContainer.h>
@@ -37,6 +38,7 @@
 #include <climits>
 #include <iostream>  // for operator<<, endl, basic...
 #include <memory>    // for allocator_traits<>::val...
+#include <string>
 #include <variant>
 #include <vector>  // for vector
 
@@ -170,6 +172,22 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
   }
 
   CreateNodeTree(topNode);
+
+  // nodes used by process_event, for the parallel scheduling in the Fun4AllServer
+  if (m_isdata)
+  {
+    DeclareInputNode("PRDF");
+    DeclareInputNode(nodemap.find(m_dettype)->second);
+    for (int pid = m_packet_low; pid <= m_packet_high; pid++)
+    {
+      DeclareInputNode(std::to_string(pid));
+    }
+  }
+  else
+  {
+    DeclareInputNode(m_inputNodePrefix + m_detector);
+  }
+  DeclareOutputNode(m_outputNodePrefix + m_detector);
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -638,6 +656,10 @@ void CaloTowerBuilder::CreateNodeTree(PHCompositeNode *topNode)
   {
     m_CaloInfoContainer = new TowerInfoContainerSimv1(DetectorEnum);
   }
+  else if (m_buildertype == CaloTowerDefs::kWaveformTowerv5)
+  {
+    m_CaloInfoContainer = new TowerInfoContainerv5(DetectorEnum);
+  }
   else
   {
     std::cout << PHWHERE << "invalid builder type " << m_buildertype << std::endl;
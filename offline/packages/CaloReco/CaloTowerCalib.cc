@@ -5,6 +5,7 @@
 #include <calobase/TowerInfoContainer.h>
 #include <calobase/TowerInfoContainerv1.h>
 #include <calobase/TowerInfoContainerv2.h>
+#include <calobase/TowerInfoContainerv5.h>
 #include <calobase/TowerInfov1.h>
 #include <calobase/TowerInfov2.h>
 
@@ -28,6 +29,7 @@
 
 #include <TSystem.h>
 
+#include <algorithm>  // for ranges::copy
 #include <cstdlib>    // for exit
 #include <exception>  // for exception
 #include <iostream>   // for operator<<, basic_ostream
@@ -228,20 +230,25 @@ void CaloTowerCalib::LoadCalib(PHCompositeNode *topNode)
   unsigned int ntowers = _raw_towers->size();
   m_cdbInfo_vec.resize(ntowers);
 
+  // resolve the field names once, the loop then only does channel lookups
+  const int calib_handle = cdbttree->GetFloatColumnHandle(m_fieldname);
+  const int crosscalib_handle = m_doZScrosscalib ? cdbttree_ZScrosscalib->GetFloatColumnHandle(m_fieldname_ZScrosscalib) : -1;
+  const int time_handle = m_dotimecalib ? cdbttree_time->GetFloatColumnHandle(m_fieldname_time) : -1;
+
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
     unsigned int key = _raw_towers->encode_key(channel);
 
-    m_cdbInfo_vec[channel].calibconst = cdbttree->GetFloatValue(key, m_fieldname);
+    m_cdbInfo_vec[channel].calibconst = cdbttree->GetFloatColumnValue(key, calib_handle);
 
     if (m_doZScrosscalib)
     {
-      m_cdbInfo_vec[channel].crosscalibconst = cdbttree_ZScrosscalib->GetFloatValue(key, m_fieldname_ZScrosscalib);
+      m_cdbInfo_vec[channel].crosscalibconst = cdbttree_ZScrosscalib->GetFloatColumnValue(key, crosscalib_handle);
     }
 
     if(m_dotimecalib)
     {
-      m_cdbInfo_vec[channel].meantime = cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      m_cdbInfo_vec[channel].meantime = cdbttree_time->GetFloatColumnValue(key, time_handle);
     }
   }
 }
@@ -253,6 +260,47 @@ int CaloTowerCalib::process_event(PHCompositeNode *topNode)
   TowerInfoContainer *_calib_towers = findNode::getClass<TowerInfoContainer>(topNode, CalibTowerNodeName);
   unsigned int ntowers = _raw_towers->size();
 
+  // structure of arrays containers are calibrated directly on the channel arrays
+  auto *raw_soa = dynamic_cast<TowerInfoContainerv5 *>(_raw_towers);
+  auto *calib_soa = dynamic_cast<TowerInfoContainerv5 *>(_calib_towers);
+  if (raw_soa && calib_soa && calib_soa->size() == ntowers)
+  {
+    std::ranges::copy(raw_soa->get_energy_array(), calib_soa->get_energy_array().begin());
+    std::ranges::copy(raw_soa->get_time_array(), calib_soa->get_time_array().begin());
+    std::ranges::copy(raw_soa->get_chi2_array(), calib_soa->get_chi2_array().begin());
+    std::ranges::copy(raw_soa->get_pedestal_array(), calib_soa->get_pedestal_array().begin());
+    std::ranges::copy(raw_soa->get_status_array(), calib_soa->get_status_array().begin());
+    const auto raw_energy = raw_soa->get_energy_array();
+    auto calib_energy = calib_soa->get_energy_array();
+    for (unsigned int channel = 0; channel < ntowers; channel++)
+    {
+      float calibconst = m_cdbInfo_vec[channel].calibconst;
+      bool isZS = raw_soa->get_status_bit(channel, 5);
+      if (isZS && m_doZScrosscalib)
+      {
+        float crosscalibconst = m_cdbInfo_vec[channel].crosscalibconst;
+        if (crosscalibconst == 0)
+        {
+          crosscalibconst = 1;
+        }
+        calib_energy[channel] = raw_energy[channel] * calibconst * crosscalibconst;
+      }
+      else
+      {
+        calib_energy[channel] = raw_energy[channel] * calibconst;
+      }
+      if (calibconst == 0)
+      {
+        calib_soa->set_status_bit(channel, 4, true);  // no calib
+      }
+      if (m_dotimecalib && !isZS)
+      {
+        calib_soa->set_time(channel, raw_soa->get_time(channel) - m_cdbInfo_vec[channel].meantime);
+      }
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
     TowerInfo *caloinfo_raw = _raw_towers->get_tower_at_channel(channel);
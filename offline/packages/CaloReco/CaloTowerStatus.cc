@@ -221,22 +221,28 @@ void CaloTowerStatus::LoadCalib()
   unsigned int ntowers = m_raw_towers->size();
   m_cdbInfo_vec.resize(ntowers);
 
+  // resolve the field names once, the loop then only does channel lookups
+  const int chi2_handle = m_doHotChi2 ? m_cdbttree_chi2->GetFloatColumnHandle(m_fieldname_chi2) : -1;
+  const int time_handle = m_doTime ? m_cdbttree_time->GetFloatColumnHandle(m_fieldname_time) : -1;
+  const int hotmap_handle = m_doHotMap ? m_cdbttree_hotMap->GetIntColumnHandle(m_fieldname_hotMap) : -1;
+  const int z_score_handle = m_doHotMap ? m_cdbttree_hotMap->GetFloatColumnHandle(m_fieldname_z_score) : -1;
+
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
     unsigned int key = m_raw_towers->encode_key(channel);
 
     if (m_doHotChi2)
     {
-      m_cdbInfo_vec[channel].fraction_badChi2 = m_cdbttree_chi2->GetFloatValue(key, m_fieldname_chi2);
+      m_cdbInfo_vec[channel].fraction_badChi2 = m_cdbttree_chi2->GetFloatColumnValue(key, chi2_handle);
     }
     if (m_doTime)
     {
-      m_cdbInfo_vec[channel].mean_time = m_cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      m_cdbInfo_vec[channel].mean_time = m_cdbttree_time->GetFloatColumnValue(key, time_handle);
     }
     if (m_doHotMap)
     {
-      m_cdbInfo_vec[channel].hotMap_val = m_cdbttree_hotMap->GetIntValue(key, m_fieldname_hotMap);
-      m_cdbInfo_vec[channel].z_score = m_cdbttree_hotMap->GetFloatValue(key, m_fieldname_z_score);
+      m_cdbInfo_vec[channel].hotMap_val = m_cdbttree_hotMap->GetIntColumnValue(key, hotmap_handle);
+      m_cdbInfo_vec[channel].z_score = m_cdbttree_hotMap->GetFloatColumnValue(key, z_score_handle);
     }
   }
 }
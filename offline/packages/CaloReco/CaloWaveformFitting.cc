@@ -43,6 +43,7 @@ void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
   fin->Close();
   delete fin;
   m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
+  m_templateFit.set_template(h_template);
   t = new ROOT::TThreadExecutor(_nthreads);
 }
 
@@ -119,6 +120,10 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
         }
         v.push_back(0);
       }
+      else if (_analyticTemplateFit)
+      {
+        analytic_templatefit(v, size1, pedestal);
+      }
       else
       {
         auto *h = new TH1F(std::string("h_" + std::to_string((int) round(v.at(size1)))).c_str(), "", size1, -0.5, size1 - 0.5);
@@ -305,6 +310,79 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
   return fit_params;
 }
 
+void CaloWaveformFitting::analytic_templatefit(std::vector<float> &v, const int size1, const float pedestal) const
+{
+  // same sample selection, time limits and bit flip recovery as the ROOT fit above
+  thread_local CaloWaveformTemplateFit::Workspace ws;
+  ws.clear();
+  for (int i = 0; i < size1; ++i)
+  {
+    if ((v.at(i) == 16383) && _handleSaturation)
+    {
+      continue;
+    }
+    ws.add(i, v.at(i));
+  }
+  // if too many are saturated don't do the saturation recovery need enough ndf
+  if (static_cast<int>(ws.size()) < (size1 - 4))
+  {
+    ws.clear();
+    for (int i = 0; i < size1; ++i)
+    {
+      ws.add(i, v.at(i));
+    }
+  }
+  const int ndata = ws.size();
+
+  double tmin = -1 * m_peakTimeTemp;
+  double tmax = size1 - m_peakTimeTemp;
+  if (m_setTimeLim)
+  {
+    tmin = m_timeLim_low;
+    tmax = m_timeLim_high;
+  }
+  const CaloWaveformTemplateFit::Result fitres = m_templateFit.fit(ws, tmin, tmax);
+  const double chi2min = fitres.chi2 / (ndata - 3);  // divide by the number of dof
+
+  if (chi2min > _chi2threshold && (fitres.pedestal < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (fitres.pedestal > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
+  {
+    std::vector<float> rv(v.begin(), v.begin() + size1);  // temporary recovered waveform
+    unsigned int bits[3] = {8192, 4096, 2048};
+    for (auto bit : bits)
+    {
+      for (int i = 0; i < size1; i++)
+      {
+        if (((unsigned int) rv.at(i) & bit) && ((unsigned int) rv.at(i) % bit > _bfr_lowpedestalthreshold))
+        {
+          rv.at(i) = rv.at(i) - bit;
+        }
+      }
+    }
+    ws.clear();
+    for (int i = 0; i < size1; i++)
+    {
+      ws.add(i, rv.at(i));
+    }
+    const CaloWaveformTemplateFit::Result recover_fitres = m_templateFit.fit(ws, -1 * m_peakTimeTemp, size1 - m_peakTimeTemp);
+    const double recover_chi2min = recover_fitres.chi2 / (size1 - 3);  // divide by the number of dof
+    if (recover_chi2min < _chi2lowthreshold && recover_fitres.pedestal < _bfr_highpedestalthreshold && recover_fitres.pedestal > _bfr_lowpedestalthreshold)
+    {
+      std::copy(rv.begin(), rv.end(), v.begin());
+      v.push_back(recover_fitres.amplitude);
+      v.push_back(recover_fitres.time);
+      v.push_back(recover_fitres.pedestal);
+      v.push_back(recover_chi2min);
+      v.push_back(1);
+      return;
+    }
+  }
+  v.push_back(fitres.amplitude);
+  v.push_back(fitres.time);
+  v.push_back(fitres.pedestal);
+  v.push_back(chi2min);
+  v.push_back(0);
+}
+
 void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax)
 {
   int n = 3;
@@ -1,6 +1,8 @@
 #ifndef CALORECO_CALOWAVEFORMFITTING_H
 #define CALORECO_CALOWAVEFORMFITTING_H
 
+#include "CaloWaveformTemplateFit.h"
+
 #include <string>
 #include <vector>
 
@@ -57,6 +59,12 @@ class CaloWaveformFitting
     _handleSaturation = handleSaturation;
   }
 
+  //! use the closed form template fit instead of the ROOT fitter
+  void set_analyticTemplateFit(bool analytic = true)
+  {
+    _analyticTemplateFit = analytic;
+  }
+
   std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
   std::vector<std::vector<float>> calo_processing_templatefit(std::vector<std::vector<float>> chnlvector);
   static std::vector<std::vector<float>> calo_processing_fast(const std::vector<std::vector<float>> &chnlvector);
@@ -74,6 +82,8 @@ class CaloWaveformFitting
 
   static float psinc(float t, std::vector<float> &vec_signal_samples);
   double template_function(double *x, double *par);
+  //! template fit of one waveform with CaloWaveformTemplateFit, appends the fit results to v
+  void analytic_templatefit(std::vector<float> &v, const int size1, const float pedestal) const;
 
   TProfile *h_template{nullptr};
   double m_peakTimeTemp{0};
@@ -92,6 +102,9 @@ class CaloWaveformFitting
   bool m_setTimeLim{false};
   bool _dobitfliprecovery{false};
   bool _handleSaturation{true};
+  bool _analyticTemplateFit{false};
+
+  CaloWaveformTemplateFit m_templateFit;
 
   std::string m_template_input_file;
   std::string url_template;
@@ -51,12 +51,13 @@ void CaloWaveformProcessing::initialize_processing()
     {
       m_Fitter->set_bitFlipRecovery(_dobitfliprecovery);
     }
+    m_Fitter->set_analyticTemplateFit(_analyticTemplateFit);
   }
   else if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
     // std::string calibrations_repo_model = m_model_name;
     // url_onnx = CDBInterface::instance()->getUrl("CEMC_ONNX", m_model_name);
-    onnxmodule = onnxSession(m_model_name);
+    onnxmodule = onnxSession(m_model_name, m_onnx_nthreads);
   }
   else if (m_processingtype == CaloWaveformProcessing::NYQUIST)
   {
@@ -97,6 +98,8 @@ std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::ve
 std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector)
 {
   std::vector<std::vector<float>> fit_values;
+  m_onnx_input.clear();
+  m_onnx_index.clear();
   std::vector<float> val;  // single row to return
   unsigned int nchnls = chnlvector.size();
   for (unsigned int m = 0; m < nchnls; m++)
@@ -167,18 +170,10 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(con
         unsigned int nsamples = v.size();
         if (nsamples == 12)
         {
-          // downstream onnx does not have a static input vector API,
-          // so we need to make a copy
-          std::vector<float> vtmp(v);
-          val = onnxInference(onnxmodule, vtmp, 1, 12, 3);
-          unsigned int nvals = val.size();
-          for (unsigned int i = 0; i < nvals; i++)
-          {
-            val.at(i) = val.at(i) * m_Onnx_factor[i] + m_Onnx_offset[i];
-          }
-          val.push_back(2000);
-          val.push_back(0);
-          fit_values.push_back(val);
+          // collect the waveform, the whole event is run through the model at once below
+          m_onnx_input.insert(m_onnx_input.end(), v.begin(), v.end());
+          m_onnx_index.push_back(fit_values.size());
+          fit_values.emplace_back();
         }
         else
         {
@@ -189,6 +184,22 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(con
       }
     }
   }
+
+  const int nonnx = m_onnx_index.size();
+  if (nonnx > 0)
+  {
+    onnxInference(onnxmodule, m_onnx_input, nonnx, {12}, 3, m_onnx_output);
+    for (int m = 0; m < nonnx; m++)
+    {
+      std::vector<float> &fit = fit_values[m_onnx_index[m]];
+      for (unsigned int i = 0; i < 3; i++)
+      {
+        fit.push_back(m_onnx_output[m * 3 + i] * m_Onnx_factor[i] + m_Onnx_offset[i]);
+      }
+      fit.push_back(2000);
+      fit.push_back(0);
+    }
+  }
   return fit_values;
 }
 
@@ -75,6 +75,12 @@ class CaloWaveformProcessing : public SubsysReco
     _dobitfliprecovery = dobitfliprecovery;
   }
 
+  //! use the closed form template fit (CaloWaveformTemplateFit) instead of the ROOT fitter
+  void set_analyticTemplateFit(bool analytic = true)
+  {
+    _analyticTemplateFit = analytic;
+  }
+
   std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
   std::vector<std::vector<float>> calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector);
 
@@ -83,6 +89,8 @@ class CaloWaveformProcessing : public SubsysReco
   // onnx options
   void set_onnx_factor(const int i, const double val) { m_Onnx_factor.at(i) = val; }
   void set_onnx_offset(const int i, const double val) { m_Onnx_offset.at(i) = val; }
+  //! threads used by onnxruntime inside one inference, 0 is the onnxruntime default
+  void set_onnx_nthreads(const int n) { m_onnx_nthreads = n; }
 
  private:
   CaloWaveformFitting *m_Fitter{nullptr};
@@ -94,6 +102,7 @@ class CaloWaveformProcessing : public SubsysReco
   int _nsoftwarezerosuppression{40};
   bool _bdosoftwarezerosuppression{false};
   bool _dobitfliprecovery{false};
+  bool _analyticTemplateFit{false};
 
   std::string m_template_input_file;
   std::string url_template;
@@ -108,6 +117,11 @@ class CaloWaveformProcessing : public SubsysReco
   std::string m_model_name{"CEMC_ONNX"};
   std::array<double, 3> m_Onnx_factor{std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
   std::array<double, 3> m_Onnx_offset{std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
+  int m_onnx_nthreads{0};
+  // batched inference buffers, kept from event to event
+  std::vector<float> m_onnx_input;
+  std::vector<float> m_onnx_output;
+  std::vector<unsigned int> m_onnx_index;
 };
 
 #endif
@@ -0,0 +1,141 @@
+#include "CaloWaveformTemplateFit.h"
+
+#include <TProfile.h>
+
+#include <algorithm>
+#include <cmath>
+
+void CaloWaveformTemplateFit::set_template(const TProfile *h)
+{
+  const int nbins = h->GetNbinsX();
+  m_content.resize(nbins);
+  for (int i = 0; i < nbins; i++)
+  {
+    m_content[i] = h->GetBinContent(i + 1);
+  }
+  m_firstCenter = h->GetBinCenter(1);
+  m_binWidth = h->GetBinWidth(1);
+}
+
+double CaloWaveformTemplateFit::template_value(const double x) const
+{
+  // same as TH1::Interpolate: flat outside of the first and last bin centers
+  const double u = (x - m_firstCenter) / m_binWidth;
+  if (u <= 0)
+  {
+    return m_content.front();
+  }
+  const int ibin = static_cast<int>(u);
+  if (ibin >= static_cast<int>(m_content.size()) - 1)
+  {
+    return m_content.back();
+  }
+  const double frac = u - ibin;
+  return m_content[ibin] + frac * (m_content[ibin + 1] - m_content[ibin]);
+}
+
+double CaloWaveformTemplateFit::solve(Workspace &ws, const double time, double &amplitude, double &pedestal) const
+{
+  const unsigned int n = ws.size();
+  ws.shape.resize(n);
+  double st = 0;
+  double stt = 0;
+  double sy = 0;
+  double sty = 0;
+  double syy = 0;
+  for (unsigned int i = 0; i < n; i++)
+  {
+    const double t = template_value(ws.x[i] - time);
+    ws.shape[i] = t;
+    st += t;
+    stt += t * t;
+    sy += ws.y[i];
+    sty += t * ws.y[i];
+    syy += ws.y[i] * ws.y[i];
+  }
+  const double det = n * stt - st * st;
+  if (det <= 0)
+  {
+    // flat template over all samples, only the pedestal is defined
+    amplitude = 0;
+    pedestal = sy / n;
+  }
+  else
+  {
+    amplitude = (n * sty - st * sy) / det;
+    pedestal = (sy - amplitude * st) / n;
+  }
+  // chi2 at the minimum, clamped against rounding
+  return std::max(0., syy - amplitude * sty - pedestal * sy);
+}
+
+CaloWaveformTemplateFit::Result CaloWaveformTemplateFit::fit(Workspace &ws, const double tmin, const double tmax) const
+{
+  Result result;
+  if (ws.size() == 0 || m_content.empty())
+  {
+    return result;
+  }
+
+  double amplitude;
+  double pedestal;
+
+  // grid search
+  const int nsteps = std::max(1, static_cast<int>(std::ceil((tmax - tmin) / m_timeStep)));
+  const double step = (tmax - tmin) / nsteps;
+  double besttime = tmin;
+  double bestchi2 = solve(ws, tmin, amplitude, pedestal);
+  for (int i = 1; i <= nsteps; i++)
+  {
+    const double time = tmin + i * step;
+    const double chi2 = solve(ws, time, amplitude, pedestal);
+    if (chi2 < bestchi2)
+    {
+      bestchi2 = chi2;
+      besttime = time;
+    }
+  }
+
+  // golden section search in the neighbouring grid cells
+  static const double invphi = (std::sqrt(5.) - 1) / 2;
+  double a = std::max(tmin, besttime - step);
+  double b = std::min(tmax, besttime + step);
+  double c = b - invphi * (b - a);
+  double d = a + invphi * (b - a);
+  double fc = solve(ws, c, amplitude, pedestal);
+  double fd = solve(ws, d, amplitude, pedestal);
+  while (b - a > m_timeTolerance)
+  {
+    if (fc < fd)
+    {
+      b = d;
+      d = c;
+      fd = fc;
+      c = b - invphi * (b - a);
+      fc = solve(ws, c, amplitude, pedestal);
+    }
+    else
+    {
+      a = c;
+      c = d;
+      fc = fd;
+      d = a + invphi * (b - a);
+      fd = solve(ws, d, amplitude, pedestal);
+    }
+  }
+  const double time = 0.5 * (a + b);
+  const double chi2 = solve(ws, time, amplitude, pedestal);
+  if (chi2 <= bestchi2)
+  {
+    result.time = time;
+    result.chi2 = chi2;
+  }
+  else
+  {
+    result.time = besttime;
+    result.chi2 = solve(ws, besttime, amplitude, pedestal);
+  }
+  result.amplitude = amplitude;
+  result.pedestal = pedestal;
+  return result;
+}
@@ -0,0 +1,78 @@
+#ifndef CALORECO_CALOWAVEFORMTEMPLATEFIT_H
+#define CALORECO_CALOWAVEFORMTEMPLATEFIT_H
+
+#include <vector>
+
+class TProfile;
+
+/**
+ * Template fit of a calorimeter waveform without ROOT fitter objects.
+ *
+ * The waveform is modelled as amplitude * template(x - time) + pedestal.
+ * For a given time the amplitude and pedestal are the solution of a linear
+ * least squares problem, which is solved in closed form, so only the time is
+ * searched for: first on a grid over the allowed range, then by a golden
+ * section search around the best grid point.
+ * The template is copied out of the TProfile and interpolated like
+ * TH1::Interpolate does, so fit() is const and can be called from many threads,
+ * each thread passing its own Workspace.
+ */
+class CaloWaveformTemplateFit
+{
+ public:
+  struct Result
+  {
+    double amplitude{0};
+    double time{0};
+    double pedestal{0};
+    //! chi2 (sample errors are 1), not divided by the number of degrees of freedom
+    double chi2{0};
+  };
+
+  //! samples to fit, reused from waveform to waveform
+  struct Workspace
+  {
+    void clear()
+    {
+      x.clear();
+      y.clear();
+    }
+    void add(const double xval, const double yval)
+    {
+      x.push_back(xval);
+      y.push_back(yval);
+    }
+    unsigned int size() const { return x.size(); }
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> shape;
+  };
+
+  //! copy the template from the profile
+  void set_template(const TProfile *h);
+
+  //! step of the grid search in time (samples)
+  void set_time_step(const double step) { m_timeStep = step; }
+
+  //! precision of the time (samples)
+  void set_time_tolerance(const double tol) { m_timeTolerance = tol; }
+
+  //! template value, linear interpolation between bin centers
+  double template_value(const double x) const;
+
+  //! fit the samples in ws for a time in [tmin, tmax]
+  Result fit(Workspace &ws, const double tmin, const double tmax) const;
+
+ private:
+  //! best amplitude and pedestal for a given time, returns the chi2
+  double solve(Workspace &ws, const double time, double &amplitude, double &pedestal) const;
+
+  std::vector<double> m_content;
+  double m_firstCenter{0};
+  double m_binWidth{1};
+  double m_timeStep{0.2};
+  double m_timeTolerance{1e-3};
+};
+
+#endif
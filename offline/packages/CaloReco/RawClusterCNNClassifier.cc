@@ -39,7 +39,7 @@ RawClusterCNNClassifier::~RawClusterCNNClassifier() = default;
 int RawClusterCNNClassifier::Init(PHCompositeNode *topNode)
 {
   // init the onnx model
-  onnxmodule = onnxSession(m_modelPath);
+  onnxmodule = onnxSession(m_modelPath, m_onnx_nthreads);
 
   if (m_inputNodeName == m_outputNodeName)
   {
@@ -93,6 +93,11 @@ int RawClusterCNNClassifier::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // the images of all clusters are collected and classified in one inference
+  int vectorSize = inputDimx * inputDimy;
+  m_input.clear();
+  m_inputClusters.clear();
+
   RawClusterContainer::Map clusterMap = _clusters->getClustersMap();
   for (auto &clusterPair : clusterMap)
   {
@@ -148,19 +153,19 @@ int RawClusterCNNClassifier::process_event(PHCompositeNode *topNode)
       }
     }
     // find the N by N tower around the max tower
-    std::vector<float> input;
-    // resize to inputDimx * inputDimy
-    int vectorSize = inputDimx * inputDimy;
-    input.resize(vectorSize, 0);
+    int xlength = ((inputDimx - 1) / 2);
+    int ylength = ((inputDimy - 1) / 2);
+    if (maxtowerE > 0 && (maxtowerieta - ylength < 0 || maxtowerieta + ylength >= 96))
+    {
+      continue;
+    }
+    // append the inputDimx * inputDimy image of this cluster
+    m_inputClusters.push_back(recoCluster);
+    m_input.resize(m_inputClusters.size() * vectorSize, 0);
+    float *input = m_input.data() + (m_inputClusters.size() - 1) * vectorSize;
 
     if (maxtowerE > 0)
     {
-      int xlength = ((inputDimx - 1) / 2);
-      int ylength = ((inputDimy - 1) / 2);
-      if (maxtowerieta - ylength < 0 || maxtowerieta + ylength >= 96)
-      {
-        continue;
-      }
       for (int ieta = maxtowerieta - ylength; ieta <= maxtowerieta + ylength; ieta++)
       {
         for (int iphi = maxtoweriphi - xlength; iphi <= maxtoweriphi + xlength; iphi++)
@@ -185,14 +190,21 @@ int RawClusterCNNClassifier::process_event(PHCompositeNode *topNode)
             continue;
           }
           int index = ((ieta - maxtowerieta + ylength) * inputDimx) + iphi - maxtoweriphi + xlength;
-          input.at(index) = towerinfo->get_energy();
+          input[index] = towerinfo->get_energy();
         }
       }
     }
-    std::vector<float> prob = onnxInference(onnxmodule, input, 1, inputDimx, inputDimy, inputDimz, outputDim);
-    // std::cout << "new prob: " << prob[0] << "ET: " << ET << " original prob: " << recoCluster->get_prob() << std::endl;
-    // inplace change for the prob for now
-    recoCluster->set_prob(prob[0]);
+  }
+
+  const int nclusters = m_inputClusters.size();
+  if (nclusters > 0)
+  {
+    onnxInference(onnxmodule, m_input, nclusters, {inputDimx, inputDimy, inputDimz}, outputDim, m_output);
+    for (int i = 0; i < nclusters; i++)
+    {
+      // inplace change for the prob for now
+      m_inputClusters[i]->set_prob(m_output[i * outputDim]);
+    }
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -5,7 +5,11 @@
 
 #include <phool/onnxlib.h>
 
+#include <string>
+#include <vector>
+
 class PHCompositeNode;
+class RawCluster;
 class RawClusterContainer;
 
 class RawClusterCNNClassifier : public SubsysReco
@@ -33,6 +37,9 @@ class RawClusterCNNClassifier : public SubsysReco
 
   void set_min_cluster_e(const float min_cluster_e) { m_min_cluster_e = min_cluster_e; }
 
+  //! threads used by onnxruntime inside one inference, 0 is the onnxruntime default
+  void set_onnx_nthreads(const int n) { m_onnx_nthreads = n; }
+
  private:
   Ort::Session *onnxmodule{nullptr};
   const int inputDimx{5};
@@ -54,6 +61,13 @@ class RawClusterCNNClassifier : public SubsysReco
 
   float m_min_cluster_e{3};
 
+  int m_onnx_nthreads{0};
+
+  // batched inference buffers, kept from event to event
+  std::vector<float> m_input;
+  std::vector<float> m_output;
+  std::vector<RawCluster *> m_inputClusters;
+
   void CreateNodes(PHCompositeNode* topNode);
 
 
@@ -15,37 +15,118 @@
 #include <boost/stacktrace.hpp>
 #pragma GCC diagnostic pop
 
+#include <fcntl.h>  // for open
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>  // for close
+
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
-#include <iterator>
+#include <limits>
 #include <set>
+#include <sstream>
 #include <utility>
 
-PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
-  : filename(fname)
+namespace
 {
-  std::cout << "PHField3DCartesian::PHField3DCartesian" << std::endl;
+  //! layout of the cache file: header, x, y, z grid values (double), field (float)
+  struct CacheHeader
+  {
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    uint32_t nx = 0;
+    uint32_t ny = 0;
+    uint32_t nz = 0;
+    float magfield_rescale = 0;
+    float innerradius = 0;
+    float outerradius = 0;
+    float size_z = 0;
+    int64_t source_size = 0;
+    int64_t source_mtime = 0;
+  };
+
+  constexpr std::array<char, 8> cache_magic{'P', 'H', 'F', '3', 'D', 'C', 'A', 'R'};
+  constexpr uint32_t cache_version = 1;
+
+  //! size and modification time of the field map file, used to invalidate the cache
+  bool source_stamp(const std::string &fname, int64_t &size, int64_t &mtime)
+  {
+    struct stat st{};
+    if (stat(fname.c_str(), &st) != 0)
+    {
+      return false;
+    }
+    size = st.st_size;
+    mtime = st.st_mtime;
+    return true;
+  }
 
-  for (int i = 0; i < 2; i++)
+  //! cache file name, contains a hash of the construction parameters
+  std::string cache_filename(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
   {
-    for (int j = 0; j < 2; j++)
+    const char *cachedir = getenv("PHFIELD_CACHE_DIR");
+    if (!cachedir)
     {
-      for (int k = 0; k < 2; k++)
-      {
-        for (int l = 0; l < 3; l++)
-        {
-          bf[i][j][k][l] = NAN;
-        }
-      }
+      return "";
     }
+    std::ostringstream params;
+    params << fname << "_" << magfield_rescale << "_" << innerradius << "_" << outerradius << "_" << size_z;
+    std::string basename = fname.substr(fname.find_last_of('/') + 1);
+    std::ostringstream name;
+    name << cachedir << "/" << basename << "." << std::hex << std::hash<std::string>{}(params.str()) << ".grid";
+    return name.str();
   }
+}  // namespace
+
+PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+  : filename(fname)
+{
+  std::cout << "PHField3DCartesian::PHField3DCartesian" << std::endl;
+
   std::cout << "\n================ Begin Construct Mag Field =====================" << std::endl;
   std::cout << "\n-----------------------------------------------------------"
             << "\n      Magnetic field Module - Verbosity:"
             << "\n-----------------------------------------------------------";
 
+  const std::string cachefile = cache_filename(filename, magfield_rescale, innerradius, outerradius, size_z);
+  if (!cachefile.empty() && ReadCache(cachefile, magfield_rescale, innerradius, outerradius, size_z))
+  {
+    std::cout << "\n ---> "
+                 "Read the field grid from cache file "
+              << cachefile << std::endl;
+  }
+  else
+  {
+    ReadNtuple(magfield_rescale, innerradius, outerradius, size_z);
+    if (!cachefile.empty())
+    {
+      WriteCache(cachefile, magfield_rescale, innerradius, outerradius, size_z);
+    }
+  }
+
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+PHField3DCartesian::~PHField3DCartesian()
+{
+  std::cout << "PHField3DCartesian::~PHField3DCartesian" << std::endl;
+  if (mapaddress)
+  {
+    munmap(mapaddress, mapsize);
+  }
+}
+
+void PHField3DCartesian::ReadNtuple(const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -76,26 +157,66 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
   field_map->SetBranchAddress("bx", &ROOT_BX);
   field_map->SetBranchAddress("by", &ROOT_BY);
   field_map->SetBranchAddress("bz", &ROOT_BZ);
+
+  // first pass: grid coordinates and the points which go into the map
+  struct GridPoint
+  {
+    float x;
+    float y;
+    float z;
+    float bx;
+    float by;
+    float bz;
+  };
+  std::vector<GridPoint> points;
+  std::set<float> xset;
+  std::set<float> yset;
+  std::set<float> zset;
   for (int i = 0; i < field_map->GetEntries(); i++)
   {
     field_map->GetEntry(i);
-    trio coord_key(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm);
-    trio field_val(ROOT_BX * tesla * magfield_rescale, ROOT_BY * tesla * magfield_rescale, ROOT_BZ * tesla * magfield_rescale);
-    xvals.insert(ROOT_X * cm);
-    yvals.insert(ROOT_Y * cm);
-    zvals.insert(ROOT_Z * cm);
+    xset.insert(ROOT_X * cm);
+    yset.insert(ROOT_Y * cm);
+    zset.insert(ROOT_Z * cm);
     if ((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
          std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
         std::abs(ROOT_Z * cm) > size_z)
     {
-      fieldmap[coord_key] = field_val;
+      points.push_back({static_cast<float>(ROOT_X * cm), static_cast<float>(ROOT_Y * cm), static_cast<float>(ROOT_Z * cm),
+                        static_cast<float>(ROOT_BX * tesla * magfield_rescale), static_cast<float>(ROOT_BY * tesla * magfield_rescale), static_cast<float>(ROOT_BZ * tesla * magfield_rescale)});
     }
   }
-  xmin = *(xvals.begin());
-  xmax = *(xvals.rbegin());
+  delete field_map;
+  delete rootinput;
+
+  xvals.assign(xset.begin(), xset.end());
+  yvals.assign(yset.begin(), yset.end());
+  zvals.assign(zset.begin(), zset.end());
+  if (xvals.size() < 2 || yvals.size() < 2 || zvals.size() < 2)
+  {
+    std::cout << PHWHERE << " field map in " << filename << " needs at least 2 grid points per axis, exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+
+  // second pass: fill the grid, points not in the map stay NaN
+  fieldgrid.assign(xvals.size() * yvals.size() * zvals.size() * 3, std::numeric_limits<float>::quiet_NaN());
+  auto index = [](const std::vector<double> &vals, const float v)
+  { return std::lower_bound(vals.begin(), vals.end(), v) - vals.begin(); };
+  for (const auto &point : points)
+  {
+    const size_t offset = ((index(xvals, point.x) * yvals.size() + index(yvals, point.y)) * zvals.size() + index(zvals, point.z)) * 3;
+    fieldgrid[offset] = point.bx;
+    fieldgrid[offset + 1] = point.by;
+    fieldgrid[offset + 2] = point.bz;
+  }
+  fielddata = fieldgrid.data();
+
+  xmin = xvals.front();
+  xmax = xvals.back();
 
-  ymin = *(yvals.begin());
-  ymax = *(yvals.rbegin());
+  ymin = yvals.front();
+  ymax = yvals.back();
   if (ymin != xmin || ymax != xmax)
   {
     std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
@@ -103,27 +224,201 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
     exit(1);
   }
 
-  zmin = *(zvals.begin());
-  zmax = *(zvals.rbegin());
+  zmin = zvals.front();
+  zmax = zvals.back();
 
   xstepsize = (xmax - xmin) / (xvals.size() - 1);
   ystepsize = (ymax - ymin) / (yvals.size() - 1);
   zstepsize = (zmax - zmin) / (zvals.size() - 1);
+}
 
-  delete field_map;
-  delete rootinput;
-  std::cout << "\n================= End Construct Mag Field ======================\n"
-            << std::endl;
+bool PHField3DCartesian::ReadCache(const std::string &cachefile, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+{
+  int64_t source_size = 0;
+  int64_t source_mtime = 0;
+  if (!source_stamp(filename, source_size, source_mtime))
+  {
+    return false;
+  }
+  const int fd = open(cachefile.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat st{};
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(CacheHeader))
+  {
+    close(fd);
+    return false;
+  }
+  mapsize = st.st_size;
+  mapaddress = mmap(nullptr, mapsize, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after closing the file
+  close(fd);
+  if (mapaddress == MAP_FAILED)
+  {
+    mapaddress = nullptr;
+    return false;
+  }
+
+  CacheHeader header;
+  std::memcpy(&header, mapaddress, sizeof(CacheHeader));
+  const size_t naxis = static_cast<size_t>(header.nx) + header.ny + header.nz;
+  const size_t nfield = static_cast<size_t>(header.nx) * header.ny * header.nz * 3;
+  if (header.magic != cache_magic ||
+      header.version != cache_version ||
+      header.magfield_rescale != magfield_rescale ||
+      header.innerradius != innerradius ||
+      header.outerradius != outerradius ||
+      header.size_z != size_z ||
+      header.source_size != source_size ||
+      header.source_mtime != source_mtime ||
+      header.nx < 2 || header.ny < 2 || header.nz < 2 ||
+      mapsize != sizeof(CacheHeader) + naxis * sizeof(double) + nfield * sizeof(float))
+  {
+    std::cout << "PHField3DCartesian: cache file " << cachefile << " does not match " << filename << ", rebuilding it" << std::endl;
+    munmap(mapaddress, mapsize);
+    mapaddress = nullptr;
+    mapsize = 0;
+    return false;
+  }
+
+  const char *data = static_cast<const char *>(mapaddress) + sizeof(CacheHeader);
+  const double *axis = reinterpret_cast<const double *>(data);
+  xvals.assign(axis, axis + header.nx);
+  yvals.assign(axis + header.nx, axis + header.nx + header.ny);
+  zvals.assign(axis + header.nx + header.ny, axis + naxis);
+  fielddata = reinterpret_cast<const float *>(data + naxis * sizeof(double));
+
+  xmin = xvals.front();
+  xmax = xvals.back();
+  ymin = yvals.front();
+  ymax = yvals.back();
+  zmin = zvals.front();
+  zmax = zvals.back();
+
+  xstepsize = (xmax - xmin) / (xvals.size() - 1);
+  ystepsize = (ymax - ymin) / (yvals.size() - 1);
+  zstepsize = (zmax - zmin) / (zvals.size() - 1);
+  return true;
 }
 
-PHField3DCartesian::~PHField3DCartesian()
+void PHField3DCartesian::WriteCache(const std::string &cachefile, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z) const
 {
-  std::cout << "PHField3DCartesian::~PHField3DCartesian" << std::endl;
+  CacheHeader header;
+  if (!source_stamp(filename, header.source_size, header.source_mtime))
+  {
+    // not a local file, nothing to invalidate the cache with
+    return;
+  }
+  header.magic = cache_magic;
+  header.version = cache_version;
+  header.nx = xvals.size();
+  header.ny = yvals.size();
+  header.nz = zvals.size();
+  header.magfield_rescale = magfield_rescale;
+  header.innerradius = innerradius;
+  header.outerradius = outerradius;
+  header.size_z = size_z;
+
+  // write to a temporary file and rename it, so concurrent jobs never map a partial file
+  const std::string tmpfile = cachefile + "." + std::to_string(getpid());
+  std::ofstream out(tmpfile, std::ios::binary);
+  if (!out)
+  {
+    std::cout << "PHField3DCartesian: cannot write cache file " << tmpfile << std::endl;
+    return;
+  }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(CacheHeader));
+  for (const auto *vals : {&xvals, &yvals, &zvals})
+  {
+    out.write(reinterpret_cast<const char *>(vals->data()), vals->size() * sizeof(double));
+  }
+  out.write(reinterpret_cast<const char *>(fieldgrid.data()), fieldgrid.size() * sizeof(float));
+  out.close();
+  if (!out || std::rename(tmpfile.c_str(), cachefile.c_str()) != 0)
+  {
+    std::cout << "PHField3DCartesian: cannot write cache file " << cachefile << std::endl;
+    std::remove(tmpfile.c_str());
+    return;
+  }
+  std::cout << "PHField3DCartesian: wrote field grid cache file " << cachefile << std::endl;
+}
+
+unsigned int PHField3DCartesian::FindCell(const std::vector<double> &vals, const double min, const double stepsize, const double x)
+{
+  // the grid is regular, the step size gives the cell directly. The grid values are
+  // floats, so check against them and move by one cell if rounding put x next door
+  const int ncells = vals.size() - 1;
+  int i = std::clamp(static_cast<int>((x - min) / stepsize), 0, ncells - 1);
+  while (i > 0 && x < vals[i])
+  {
+    --i;
+  }
+  while (i < ncells - 1 && x > vals[i + 1])
+  {
+    ++i;
+  }
+  return i;
+}
+
+void PHField3DCartesian::Interpolate(const double point[4], double *Bfield) const
+{
+  const unsigned int ix = FindCell(xvals, xmin, xstepsize, point[0]);
+  const unsigned int iy = FindCell(yvals, ymin, ystepsize, point[1]);
+  const unsigned int iz = FindCell(zvals, zmin, zstepsize, point[2]);
+
+  // normalized distance to the lower corner of the cell
+  const double fractionx = (point[0] - xvals[ix]) / xstepsize;
+  const double fractiony = (point[1] - yvals[iy]) / ystepsize;
+  const double fractionz = (point[2] - zvals[iz]) / zstepsize;
   if (Verbosity() > 0)
   {
-    std::cout << "PHField3DCartesian: cache hits: " << cache_hits
-              << " cache misses: " << cache_misses
-              << std::endl;
+    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
+    std::cout << "x/y/z cell: " << xvals[ix] / cm << "/" << yvals[iy] / cm << "/" << zvals[iz] / cm << std::endl;
+    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
+  }
+
+  // the 8 corners of the cell
+  const size_t zstride = 3;
+  const size_t ystride = zvals.size() * zstride;
+  const size_t xstride = yvals.size() * ystride;
+  const float *c000 = fielddata + ix * xstride + iy * ystride + iz * zstride;
+  const std::array<const float *, 8> corner = {
+      c000, c000 + zstride, c000 + ystride, c000 + ystride + zstride,
+      c000 + xstride, c000 + xstride + zstride, c000 + xstride + ystride, c000 + xstride + ystride + zstride};
+  const std::array<double, 8> weight = {
+      (1. - fractionx) * (1. - fractiony) * (1. - fractionz),
+      (1. - fractionx) * (1. - fractiony) * fractionz,
+      (1. - fractionx) * fractiony * (1. - fractionz),
+      (1. - fractionx) * fractiony * fractionz,
+      fractionx * (1. - fractiony) * (1. - fractionz),
+      fractionx * (1. - fractiony) * fractionz,
+      fractionx * fractiony * (1. - fractionz),
+      fractionx * fractiony * fractionz};
+
+  double bfield[3] = {0., 0., 0.};
+  for (int icorner = 0; icorner < 8; ++icorner)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      bfield[i] += weight[icorner] * corner[icorner][i];
+    }
+  }
+
+  // NaN if any corner is not in the field map
+  if (!std::isfinite(bfield[0]) || !std::isfinite(bfield[1]) || !std::isfinite(bfield[2]))
+  {
+    std::cout << PHWHERE << " could not locate grid point in " << filename
+              << " for x: " << point[0] / cm
+              << ", y: " << point[1] / cm
+              << ", z: " << point[2] / cm << std::endl;
+    return;
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    Bfield[i] = bfield[i];
   }
 }
 
@@ -177,151 +472,7 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
     return;
   }
 
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
-
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    zkey[1] = *it;
-  }
-
-  if (xkey_save != xkey[0] ||
-      ykey_save != ykey[0] ||
-      zkey_save != zkey[0])
-  {
-    cache_misses++;
-    xkey_save = xkey[0];
-    ykey_save = ykey[0];
-    zkey_save = zkey[0];
-
-    std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-    trio key;
-    for (int i = 0; i < 2; i++)
-    {
-      for (int j = 0; j < 2; j++)
-      {
-        for (int k = 0; k < 2; k++)
-        {
-          key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-          magval = fieldmap.find(key);
-          if (magval == fieldmap.end())
-          {
-            std::cout << PHWHERE << " could not locate key in " << filename
-                      << " value: x: " << xkey[i] / cm
-                      << ", y: " << ykey[j] / cm
-                      << ", z: " << zkey[k] / cm << std::endl;
-            return;
-          }
-          bf[i][j][k][0] = std::get<0>(magval->second);
-          bf[i][j][k][1] = std::get<1>(magval->second);
-          bf[i][j][k][2] = std::get<2>(magval->second);
-          if (Verbosity() > 0)
-          {
-            const double x_loc = std::get<0>(magval->first);
-            const double y_loc = std::get<1>(magval->first);
-            const double z_loc = std::get<2>(magval->first);
-
-            std::cout << "read x/y/z: " << x_loc / cm << "/"
-              << y_loc / cm << "/"
-              << z_loc / cm << " bx/by/bz: "
-              << bf[i][j][k][0] / tesla << "/"
-              << bf[i][j][k][1] / tesla << "/"
-              << bf[i][j][k][2] / tesla << std::endl;
-          }
-        }
-      }
-    }
-  }
-  else
-  {
-    cache_hits++;
-  }
-
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
-  if (Verbosity() > 0)
-  {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
-
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
-  for (int i = 0; i < 3; i++)
-  {
-    Bfield[i] = bf[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
-  }
-
-  return;
+  Interpolate(point, Bfield);
 }
 
 //_____________________________________________________________
@@ -343,140 +494,5 @@ void PHField3DCartesian::GetFieldValue_nocache(const double point[4], double *Bf
       point[2] < zmin || point[2] > zmax)
   { return; }
 
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
-
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    zkey[1] = *it;
-  }
-
-  // local xyz and field
-  double bf_loc[2][2][2][3]{};
-
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-  trio key;
-  for (int i = 0; i < 2; i++)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      for (int k = 0; k < 2; k++)
-      {
-        key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-        magval = fieldmap.find(key);
-        if (magval == fieldmap.end())
-        {
-          std::cout << PHWHERE << " could not locate key in " << filename
-            << " value: x: " << xkey[i] / cm
-            << ", y: " << ykey[j] / cm
-            << ", z: " << zkey[k] / cm << std::endl;
-          return;
-        }
-
-        bf_loc[i][j][k][0] = std::get<0>(magval->second);
-        bf_loc[i][j][k][1] = std::get<1>(magval->second);
-        bf_loc[i][j][k][2] = std::get<2>(magval->second);
-        if (Verbosity() > 0)
-        {
-
-          const double x_loc = std::get<0>(magval->first);
-          const double y_loc = std::get<1>(magval->first);
-          const double z_loc = std::get<2>(magval->first);
-
-          std::cout << "read x/y/z: " << x_loc / cm << "/"
-            << y_loc / cm << "/"
-            << z_loc / cm << " bx/by/bz: "
-            << bf_loc[i][j][k][0] / tesla << "/"
-            << bf_loc[i][j][k][1] / tesla << "/"
-            << bf_loc[i][j][k][2] / tesla << std::endl;
-        }
-      }
-    }
-  }
-
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
-  if (Verbosity() > 0)
-  {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
-
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
-  for (int i = 0; i < 3; i++)
-  {
-    Bfield[i] = bf_loc[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf_loc[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf_loc[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf_loc[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf_loc[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf_loc[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf_loc[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf_loc[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
-  }
-
-  return;
+  Interpolate(point, Bfield);
 }
@@ -4,11 +4,23 @@
 #include "PHField.h"
 
 #include <cmath>
-#include <map>
-#include <set>
+#include <cstddef>
 #include <string>
-#include <tuple>
+#include <vector>
 
+/**
+ * 3D field map on a regular cartesian grid
+ *
+ * The field is kept in a dense array (bx, by, bz interleaved, z running fastest),
+ * so the cell of a point is found by index arithmetic and the field is
+ * interpolated trilinearly from the 8 corners of the cell.
+ * Grid points which are not in the map (outside of the inner/outer radius) are NaN,
+ * points in cells touching them get a zero field.
+ *
+ * If the environment variable PHFIELD_CACHE_DIR is set, the grid is written to a
+ * binary cache file in this directory the first time a map is read and later jobs
+ * memory map this file instead of reading the ROOT ntuple
+ */
 class PHField3DCartesian : public PHField
 {
  public:
@@ -28,6 +40,21 @@ class PHField3DCartesian : public PHField
   void GetFieldValue_nocache(const double Point[4], double *Bfield) const override;
 
   private:
+  //! read the field map ntuple and fill the grid
+  void ReadNtuple(const float magfield_rescale, const float innerradius, const float outerradius, const float size_z);
+
+  //! memory map the grid from the cache file, returns false if the file does not exist or does not match
+  bool ReadCache(const std::string &cachefile, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z);
+
+  //! write the grid to the cache file
+  void WriteCache(const std::string &cachefile, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z) const;
+
+  //! find the cell of x along one axis, returns the index of the lower grid point
+  static unsigned int FindCell(const std::vector<double> &vals, const double min, const double stepsize, const double x);
+
+  //! trilinear interpolation on the grid
+  void Interpolate(const double point[4], double *Bfield) const;
+
   std::string filename;
   double xmin = 1000000;
   double xmax = -1000000;
@@ -39,20 +66,20 @@ class PHField3DCartesian : public PHField
   double ystepsize = NAN;
   double zstepsize = NAN;
 
-  // these are updated in a const method
-  // to cache previous values
-  mutable double bf[2][2][2][3]{};
-  mutable double xkey_save = NAN;
-  mutable double ykey_save = NAN;
-  mutable double zkey_save = NAN;
-  mutable int cache_hits = 0;
-  mutable int cache_misses = 0;
-
-  typedef std::tuple<float, float, float> trio;
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
-  std::set<float> xvals;
-  std::set<float> yvals;
-  std::set<float> zvals;
+  //! grid point coordinates along each axis
+  std::vector<double> xvals;
+  std::vector<double> yvals;
+  std::vector<double> zvals;
+
+  //! field on the grid when it is read from the ntuple
+  std::vector<float> fieldgrid;
+
+  //! points to fieldgrid or into the memory mapped cache file
+  const float *fielddata = nullptr;
+
+  //! memory mapped cache file
+  void *mapaddress = nullptr;
+  size_t mapsize = 0;
 };
 
 #endif
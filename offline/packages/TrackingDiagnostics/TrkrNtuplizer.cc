@@ -50,6 +50,9 @@
 #include <mbd/MbdPmtContainer.h>
 #include <mbd/MbdPmtHit.h>
 
+#include <g4eval/EvalNtuple.h>
+#include <g4eval/EvalNtupleFile.h>
+
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>
 
@@ -59,7 +62,7 @@
 #include <phool/recoConsts.h>
 
 #include <TFile.h>
-#include <TNtuple.h>
+#include <TROOT.h>
 #include <TVector3.h>
 
 #include <cmath>
@@ -325,8 +328,13 @@ int TrkrNtuplizer::Init(PHCompositeNode* /*unused*/)
 {
   _ievent = 0;
 
-  _tfile = new TFile(_filename.c_str(), "RECREATE");
-  _tfile->SetCompressionLevel(7);
+  _tfile = new EvalNtupleFile(_filename);
+  if (_async_output)
+  {
+    // the trees are filled on the writer thread of the file
+    ROOT::EnableThreadSafety();
+  }
+  _tfile->set_async(_async_output);
 
   std::string str_vertex = {"vertexID:vx:vy:vz:ntracks:chi2:ndof"};
   std::string str_event = {"event:seed:run:seg:job"};
@@ -339,47 +347,47 @@ int TrkrNtuplizer::Init(PHCompositeNode* /*unused*/)
   if (_do_info_eval)
   {
     std::string ntp_varlist_info = str_event + ":" + str_info;
-    _ntp_info = new TNtuple("ntp_info", "event info", ntp_varlist_info.c_str());
+    _ntp_info = _tfile->book("ntp_info", "event info", ntp_varlist_info);
   }
 
   if (_do_vertex_eval)
   {
     std::string ntp_varlist_vtx = str_event + ":" + str_vertex + ":" + str_info;
-    _ntp_vertex = new TNtuple("ntp_vertex", "vertex => max truth", ntp_varlist_vtx.c_str());
+    _ntp_vertex = _tfile->book("ntp_vertex", "vertex => max truth", ntp_varlist_vtx);
   }
 
   if (_do_hit_eval)
   {
     std::string ntp_varlist_ev = str_event + ":" + str_hit + ":" + str_info;
-    _ntp_hit = new TNtuple("ntp_hit", "svtxhit => max truth", ntp_varlist_ev.c_str());
+    _ntp_hit = _tfile->book("ntp_hit", "svtxhit => max truth", ntp_varlist_ev);
   }
 
   if (_do_cluster_eval)
   {
     std::string ntp_varlist_clu = str_event + ":" + str_cluster + ":" + str_info;
-    _ntp_cluster = new TNtuple("ntp_cluster", "svtxcluster => max truth", ntp_varlist_clu.c_str());
+    _ntp_cluster = _tfile->book("ntp_cluster", "svtxcluster => max truth", ntp_varlist_clu);
   }
   if (_do_clus_trk_eval)
   {
     std::string ntp_varlist_clut = str_event + ":" + str_cluster + ":" + str_residual + ":" + str_seed + ":" + str_info;
-    _ntp_clus_trk = new TNtuple("ntp_clus_trk", "cluster on track", ntp_varlist_clut.c_str());
+    _ntp_clus_trk = _tfile->book("ntp_clus_trk", "cluster on track", ntp_varlist_clut);
   }
 
   if (_do_track_eval)
   {
     std::string ntp_varlist_trk = str_event + ":" + str_track + ":" + str_info;
-    _ntp_track = new TNtuple("ntp_track", "svtxtrack => max truth", ntp_varlist_trk.c_str());
+    _ntp_track = _tfile->book("ntp_track", "svtxtrack => max truth", ntp_varlist_trk);
   }
 
   if (_do_tpcseed_eval)
   {
     std::string ntp_varlist_tsee = str_event + ":" + str_seed + ":" + str_info;
-    _ntp_tpcseed = new TNtuple("ntp_tpcseed", "seeds from truth", ntp_varlist_tsee.c_str());
+    _ntp_tpcseed = _tfile->book("ntp_tpcseed", "seeds from truth", ntp_varlist_tsee);
   }
   if (_do_siseed_eval)
   {
     std::string ntp_varlist_ssee = str_event + ":" + str_seed + ":" + str_info;
-    _ntp_siseed = new TNtuple("ntp_siseed", "seeds from truth", ntp_varlist_ssee.c_str());
+    _ntp_siseed = _tfile->book("ntp_siseed", "seeds from truth", ntp_varlist_ssee);
   }
 
   std::string dedx_fitparams = CDBInterface::instance()->getUrl("TPC_DEDX_FITPARAM");
@@ -835,6 +843,7 @@ int TrkrNtuplizer::process_event(PHCompositeNode* topNode)
   //---------------------------
 
   fillOutputNtuples(topNode);
+  _tfile->end_event(_ievent);
 
   //--------------------------------------------------
   // Print out the ancestry information for this event
@@ -859,41 +868,7 @@ int TrkrNtuplizer::process_event(PHCompositeNode* topNode)
 
 int TrkrNtuplizer::End(PHCompositeNode* /*topNode*/)
 {
-  _tfile->cd();
-
-  if (_ntp_info)
-  {
-    _ntp_info->Write();
-  }
-  if (_ntp_vertex)
-  {
-    _ntp_vertex->Write();
-  }
-  if (_ntp_hit)
-  {
-    _ntp_hit->Write();
-  }
-  if (_ntp_cluster)
-  {
-    _ntp_cluster->Write();
-  }
-  if (_ntp_clus_trk)
-  {
-    _ntp_clus_trk->Write();
-  }
-  if (_ntp_track)
-  {
-    _ntp_track->Write();
-  }
-  if (_ntp_tpcseed)
-  {
-    _ntp_tpcseed->Write();
-  }
-  if (_ntp_siseed)
-  {
-    _ntp_siseed->Write();
-  }
-
+  // writes the buffered rows and all trees
   _tfile->Close();
 
   delete _tfile;
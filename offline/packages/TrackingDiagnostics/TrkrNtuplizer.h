@@ -26,8 +26,8 @@ class CDBTTree;
 class PHCompositeNode;
 class PHTimer;
 class TrkrCluster;
-class TFile;
-class TNtuple;
+class EvalNtuple;
+class EvalNtupleFile;
 class SvtxTrack;
 class TrackSeed;
 class SvtxTrackMap;
@@ -88,6 +88,9 @@ class TrkrNtuplizer : public SubsysReco
   void runnumber(const int run) { m_runnumber = run; }
   void job(const int job) { m_job = job; }
 
+  //! fill the output trees on a separate thread
+  void set_async_output(bool b) { _async_output = b; }
+
  private:
   struct fee_info
   {
@@ -133,20 +136,21 @@ class TrkrNtuplizer : public SubsysReco
   bool _do_dedx_calib{false};
   bool _do_tpcseed_eval{false};
   bool _do_siseed_eval{false};
+  bool _async_output{false};
 
   unsigned int _nlayers_maps{3};
   unsigned int _nlayers_intt{4};
   unsigned int _nlayers_tpc{48};
   unsigned int _nlayers_mms{2};
 
-  TNtuple *_ntp_info{nullptr};
-  TNtuple *_ntp_vertex{nullptr};
-  TNtuple *_ntp_hit{nullptr};
-  TNtuple *_ntp_cluster{nullptr};
-  TNtuple *_ntp_clus_trk{nullptr};
-  TNtuple *_ntp_track{nullptr};
-  TNtuple *_ntp_tpcseed{nullptr};
-  TNtuple *_ntp_siseed{nullptr};
+  EvalNtuple *_ntp_info{nullptr};
+  EvalNtuple *_ntp_vertex{nullptr};
+  EvalNtuple *_ntp_hit{nullptr};
+  EvalNtuple *_ntp_cluster{nullptr};
+  EvalNtuple *_ntp_clus_trk{nullptr};
+  EvalNtuple *_ntp_track{nullptr};
+  EvalNtuple *_ntp_tpcseed{nullptr};
+  EvalNtuple *_ntp_siseed{nullptr};
 
   // evaluator output file
   std::string _filename;
@@ -198,7 +202,7 @@ class TrkrNtuplizer : public SubsysReco
 
   std::string _clustrackseedcontainer = "TpcTrackSeedContainer";
 
-  TFile *_tfile{nullptr};
+  EvalNtupleFile *_tfile{nullptr};
   PHTimer *_timer{nullptr};
 
   // output subroutines
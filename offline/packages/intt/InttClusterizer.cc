@@ -29,9 +29,6 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <iostream>
@@ -51,52 +48,6 @@ namespace
   }
 }  // namespace
 
-bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer)
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) <= 1)
-    {
-      if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) == 0)
-  {
-    if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int layer)
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs((int) (lhs->getPhiBin()) - (int) (rhs->getPhiBin())) <= 1)  // col
-    {
-      if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs((int) (lhs->getPhiBin()) - (int)(rhs->getPhiBin())) <= 1)
-  {
-    if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) == 0)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 InttClusterizer::InttClusterizer(const std::string& name,
                                  unsigned int /*min_layer*/,
                                  unsigned int /*max_layer*/)
@@ -229,8 +180,16 @@ int InttClusterizer::InitRun(PHCompositeNode* topNode)
       auto newNode = new PHIODataNode<PHObject>(mClusHitsVerbose, "Trkr_SvtxClusHitsVerbose", "PHObject");
       DetNode->addNode(newNode);
     }
+    DeclareOutputNode("Trkr_SvtxClusHitsVerbose");
   }
 
+  // nodes used by process_event, for the parallel scheduling in the Fun4AllServer
+  DeclareInputNode(do_read_raw ? "TRKR_RAWHITSET" : "TRKR_HITSET");
+  DeclareInputNode("CYLINDERGEOM_INTT");
+  DeclareOutputNode("TRKR_CLUSTER");
+  DeclareOutputNode("TRKR_CLUSTERHITASSOC");
+  DeclareOutputNode("TRKR_CLUSTERCROSSINGASSOC");
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -400,29 +359,16 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // Find adjacent strips: neighbours in the same column (row +-1),
+    // with z clustering also in the neighbouring columns
+    std::vector<ConnectedHitLabeler::Coordinates> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (const auto& hit : hitvec)
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
+      coordinates.emplace_back(InttDefs::getCol(hit.first), InttDefs::getRow(hit.first));
     }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    std::vector<int> component;
+    m_labeler.label(coordinates, get_z_clustering(layer) ? 1 : 0, 1, component);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -670,29 +616,16 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // Find adjacent strips: with z clustering neighbours in phi and time,
+    // otherwise neighbours in phi with the same time bin
+    std::vector<ConnectedHitLabeler::Coordinates> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (const auto& hit : hitvec)
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
+      coordinates.emplace_back(hit->getPhiBin(), hit->getTBin());
     }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    std::vector<int> component;
+    m_labeler.label(coordinates, 1, get_z_clustering(layer) ? 1 : 0, component);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -7,7 +7,6 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
-#include <trackbase/TrkrHitv2.h>
 
 #include <ffarawobjects/Gl1RawHit.h>
 #include <ffarawobjects/Gl1Packet.h>
@@ -90,6 +89,15 @@ int InttCombinedRawDataDecoder::InitRun(PHCompositeNode* topNode)
     trkr_node->addNode(new_node);
   }
 
+  // flat TrkrHitSetv2 storage for the INTT hitsets, see TrkrHitSetContainerv1
+  if (m_flatHitSets)
+  {
+    if (auto flat_container = dynamic_cast<TrkrHitSetContainerv1*>(trkr_hit_set_container))
+    {
+      flat_container->setFlatHitSets(true);
+    }
+  }
+
   // Check if INTT event header already exists
   if (m_writeInttEventHeader)
   {
@@ -343,10 +351,9 @@ int InttCombinedRawDataDecoder::process_event(PHCompositeNode* topNode)
     // dac conversion
     int dac = m_dacmap.GetDAC(raw, adc);
 
-    hit = new TrkrHitv2;
+    hit = hit_set_container_itr->second->findOrAddHit(hit_key);
     //--hit->setAdc(adc);
     hit->setAdc(dac);
-    hit_set_container_itr->second->addHitSpecificKey(hit_key, hit);
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
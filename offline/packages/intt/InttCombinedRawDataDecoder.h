@@ -56,6 +56,8 @@ class InttCombinedRawDataDecoder : public SubsysReco
   void set_outputBcoDiff(bool flag) {m_outputBcoDiff = flag; }
   void set_triggeredMode(bool flag) {m_triggeredMode = flag; }
   void set_bcoFilter(bool flag) {m_bcoFilter = flag; }
+  //! store the hits in TrkrHitSetv2 (changes the hitset class written to the DST)
+  void set_flatHitSets(bool flag) {m_flatHitSets = flag; }
  private:
   InttEventInfo* intt_event_header = nullptr;
   std::string m_InttRawNodeName = "INTTRAWHIT";
@@ -72,6 +74,7 @@ class InttCombinedRawDataDecoder : public SubsysReco
   int m_inttFeeOffset = 23;   //23 is the offset for INTT in streaming mode
   bool m_outputBcoDiff = false;
   bool m_triggeredMode = false;
+  bool m_flatHitSets = false;
 
 };
 
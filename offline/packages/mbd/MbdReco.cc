@@ -61,6 +61,9 @@ int MbdReco::InitRun(PHCompositeNode *topNode)
 
   int ret = getNodes(topNode);
 
+  // no input/output nodes are declared, MbdEvent fills shared histograms and
+  // static counters, so MbdReco has to keep running serially in the Fun4AllServer
+
   m_mbdevent->SetSim(_simflag);
   m_mbdevent->InitRun();
 
@@ -42,13 +42,6 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <cstdlib>  // for exit
@@ -69,69 +62,6 @@ namespace
   }
 }  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs)
-{
-  if (GetZClustering())
-  {
-    return
-
-      // column adjacent
-      ( (MvtxDefs::getCol(lhs.first) > MvtxDefs::getCol(rhs.first)) ?
-      MvtxDefs::getCol(lhs.first)<=MvtxDefs::getCol(rhs.first)+1:
-      MvtxDefs::getCol(rhs.first)<=MvtxDefs::getCol(lhs.first)+1) &&
-
-      // row adjacent
-      ( (MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ?
-      MvtxDefs::getRow(lhs.first)<=MvtxDefs::getRow(rhs.first)+1:
-      MvtxDefs::getRow(rhs.first)<=MvtxDefs::getRow(lhs.first)+1);
-
-  } else {
-
-    return
-      // column identical
-      MvtxDefs::getCol(rhs.first)==MvtxDefs::getCol(lhs.first) &&
-
-      // row adjacent
-      ( (MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ?
-      MvtxDefs::getRow(lhs.first)<=MvtxDefs::getRow(rhs.first)+1:
-      MvtxDefs::getRow(rhs.first)<=MvtxDefs::getRow(lhs.first)+1);
-
-  }
-}
-
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs)
-{
-  if (GetZClustering())
-  {
-    return
-
-      // phi adjacent (== column)
-      ((lhs->getPhiBin() > rhs->getPhiBin()) ?
-      lhs->getPhiBin() <= rhs->getPhiBin()+1:
-      rhs->getPhiBin() <= lhs->getPhiBin()+1) &&
-
-      // time adjacent (== row)
-      ((lhs->getTBin() > rhs->getTBin()) ?
-      lhs->getTBin() <= rhs->getTBin()+1:
-      rhs->getTBin() <= lhs->getTBin()+1);
-
-  } else {
-
-    return
-
-      // phi identical (== column)
-      lhs->getPhiBin() == rhs->getPhiBin() &&
-
-      // time adjacent (== row)
-      ((lhs->getTBin() >  rhs->getTBin()) ?
-      lhs->getTBin() <= rhs->getTBin()+1:
-      rhs->getTBin() <= lhs->getTBin()+1);
-
-  }
-}
-
 MvtxClusterizer::MvtxClusterizer(const std::string &name)
   : SubsysReco(name)
 {
@@ -218,8 +148,16 @@ int MvtxClusterizer::InitRun(PHCompositeNode *topNode)
       auto newNode = new PHIODataNode<PHObject>(mClusHitsVerbose, "Trkr_SvtxClusHitsVerbose", "PHObject");
       DetNode->addNode(newNode);
     }
+    DeclareOutputNode("Trkr_SvtxClusHitsVerbose");
   }
 
+  // nodes used by process_event, for the parallel scheduling in the Fun4AllServer
+  DeclareInputNode(do_read_raw ? "TRKR_RAWHITSET" : "TRKR_HITSET");
+  DeclareInputNode("CYLINDERGEOM_MVTX");
+  DeclareOutputNode("TRKR_CLUSTER");
+  DeclareOutputNode("TRKR_CLUSTERHITASSOC");
+  DeclareOutputNode("TRKR_CLUSTERCROSSINGASSOC");
+
   //----------------
   // Report Settings
   //----------------
@@ -373,28 +311,16 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // hits are adjacent if they share an edge or a corner (z clustering)
+    // or if they are neighbours in the same column
+    std::vector<ConnectedHitLabeler::Coordinates> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      coordinates.emplace_back(MvtxDefs::getCol(hit.first), MvtxDefs::getRow(hit.first));
     }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, &component[0]);
+    std::vector<int> component;
+    m_labeler.label(coordinates, GetZClustering() ? 1 : 0, 1, component);
 
     // Loop over the components(hits) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -674,28 +600,15 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // phibin is the column, tbin the row of the pixel
+    std::vector<ConnectedHitLabeler::Coordinates> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      coordinates.emplace_back(hit->getPhiBin(), hit->getTBin());
     }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, &component[0]);
+    std::vector<int> component;
+    m_labeler.label(coordinates, GetZClustering() ? 1 : 0, 1, component);
 
     // Loop over the components(hits) compiling a list of the
     // unique connected groups (ie. clusters).
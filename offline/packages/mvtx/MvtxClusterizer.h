@@ -8,6 +8,7 @@
 #define MVTX_MVTXCLUSTERIZER_H
 
 #include <fun4all/SubsysReco.h>
+#include <trackbase/ConnectedHitLabeler.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrDefs.h>
 
@@ -65,8 +66,6 @@ class MvtxClusterizer : public SubsysReco
  private:
   // bool are_adjacent(const pixel lhs, const pixel rhs);
   bool record_ClusHitsVerbose{false};
-  bool are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs);
-  bool are_adjacent(RawHit *lhs, RawHit *rhs);
 
   void ClusterMvtx(PHCompositeNode *topNode);
   void ClusterMvtxRaw(PHCompositeNode *topNode);
@@ -79,6 +78,9 @@ class MvtxClusterizer : public SubsysReco
 
   TrkrClusterHitAssoc *m_clusterhitassoc {nullptr};
 
+  //! connected component labeling of the pixels in a chip
+  ConnectedHitLabeler m_labeler;
+
   // settings
   bool m_makeZClustering {true};  // z_clustering_option
   bool do_hit_assoc {true};
@@ -12,7 +12,7 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContMvtxHelperv1.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
-#include <trackbase/TrkrHitv2.h>
+#include <trackbase/TrkrHit.h>
 
 #include <fun4all/Fun4AllServer.h>
 
@@ -106,6 +106,15 @@ void MvtxCombinedRawDataDecoder::CreateNodes(PHCompositeNode *topNode)
     trkrNode->addNode(newNode);
   }
 
+  // flat TrkrHitSetv2 storage for the MVTX hitsets, see TrkrHitSetContainerv1
+  if (m_useFlatHitSets)
+  {
+    if (auto *flat_container = dynamic_cast<TrkrHitSetContainerv1 *>(hit_set_container))
+    {
+      flat_container->setFlatHitSets(true);
+    }
+  }
+
   // Check if MVTX event header already exists
   auto *mvtxNode = dynamic_cast<PHCompositeNode *>(
       iter.findFirst("PHCompositeNode", "MVTX"));
@@ -351,14 +360,12 @@ int MvtxCombinedRawDataDecoder::process_event(PHCompositeNode *topNode)
     {
       if (!m_hot_pixel_mask->is_masked(mvtx_rawhit))
       {  // Check if the pixel is masked
-        hit = new TrkrHitv2;
-        hitset_it->second->addHitSpecificKey(hitkey, hit);
+        hitset_it->second->findOrAddHit(hitkey);
       }
     }
     else
     {
-      hit = new TrkrHitv2;
-      hitset_it->second->addHitSpecificKey(hitkey, hit);
+      hitset_it->second->findOrAddHit(hitkey);
     }
   }
 
@@ -58,6 +58,9 @@ class MvtxCombinedRawDataDecoder : public SubsysReco
   void SetStrobeWidth(const float val) { m_strobeWidth = val; }
   float GetStrobeWidth() const { return m_strobeWidth; }
 
+  //! store the hits in TrkrHitSetv2 (changes the hitset class written to the DST)
+  void SetFlatHitSets(const bool val) { m_useFlatHitSets = val; }
+
  private:
   // static void removeDuplicates(std::vector<std::pair<uint64_t, uint32_t>>& v);
   void CreateNodes(PHCompositeNode*);
@@ -83,6 +86,8 @@ class MvtxCombinedRawDataDecoder : public SubsysReco
   MvtxPixelMask* m_hot_pixel_mask{nullptr};
 
   bool m_mvtx_is_triggered{false};
+
+  bool m_useFlatHitSets{false};
 };
 
 #endif
\ No newline at end of file
@@ -14,7 +14,7 @@
 #include <trackbase/TrkrDefs.h>  // for hitkey, getLayer
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
-#include <trackbase/TrkrHitv2.h>
+#include <trackbase/TrkrHit.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>  // for SubsysReco
@@ -181,9 +181,7 @@ int MvtxHitPruner::process_event(PHCompositeNode *topNode)
             << hitkey << std::endl;
         }
 
-        auto new_hit = new TrkrHitv2;
-        new_hit->CopyFrom(old_hit);
-        bare_hitset->addHitSpecificKey(hitkey, new_hit);
+        bare_hitset->findOrAddHit(hitkey)->CopyFrom(old_hit);
       }
 
       // all hits are copied over to the strobe zero hitset, remove this
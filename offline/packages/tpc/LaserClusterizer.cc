@@ -784,13 +784,6 @@ namespace
 
     }
   }
-
-  void *ProcessModule(void *threadarg)
-  {
-    auto my_data = static_cast<thread_data *>(threadarg);
-    ProcessModuleData(my_data);
-    pthread_exit(nullptr);
-  }
 } //namespace
 
 LaserClusterizer::LaserClusterizer(const std::string &name)
@@ -847,6 +840,12 @@ int LaserClusterizer::InitRun(PHCompositeNode *topNode)
   AdcClockPeriod = m_geom_container->GetFirstLayerCellGeom()->get_zstep();
   m_tdriftmax = AdcClockPeriod * NZBinsSide;
 
+  // worker threads for module processing
+  if (!m_do_sequential && !m_threadPool)
+  {
+    m_threadPool = std::make_unique<TrkrThreadPool>(m_nthreads);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -923,19 +922,9 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
   TrkrHitSetContainer::ConstRange hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);;
   
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  std::vector<thread_pair_t> threads;
+  std::vector<thread_data> threads;
   threads.reserve(72);
 
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
   {
     std::cout << std::endl << " mutex init failed" << std::endl;
@@ -954,7 +943,7 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
           std::cout << "making thread for side: " << s << "   sector: " << sec << "   module: " << mod << std::endl;
         }
 
-	      thread_pair_t &thread_pair = threads.emplace_back();
+	      thread_data &data = threads.emplace_back();
 
 	      std::vector<TrkrHitSet *> hitsets;
 	      std::vector<unsigned int> layers;
@@ -985,77 +974,53 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 	  
       	}
 
-	      thread_pair.data.geom_container = m_geom_container;
-	      thread_pair.data.tGeometry = m_tGeometry;
-	      thread_pair.data.hitsets = hitsets;
-	      thread_pair.data.layers = layers;
-	      thread_pair.data.side = (bool)s;
-	      thread_pair.data.sector = sec;
-        thread_pair.data.module = mod;
-	      thread_pair.data.cluster_vector = cluster_vector;
-	      thread_pair.data.cluster_key_vector = cluster_key_vector;
-	      thread_pair.data.adc_threshold = m_adc_threshold;
-	      thread_pair.data.peakTimeBin = m_laserEventInfo->getPeakSample(s);
-	      thread_pair.data.layerMin = 3;
-	      thread_pair.data.layerMax = 3;
-	      thread_pair.data.tdriftmax = m_tdriftmax;
-        thread_pair.data.eventNum = m_event;
-        thread_pair.data.Verbosity = Verbosity();
-        thread_pair.data.hitHist = nullptr;
-        thread_pair.data.doFitting = m_do_fitting;
-
-	      int rc;
-	      rc = pthread_create(&thread_pair.thread, &attr, ProcessModule, (void *) &thread_pair.data);
-
-	      if (rc)
-	      {
-	        std::cout << "Error:unable to create thread," << rc << std::endl;
-	      }
+	      data.geom_container = m_geom_container;
+	      data.tGeometry = m_tGeometry;
+	      data.hitsets = hitsets;
+	      data.layers = layers;
+	      data.side = (bool)s;
+	      data.sector = sec;
+        data.module = mod;
+	      data.cluster_vector = cluster_vector;
+	      data.cluster_key_vector = cluster_key_vector;
+	      data.adc_threshold = m_adc_threshold;
+	      data.peakTimeBin = m_laserEventInfo->getPeakSample(s);
+	      data.layerMin = 3;
+	      data.layerMax = 3;
+	      data.tdriftmax = m_tdriftmax;
+        data.eventNum = m_event;
+        data.Verbosity = Verbosity();
+        data.hitHist = nullptr;
+        data.doFitting = m_do_fitting;
+      }
+    }
+  }
 
-	      if (m_do_sequential)
-	      {
-	        //wait for termination of thread
-	        int rc2 = pthread_join(thread_pair.thread, nullptr);
-	        if (rc2)
-	        {
-	          std::cout << "Error:unable to join," << rc2 << std::endl;
-	        }
+  // process modules, on the worker pool unless sequential processing is required
+  const auto process_module = [&threads](unsigned int index, unsigned int /*worker*/)
+  { ProcessModuleData(&threads[index]); };
 
-      	  //add clusters from thread to laserClusterContainer
-	        const auto &data(thread_pair.data);
-	        for(int index = 0; index < (int) data.cluster_vector.size(); ++index)
-	        {
-	          auto cluster = data.cluster_vector[index];
-	          const auto ckey = data.cluster_key_vector[index];
-	    
-      	    m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-	        }
-	      }
-      }
+  if (m_do_sequential || !m_threadPool)
+  {
+    for (unsigned int index = 0; index < threads.size(); ++index)
+    {
+      process_module(index, 0);
     }
   }
-  
-  pthread_attr_destroy(&attr);
+  else
+  {
+    m_threadPool->run(threads.size(), process_module);
+  }
 
-  if (!m_do_sequential)
+  // add clusters from all modules to laserClusterContainer in one pass
+  for (const auto &data : threads)
   {
-    for (const auto & thread_pair : threads)
+    for (int index = 0; index < (int) data.cluster_vector.size(); ++index)
     {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-	      std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
-      
-      //const auto &data(thread_pair.data);
-      
-      for(int index = 0; index < (int) thread_pair.data.cluster_vector.size(); ++index)
-      {
-	      auto cluster = thread_pair.data.cluster_vector[index];
-	      const auto ckey = thread_pair.data.cluster_key_vector[index];
-	
-	      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-      }
+      auto cluster = data.cluster_vector[index];
+      const auto ckey = data.cluster_key_vector[index];
+
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
     }
   }
 
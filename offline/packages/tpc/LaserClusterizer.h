@@ -6,6 +6,7 @@
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrThreadPool.h>
 
 
 // BOOST for combi seeding
@@ -15,6 +16,7 @@
 #include <boost/geometry/index/rtree.hpp>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -46,6 +48,8 @@ class LaserClusterizer : public SubsysReco
   void set_max_time_samples(int val) { m_time_samples_max = val; }
   void set_lamination(bool val) { m_lamination = val; }
   void set_do_sequential(bool val) { m_do_sequential = val; }
+  //! number of worker threads used to process modules. 0 means one per hardware thread
+  void set_num_threads(unsigned int val) { m_nthreads = val; }
   void set_do_fitting(bool val) { m_do_fitting = val; }
 
  private:
@@ -69,6 +73,10 @@ class LaserClusterizer : public SubsysReco
   bool m_do_sequential {false};
 
   bool m_do_fitting {true};
+
+  //! worker threads, created at InitRun and kept for all events
+  unsigned int m_nthreads {0};
+  std::unique_ptr<TrkrThreadPool> m_threadPool;
   
   double m_tdriftmax {0};
   double AdcClockPeriod {53.0};  // ns
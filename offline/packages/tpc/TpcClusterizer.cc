@@ -58,8 +58,6 @@
 #include <string>
 #include <utility>  // for pair
 #include <vector>
-// Terra incognita....
-#include <pthread.h>
 
 namespace
 {
@@ -128,8 +126,6 @@ namespace
     vec_dVerbose zvec_ClusHitsVerbose;    // only fill if fillClusHitsVerbose
   };
 
-  pthread_mutex_t mythreadlock;
-
   void remove_hit(double adc, int phibin, int tbin, int edge, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
   {
     using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
@@ -1074,13 +1070,6 @@ namespace
                 << std::endl;
     }
     */
-    // pthread_exit(nullptr);
-  }
-  void *ProcessSector(void *threadarg)
-  {
-    auto my_data = static_cast<thread_data *>(threadarg);
-    ProcessSectorData(my_data);
-    pthread_exit(nullptr);
   }
 }  // namespace
 
@@ -1239,6 +1228,16 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
   
   AdcClockPeriod = geom->GetFirstLayerCellGeom()->get_zstep();
 
+  // worker threads for hitset processing
+  if (!do_sequential && !m_threadPool)
+  {
+    m_threadPool = std::make_unique<TrkrThreadPool>(m_nthreads);
+    if (Verbosity())
+    {
+      std::cout << "TpcClusterizer::InitRun - using " << m_threadPool->nthreads() << " worker threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -1351,29 +1350,10 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
     num_hitsets = std::distance(rawhitsetrange.first, rawhitsetrange.second);
   }
 
-  // create structure to store given thread and associated data
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
+  // create vector of thread data and reserve the right size upfront to avoid reallocation
+  std::vector<thread_data> threads;
   threads.reserve(num_hitsets);
 
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    std::cout << std::endl
-              << " mutex init failed" << std::endl;
-    return 1;
-  }
-//  int count = 0;
-
   if (!do_read_raw)
   {
     for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
@@ -1387,35 +1367,35 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
+      // instanciate new thread data, at the end of thread vector
+      thread_data &data = threads.emplace_back();
       if (mClusHitsVerbose)
       {
-        thread_pair.data.fillClusHitsVerbose = true;
-      };
-
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = hitset;
-      thread_pair.data.rawhitset = nullptr;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.seed_threshold = seed_threshold;
-      thread_pair.data.edge_threshold = edge_threshold;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.do_singles = do_singles;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
-      thread_pair.data.do_split = do_split;
-      thread_pair.data.FixedWindow = do_fixed_window;
-      thread_pair.data.min_err_squared = min_err_squared;
-      thread_pair.data.min_clus_size = min_clus_size;
-      thread_pair.data.min_adc_sum = min_adc_sum;
+        data.fillClusHitsVerbose = true;
+      }
+
+      data.layergeom = layergeom;
+      data.hitset = hitset;
+      data.rawhitset = nullptr;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.seed_threshold = seed_threshold;
+      data.edge_threshold = edge_threshold;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.do_singles = do_singles;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
+      data.do_split = do_split;
+      data.FixedWindow = do_fixed_window;
+      data.min_err_squared = min_err_squared;
+      data.min_clus_size = min_clus_size;
+      data.min_adc_sum = min_adc_sum;
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
       unsigned short NTBins = 0;
@@ -1433,73 +1413,17 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
+      data.m_tdriftmax = m_tdriftmax;
 
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
 
-      thread_pair.data.radius = layergeom->get_radius();
-      thread_pair.data.drift_velocity = m_tGeometry->get_drift_velocity();
-      thread_pair.data.pads_per_sector = 0;
-      thread_pair.data.phistep = 0;
-      int rc;
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-
-          if (mClusHitsVerbose)
-          {
-            for (auto &hit : data.phivec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addPhiHit(hit.first, hit.second);
-            }
-            for (auto &hit : data.zvec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addZHit(hit.first, hit.second);
-            }
-            mClusHitsVerbose->push_hits(ckey);
-          }
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-//      count++;
+      data.radius = layergeom->get_radius();
+      data.drift_velocity = m_tGeometry->get_drift_velocity();
+      data.pads_per_sector = 0;
+      data.phistep = 0;
     }
   }
   else
@@ -1518,23 +1442,23 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
-
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = nullptr;
-      thread_pair.data.rawhitset = hitset;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
+      // instanciate new thread data, at the end of thread vector
+      thread_data &data = threads.emplace_back();
+
+      data.layergeom = layergeom;
+      data.hitset = nullptr;
+      data.rawhitset = hitset;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1545,12 +1469,12 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
+      data.m_tdriftmax = m_tdriftmax;
 
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
 
       /*
       PHG4TpcCylinderGeom *testlayergeom = geom_container->GetLayerCellGeom(32);
@@ -1575,121 +1499,78 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       }
       continue;
       */
-      int rc = 0;
-      //      if(layer==32)
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-      //      else
-      // continue;
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-//      count++;
     }
   }
 
-  pthread_attr_destroy(&attr);
-//  count = 0;
-  // wait for completion of all threads
-  if (!do_sequential)
+  // process hitsets, on the worker pool unless sequential processing is required
+  const auto process_hitset = [&threads](unsigned int index, unsigned int /*worker*/)
+  { ProcessSectorData(&threads[index]); };
+
+  if (do_sequential || !m_threadPool)
   {
-    for (const auto &thread_pair : threads)
+    for (unsigned int index = 0; index < threads.size(); ++index)
     {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-        std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
+      process_hitset(index, 0);
+    }
+  }
+  else
+  {
+    m_threadPool->run(threads.size(), process_hitset);
+  }
 
-      // get the hitsetkey from thread data
-      const auto &data(thread_pair.data);
-      const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
+  // copy the output of all hitsets to the node tree in one pass
+  for (const auto &data : threads)
+  {
+    // get the hitsetkey from thread data
+    const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
-      // copy clusters to map
-      for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy clusters to map
+    for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // get cluster
-        auto cluster = data.cluster_vector[index];
+      // get cluster
+      auto cluster = data.cluster_vector[index];
 
-        // insert in map
-        // std::cout << "X: " << cluster->getLocalX() << "Y: " << cluster->getLocalY() << std::endl;
-        m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      // insert in map
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
 
-        if (mClusHitsVerbose)
+      if (mClusHitsVerbose && data.fillClusHitsVerbose)
+      {
+        for (auto &hit : data.phivec_ClusHitsVerbose[index])
         {
-          for (auto &hit : data.phivec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
-          }
-          for (auto &hit : data.zvec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
-          }
-          mClusHitsVerbose->push_hits(ckey);
+          mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
         }
+        for (auto &hit : data.zvec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
+        }
+        mClusHitsVerbose->push_hits(ckey);
       }
+    }
 
-      // copy hit associations to map
-      for (const auto &[index, hkey] : thread_pair.data.association_vector)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy hit associations to map
+    for (const auto &[index, hkey] : data.association_vector)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // add to association table
-        m_clusterhitassoc->addAssoc(ckey, hkey);
-      }
+      // add to association table
+      m_clusterhitassoc->addAssoc(ckey, hkey);
+    }
 
-      for (auto v_hit : thread_pair.data.v_hits)
+    for (auto v_hit : data.v_hits)
+    {
+      if (_store_hits)
       {
-        if (_store_hits)
-        {
-          m_training->v_hits.emplace_back(*v_hit);
-        }
-        delete v_hit;
+        m_training->v_hits.emplace_back(*v_hit);
       }
+      delete v_hit;
     }
   }
 
+
   // set the flag to use alignment transformations, needed by the rest of reconstruction
   alignmentTransformationContainer::use_alignment = true;
 
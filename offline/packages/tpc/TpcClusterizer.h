@@ -4,8 +4,10 @@
 #include <fun4all/SubsysReco.h>
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrThreadPool.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,6 +41,8 @@ public:
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  //! number of worker threads used to process hitsets. 0 means one per hardware thread
+  void set_num_threads(unsigned int n) { m_nthreads = n; }
   void set_do_split(bool split) { do_split = split; }
   void set_fixed_window(int fixed) { do_fixed_window = fixed; }
   void set_pedestal(float val) { pedestal = val; }
@@ -111,6 +115,10 @@ public:
   double m_sampa_tbias = 39.6;  // ns
 
   TrainingHitsContainer *m_training;
+
+  //! worker threads, created at InitRun and kept for all events
+  unsigned int m_nthreads = 0;
+  std::unique_ptr<TrkrThreadPool> m_threadPool;
 };
 
 #endif
@@ -8,6 +8,8 @@
 #include "TpcDistortionCorrectionContainer.h"
 
 #include <TH1.h>
+
+#include <array>
 #include <cmath>
 
 #include <iostream>
@@ -82,8 +84,35 @@ Acts::Vector3 TpcDistortionCorrection::get_corrected_position(const Acts::Vector
   dr=0;
   dz=0;
   
-  //get the corrections from the histograms
-  if (dcc->m_dimensions == 3)
+  // get the corrections from the flat map if available, histograms otherwise
+  const auto& map = dcc->m_map[index];
+  if (map.valid())
+  {
+    std::array<double, 3> corrections = {{0, 0, 0}};
+    if (map.interpolate(phi, r, z, corrections))
+    {
+      // 2D corrections are scaled with z, as for histograms
+      double zterm = 1.0;
+      if (map.dimension() == 2 && dcc->m_interpolate_z)
+      {
+        zterm = (1. - std::abs(z) / 105.5);
+      }
+
+      if (mask & COORD_PHI)
+      {
+        dphi = corrections[TpcDistortionCorrectionMap::DPHI] * zterm / divisor;
+      }
+      if (mask & COORD_R)
+      {
+        dr = corrections[TpcDistortionCorrectionMap::DR] * zterm;
+      }
+      if (mask & COORD_Z)
+      {
+        dz = corrections[TpcDistortionCorrectionMap::DZ] * zterm;
+      }
+    }
+  }
+  else if (dcc->m_dimensions == 3)
   {
     if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r, z))
     {
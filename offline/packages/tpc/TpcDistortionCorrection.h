@@ -42,6 +42,7 @@ class TpcDistortionCorrection
   };
 
   //! get cluster corrected 3D position using given DistortionCorrectionObject
+  /*! const and thread safe when the container holds valid flat maps, which is the case for corrections loaded from file */
   Acts::Vector3 get_corrected_position(const Acts::Vector3&, const TpcDistortionCorrectionContainer*,
                                        unsigned int mask = COORD_ALL) const;
 
@@ -7,6 +7,8 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "TpcDistortionCorrectionMap.h"
+
 #include <array>
 
 class TH1;
@@ -41,6 +43,13 @@ class TpcDistortionCorrectionContainer
    */
   std::array<TH1*, 2> m_hentries = {{nullptr, nullptr}};
   //@}
+
+  //! flat copy of the histograms, one per side, used instead of the histograms when valid
+  /**
+   * it is filled by TpcLoadDistortionCorrection once the histograms are read,
+   * and must be refilled (or cleared) if the histograms are modified afterwards
+   */
+  std::array<TpcDistortionCorrectionMap, 2> m_map;
 };
 
 #endif
@@ -0,0 +1,225 @@
+/*!
+ * \file TpcDistortionCorrectionMap.cc
+ * \brief flat (phi, r, z) grid holding the three distortion correction components of one TPC side
+ */
+
+#include "TpcDistortionCorrectionMap.h"
+
+#include <TAxis.h>
+#include <TH1.h>
+
+#include <algorithm>
+#include <iostream>
+
+//________________________________________________________
+void TpcDistortionCorrectionMap::Axis::fill(const TAxis* axis)
+{
+  nbins = axis->GetNbins();
+  min = axis->GetXmin();
+  max = axis->GetXmax();
+  uniform = !axis->IsVariableBinSize();
+  edges.resize(nbins + 1);
+  centers.resize(nbins);
+  for (int i = 0; i < nbins; ++i)
+  {
+    edges[i] = axis->GetBinLowEdge(i + 1);
+    centers[i] = axis->GetBinCenter(i + 1);
+  }
+  edges[nbins] = axis->GetBinUpEdge(nbins);
+}
+
+//________________________________________________________
+int TpcDistortionCorrectionMap::Axis::find_bin(double value) const
+{
+  // also catches NaN
+  if (!(value >= min))
+  {
+    return 0;
+  }
+  if (value >= max)
+  {
+    return nbins + 1;
+  }
+  if (uniform)
+  {
+    return 1 + static_cast<int>(nbins * (value - min) / (max - min));
+  }
+  return std::upper_bound(edges.begin(), edges.end(), value) - edges.begin();
+}
+
+//________________________________________________________
+bool TpcDistortionCorrectionMap::find_cell(const Axis& axis, double value, int& lower, double& fraction)
+{
+  // same boundaries as for the histogram based correction
+  const int bin = axis.find_bin(value);
+  if (bin < 2 || bin >= axis.nbins)
+  {
+    return false;
+  }
+
+  // interpolate between the centers of the two bins surrounding the value
+  lower = (value < axis.centers[bin - 1]) ? bin - 2 : bin - 1;
+  fraction = (value - axis.centers[lower]) / (axis.centers[lower + 1] - axis.centers[lower]);
+  return true;
+}
+
+//________________________________________________________
+bool TpcDistortionCorrectionMap::fill(const TH1* h_dphi, const TH1* h_dr, const TH1* h_dz)
+{
+  m_data.clear();
+
+  const std::array<const TH1*, 3> histograms = {{h_dphi, h_dr, h_dz}};
+
+  // binning is taken from the first valid histogram
+  const TH1* reference = nullptr;
+  for (const auto& h : histograms)
+  {
+    if (h)
+    {
+      reference = h;
+      break;
+    }
+  }
+
+  if (!reference)
+  {
+    return false;
+  }
+
+  m_dimension = reference->GetDimension();
+  if (m_dimension != 2 && m_dimension != 3)
+  {
+    std::cout << "TpcDistortionCorrectionMap::fill - unsupported dimension " << m_dimension << std::endl;
+    return false;
+  }
+
+  m_phi.fill(reference->GetXaxis());
+  m_r.fill(reference->GetYaxis());
+  if (m_dimension == 3)
+  {
+    m_z.fill(reference->GetZaxis());
+  }
+  else
+  {
+    // single z bin, never checked nor interpolated
+    m_z = Axis();
+    m_z.nbins = 1;
+  }
+
+  // all histograms must share the same binning
+  for (const auto& h : histograms)
+  {
+    if (!h || h == reference)
+    {
+      continue;
+    }
+
+    Axis phi;
+    Axis r;
+    phi.fill(h->GetXaxis());
+    r.fill(h->GetYaxis());
+    bool same = h->GetDimension() == m_dimension && phi == m_phi && r == m_r;
+    if (same && m_dimension == 3)
+    {
+      Axis z;
+      z.fill(h->GetZaxis());
+      same = (z == m_z);
+    }
+
+    if (!same)
+    {
+      std::cout << "TpcDistortionCorrectionMap::fill - " << h->GetName() << " and " << reference->GetName() << " have different binning" << std::endl;
+      return false;
+    }
+  }
+
+  // copy contents
+  m_data.assign(3 * static_cast<size_t>(m_phi.nbins) * m_r.nbins * m_z.nbins, 0);
+  for (int ic = 0; ic < 3; ++ic)
+  {
+    const auto& h = histograms[ic];
+    m_has_component[ic] = (h != nullptr);
+    if (!h)
+    {
+      continue;
+    }
+
+    for (int iphi = 0; iphi < m_phi.nbins; ++iphi)
+    {
+      for (int ir = 0; ir < m_r.nbins; ++ir)
+      {
+        for (int iz = 0; iz < m_z.nbins; ++iz)
+        {
+          const auto bin = (m_dimension == 3) ? h->GetBin(iphi + 1, ir + 1, iz + 1) : h->GetBin(iphi + 1, ir + 1);
+          m_data[index(iphi, ir, iz) + ic] = h->GetBinContent(bin);
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+//________________________________________________________
+bool TpcDistortionCorrectionMap::interpolate(double phi, double r, double z, std::array<double, 3>& corrections) const
+{
+  if (m_data.empty())
+  {
+    return false;
+  }
+
+  int iphi = 0;
+  int ir = 0;
+  int iz = 0;
+  double fphi = 0;
+  double fr = 0;
+  double fz = 0;
+  if (!(find_cell(m_phi, phi, iphi, fphi) && find_cell(m_r, r, ir, fr)))
+  {
+    return false;
+  }
+
+  if (m_dimension == 3)
+  {
+    if (!find_cell(m_z, z, iz, fz))
+    {
+      return false;
+    }
+
+    // trilinear interpolation of the three components
+    const double* c000 = &m_data[index(iphi, ir, iz)];
+    const double* c001 = c000 + 3;
+    const double* c010 = &m_data[index(iphi, ir + 1, iz)];
+    const double* c011 = c010 + 3;
+    const double* c100 = &m_data[index(iphi + 1, ir, iz)];
+    const double* c101 = c100 + 3;
+    const double* c110 = &m_data[index(iphi + 1, ir + 1, iz)];
+    const double* c111 = c110 + 3;
+    for (int ic = 0; ic < 3; ++ic)
+    {
+      const double v00 = c000[ic] * (1 - fz) + c001[ic] * fz;
+      const double v01 = c010[ic] * (1 - fz) + c011[ic] * fz;
+      const double v10 = c100[ic] * (1 - fz) + c101[ic] * fz;
+      const double v11 = c110[ic] * (1 - fz) + c111[ic] * fz;
+      const double v0 = v00 * (1 - fr) + v01 * fr;
+      const double v1 = v10 * (1 - fr) + v11 * fr;
+      corrections[ic] = v0 * (1 - fphi) + v1 * fphi;
+    }
+  }
+  else
+  {
+    // bilinear interpolation of the three components
+    const double* c00 = &m_data[index(iphi, ir, 0)];
+    const double* c01 = &m_data[index(iphi, ir + 1, 0)];
+    const double* c10 = &m_data[index(iphi + 1, ir, 0)];
+    const double* c11 = &m_data[index(iphi + 1, ir + 1, 0)];
+    for (int ic = 0; ic < 3; ++ic)
+    {
+      const double v0 = c00[ic] * (1 - fr) + c01[ic] * fr;
+      const double v1 = c10[ic] * (1 - fr) + c11[ic] * fr;
+      corrections[ic] = v0 * (1 - fphi) + v1 * fphi;
+    }
+  }
+
+  return true;
+}
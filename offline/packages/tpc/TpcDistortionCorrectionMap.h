@@ -0,0 +1,120 @@
+#ifndef TPC_TPCDISTORTIONCORRECTIONMAP_H
+#define TPC_TPCDISTORTIONCORRECTIONMAP_H
+
+/*!
+ * \file TpcDistortionCorrectionMap.h
+ * \brief flat (phi, r, z) grid holding the three distortion correction components of one TPC side
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class TAxis;
+class TH1;
+
+/*!
+ * The dphi, dr and dz histograms of one side are copied into a single array,
+ * the three components of a bin being stored next to each other,
+ * so that one cell lookup gives all three corrections.
+ * The interpolation reproduces TH3::Interpolate (resp. TH2::Interpolate for 2D maps),
+ * it only reads the copied data, and can therefore be called concurrently from several threads.
+ */
+class TpcDistortionCorrectionMap
+{
+ public:
+  //! constructor
+  TpcDistortionCorrectionMap() = default;
+
+  //! component index in the returned corrections
+  enum Component
+  {
+    DPHI = 0,
+    DR = 1,
+    DZ = 2
+  };
+
+  //! fill from histograms
+  /*!
+   * missing histograms give zero corrections.
+   * returns false if the histograms do not share the same binning, in which case the map is left empty
+   */
+  bool fill(const TH1* h_dphi, const TH1* h_dr, const TH1* h_dz);
+
+  //! true if the map was filled
+  bool valid() const
+  {
+    return !m_data.empty();
+  }
+
+  //! map dimension (2 or 3)
+  int dimension() const
+  {
+    return m_dimension;
+  }
+
+  //! true if the component was available when filling the map
+  bool has_component(Component i) const
+  {
+    return m_has_component[i];
+  }
+
+  //! interpolated corrections at a given position
+  /*!
+   * returns false, and leaves the corrections untouched,
+   * if the point is outside of the range where interpolation is possible,
+   * that is in the first or last bin of any axis, like the histogram based boundary check.
+   * z is ignored for 2D maps
+   */
+  bool interpolate(double phi, double r, double z, std::array<double, 3>& corrections) const;
+
+ private:
+  //! one axis of the grid
+  struct Axis
+  {
+    //! copy bin edges and centers from TAxis
+    void fill(const TAxis*);
+
+    //! same as TAxis::FindFixBin
+    int find_bin(double value) const;
+
+    //! compare binning
+    bool operator==(const Axis& other) const
+    {
+      return nbins == other.nbins && edges == other.edges;
+    }
+
+    int nbins = 0;
+    double min = 0;
+    double max = 0;
+    bool uniform = true;
+
+    //! bin edges, nbins+1 values
+    std::vector<double> edges;
+
+    //! bin centers, nbins values, index 0 corresponding to bin 1
+    std::vector<double> centers;
+  };
+
+  //! find lower interpolation bin (0-based) and fraction along an axis
+  /*! returns false if the value is in the first or last bin, or outside of the axis */
+  static bool find_cell(const Axis&, double value, int& lower, double& fraction);
+
+  //! index of the first component of bin (iphi, ir, iz), 0-based
+  size_t index(int iphi, int ir, int iz) const
+  {
+    return 3 * ((static_cast<size_t>(iphi) * m_r.nbins + ir) * m_z.nbins + iz);
+  }
+
+  int m_dimension = 0;
+  Axis m_phi;
+  Axis m_r;
+  Axis m_z;
+
+  std::array<bool, 3> m_has_component = {{false, false, false}};
+
+  //! interleaved (dphi, dr, dz) for each bin, z running fastest
+  std::vector<double> m_data;
+};
+
+#endif
@@ -82,6 +82,17 @@ Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(con
     return {0,0,0};
   }
 
+  // check cache, only filled for TPC clusters with valid crossing
+  if (m_use_cluster_cache)
+  {
+    std::lock_guard<std::mutex> lock(m_cluster_cache_mutex);
+    const auto iter = m_cluster_cache.find(key);
+    if (iter != m_cluster_cache.end() && iter->second.first == crossing)
+    {
+      return iter->second.second;
+    }
+  }
+
   // get global position from acts
   Acts::Vector3 global = m_tGeometry->getGlobalPosition(key, cluster);
 
@@ -104,7 +115,20 @@ Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(con
 
     // apply distortion corrections
     global = applyDistortionCorrections(global);
+
+    if (m_use_cluster_cache)
+    {
+      std::lock_guard<std::mutex> lock(m_cluster_cache_mutex);
+      m_cluster_cache[key] = std::make_pair(crossing, global);
+    }
   }
 
   return global;
 }
+
+//____________________________________________________________________________________________________________________
+void TpcGlobalPositionWrapper::clear_cluster_cache()
+{
+  std::lock_guard<std::mutex> lock(m_cluster_cache_mutex);
+  m_cluster_cache.clear();
+}
@@ -10,6 +10,9 @@
 
 #include <trackbase/TrkrDefs.h>
 
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 class ActsGeometry;
 class PHCompositeNode;
@@ -58,6 +61,20 @@ class TpcGlobalPositionWrapper
    */
   Acts::Vector3 getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey&, TrkrCluster*, short int /*crossing*/ ) const;
 
+  //! cache distortion corrected positions of TPC clusters, keyed by cluster key
+  /**
+   * the cache is meant for one event: it must be cleared with clear_cluster_cache
+   * at the beginning of each event, by the module using the wrapper.
+   * It is protected by a mutex and can be used from several threads
+   */
+  void set_use_cluster_cache(bool value)
+  {
+    m_use_cluster_cache = value;
+  }
+
+  //! clear cached cluster positions
+  void clear_cluster_cache();
+
   private:
 
   //! verbosity
@@ -65,6 +82,15 @@ class TpcGlobalPositionWrapper
 
   bool m_suppressCrossing = false;
 
+  //! true if distortion corrected positions are cached
+  bool m_use_cluster_cache = false;
+
+  //! cached positions and the crossing they were calculated for
+  mutable std::unordered_map<TrkrDefs::cluskey, std::pair<short int, Acts::Vector3>> m_cluster_cache;
+
+  //! protects the cache
+  mutable std::mutex m_cluster_cache_mutex;
+
   //! distortion correction interface
   TpcDistortionCorrection m_distortionCorrection;
 
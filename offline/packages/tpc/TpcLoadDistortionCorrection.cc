@@ -108,6 +108,18 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
     // only dimensions 2 or 3 are supported
     assert(distortion_correction_object->m_dimensions == 2 || distortion_correction_object->m_dimensions == 3);
 
+    // copy histograms into flat maps, used for the actual corrections
+    for (int j = 0; j < 2; ++j)
+    {
+      if (!distortion_correction_object->m_map[j].fill(
+              distortion_correction_object->m_hDPint[j],
+              distortion_correction_object->m_hDRint[j],
+              distortion_correction_object->m_hDZint[j]))
+      {
+        std::cout << "TpcLoadDistortionCorrection::InitRun - could not fill flat map for side " << j << ", using histograms" << std::endl;
+      }
+    }
+
     // assign whether phi corrections (DP) should be read as radians or mm
     distortion_correction_object->m_phi_hist_in_radians = m_phi_hist_in_radians[i];
 
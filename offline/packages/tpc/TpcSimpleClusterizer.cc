@@ -40,8 +40,6 @@
 #include <string>
 #include <utility>  // for pair
 #include <vector>
-// Terra incognita....
-#include <pthread.h>
 
 namespace
 {
@@ -75,8 +73,6 @@ namespace
     std::vector<TrkrCluster *> cluster_vector;
   };
 
-  pthread_mutex_t mythreadlock;
-
   void remove_hit(double adc, int phibin, int zbin, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
   {
     using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
@@ -278,10 +274,8 @@ namespace
     }
   }
 
-  void *ProcessSector(void *threadarg)
+  void ProcessSector(thread_data *my_data)
   {
-    auto my_data = (struct thread_data *) threadarg;
-
     const auto &pedestal = my_data->pedestal;
     const auto &phibins = my_data->phibins;
     const auto &phioffset = my_data->phioffset;
@@ -360,7 +354,6 @@ namespace
       calc_cluster_parameter(ihit_list, *my_data);
       remove_hits(ihit_list, all_hit_map, adcval);
     }
-    pthread_exit(nullptr);
   }
 }  // namespace
 
@@ -448,6 +441,12 @@ int TpcSimpleClusterizer::InitRun(PHCompositeNode *topNode)
     DetNode->addNode(newNode);
   }
 
+  // worker threads for hitset processing
+  if (!m_threadPool)
+  {
+    m_threadPool = std::make_unique<TrkrThreadPool>(m_nthreads);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -517,27 +516,10 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
   TrkrHitSetContainer::ConstRange hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);
   const int num_hitsets = std::distance(hitsetrange.first, hitsetrange.second);
 
-  // create structure to store given thread and associated data
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
+  // create vector of thread data and reserve the right size upfront to avoid reallocation
+  std::vector<thread_data> threads;
   threads.reserve(num_hitsets);
 
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    std::cout << std::endl << " mutex init failed" << std::endl;
-    return 1;
-  }
-
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second;
        ++hitsetitr)
@@ -548,19 +530,19 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
     unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
     PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-    // instanciate new thread pair, at the end of thread vector
-    thread_pair_t &thread_pair = threads.emplace_back();
+    // instanciate new thread data, at the end of thread vector
+    thread_data &data = threads.emplace_back();
 
-    thread_pair.data.layergeom = layergeom;
-    thread_pair.data.hitset = hitset;
-    thread_pair.data.layer = layer;
-    thread_pair.data.pedestal = pedestal;
-    thread_pair.data.sector = sector;
-    thread_pair.data.side = side;
-    thread_pair.data.do_assoc = do_hit_assoc;
-    thread_pair.data.tGeometry = m_tGeometry;
-    thread_pair.data.par0_neg = par0_neg;
-    thread_pair.data.par0_pos = par0_pos;
+    data.layergeom = layergeom;
+    data.hitset = hitset;
+    data.layer = layer;
+    data.pedestal = pedestal;
+    data.sector = sector;
+    data.side = side;
+    data.do_assoc = do_hit_assoc;
+    data.tGeometry = m_tGeometry;
+    data.par0_neg = par0_neg;
+    data.par0_pos = par0_pos;
 
     unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
     unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -580,31 +562,20 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
 
     unsigned short ZOffset = NZBinsMin;
 
-    thread_pair.data.phibins = NPhiBinsSector;
-    thread_pair.data.phioffset = PhiOffset;
-    thread_pair.data.zbins = NZBinsSide;
-    thread_pair.data.zoffset = ZOffset;
-
-    int rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-    if (rc)
-    {
-      std::cout << "Error:unable to create thread," << rc << std::endl;
-    }
+    data.phibins = NPhiBinsSector;
+    data.phioffset = PhiOffset;
+    data.zbins = NZBinsSide;
+    data.zoffset = ZOffset;
   }
 
-  pthread_attr_destroy(&attr);
+  // process hitsets on the worker pool
+  m_threadPool->run(threads.size(), [&threads](unsigned int index, unsigned int /*worker*/)
+                    { ProcessSector(&threads[index]); });
 
-  // wait for completion of all threads
-  for (const auto &thread_pair : threads)
+  // copy the output of all hitsets to the node tree in one pass
+  for (const auto &data : threads)
   {
-    int rc2 = pthread_join(thread_pair.thread, nullptr);
-    if (rc2)
-    {
-      std::cout << "Error:unable to join," << rc2 << std::endl;
-    }
-
     // get the hitsetkey from thread data
-    const auto &data(thread_pair.data);
     const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
     // copy clusters to map
@@ -621,7 +592,7 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
     }
 
     // copy hit associations to map
-    for (const auto &[index, hkey] : thread_pair.data.association_vector)
+    for (const auto &[index, hkey] : data.association_vector)
     {
       // generate cluster key
       const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
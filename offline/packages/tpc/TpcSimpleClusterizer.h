@@ -4,8 +4,10 @@
 #include <fun4all/SubsysReco.h>
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrThreadPool.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -34,6 +36,8 @@ class TpcSimpleClusterizer : public SubsysReco
 
   void set_sector_fiducial_cut(const double cut) { SectorFiducialCut = cut; }
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
+  //! number of worker threads used to process hitsets. 0 means one per hardware thread
+  void set_num_threads(unsigned int n) { m_nthreads = n; }
 
  private:
   bool is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const;
@@ -51,6 +55,10 @@ class TpcSimpleClusterizer : public SubsysReco
   // From Tony Frawley May 13, 2021
   double par0_neg = 0.0503;
   double par0_pos = -0.0503;
+
+  //! worker threads, created at InitRun and kept for all events
+  unsigned int m_nthreads = 0;
+  std::unique_ptr<TrkrThreadPool> m_threadPool;
 };
 
 #endif
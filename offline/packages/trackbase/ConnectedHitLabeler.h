@@ -0,0 +1,140 @@
+#ifndef TRACKBASE_CONNECTEDHITLABELER_H
+#define TRACKBASE_CONNECTEDHITLABELER_H
+
+/**
+ * @file trackbase/ConnectedHitLabeler.h
+ * @brief Connected component labeling of hits on a 2D pixel/strip grid
+ *
+ * Replaces the all pairs adjacency test + boost::connected_components used by
+ * the silicon clusterizers. Two hits are adjacent if their coordinates differ by
+ * at most max_da in the first and max_db in the second coordinate. The hits are
+ * sorted once, each hit is compared only to the earlier hits of its own and the
+ * max_da previous columns which fall into its window, and groups are merged with
+ * a union-find.
+ *
+ * The cluster labels are numbered in order of the first hit (in input order)
+ * of each cluster, which is the numbering boost::connected_components gives,
+ * so cluster keys are unchanged.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+class ConnectedHitLabeler
+{
+ public:
+  //! (first coordinate, second coordinate) of a hit
+  using Coordinates = std::pair<int, int>;
+
+  //! fills labels (one per hit, in input order) and returns the number of clusters
+  unsigned int label(const std::vector<Coordinates>& hits, const int max_da, const int max_db, std::vector<int>& labels)
+  {
+    const unsigned int nhits = hits.size();
+    labels.assign(nhits, -1);
+    if (nhits == 0)
+    {
+      return 0;
+    }
+
+    // sort by (a, b), ties by input index
+    m_sorted.clear();
+    m_sorted.reserve(nhits);
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      m_sorted.emplace_back(hits[i].first, hits[i].second, i);
+    }
+    std::sort(m_sorted.begin(), m_sorted.end());
+
+    m_parent.resize(nhits);
+    std::iota(m_parent.begin(), m_parent.end(), 0);
+
+    // start of the column each sorted hit belongs to
+    m_columnStart.resize(nhits);
+    for (unsigned int p = 0; p < nhits; ++p)
+    {
+      m_columnStart[p] = (p > 0 && std::get<0>(m_sorted[p]) == std::get<0>(m_sorted[p - 1])) ? m_columnStart[p - 1] : p;
+    }
+
+    for (unsigned int p = 0; p < nhits; ++p)
+    {
+      const int a = std::get<0>(m_sorted[p]);
+      const int b = std::get<1>(m_sorted[p]);
+
+      // earlier hits in the same column, sorted in b, stop when out of window
+      for (unsigned int q = p; q > m_columnStart[p]; --q)
+      {
+        if (b - std::get<1>(m_sorted[q - 1]) > max_db)
+        {
+          break;
+        }
+        unite(std::get<2>(m_sorted[p]), std::get<2>(m_sorted[q - 1]));
+      }
+
+      // previous columns within max_da
+      unsigned int colend = m_columnStart[p];
+      while (colend > 0)
+      {
+        const unsigned int colstart = m_columnStart[colend - 1];
+        const int prev_a = std::get<0>(m_sorted[colstart]);
+        if (a - prev_a > max_da)
+        {
+          break;
+        }
+        // first hit with b' >= b - max_db
+        auto first = std::lower_bound(m_sorted.begin() + colstart, m_sorted.begin() + colend,
+                                      std::make_tuple(prev_a, b - max_db, 0U));
+        for (auto iter = first; iter != m_sorted.begin() + colend && std::get<1>(*iter) <= b + max_db; ++iter)
+        {
+          unite(std::get<2>(m_sorted[p]), std::get<2>(*iter));
+        }
+        colend = colstart;
+      }
+    }
+
+    // number the clusters in order of their first hit
+    m_rootLabel.assign(nhits, -1);
+    unsigned int nclusters = 0;
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      const unsigned int root = find(i);
+      if (m_rootLabel[root] < 0)
+      {
+        m_rootLabel[root] = nclusters++;
+      }
+      labels[i] = m_rootLabel[root];
+    }
+    return nclusters;
+  }
+
+ private:
+  unsigned int find(unsigned int i)
+  {
+    while (m_parent[i] != i)
+    {
+      m_parent[i] = m_parent[m_parent[i]];
+      i = m_parent[i];
+    }
+    return i;
+  }
+
+  void unite(const unsigned int i, const unsigned int j)
+  {
+    const unsigned int ri = find(i);
+    const unsigned int rj = find(j);
+    if (ri != rj)
+    {
+      m_parent[std::max(ri, rj)] = std::min(ri, rj);
+    }
+  }
+
+  //! work buffers, kept to avoid allocations from hitset to hitset
+  std::vector<std::tuple<int, int, unsigned int>> m_sorted;
+  std::vector<unsigned int> m_parent;
+  std::vector<unsigned int> m_columnStart;
+  std::vector<int> m_rootLabel;
+};
+
+#endif  // TRACKBASE_CONNECTEDHITLABELER_H
@@ -11,7 +11,9 @@
 
 #include <phool/PHObject.h>
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <utility>  // for pair
 
@@ -31,7 +33,121 @@ class TrkrHitSet : public PHObject
  public:
   // iterator typedef
   using Map = std::map<TrkrDefs::hitkey, TrkrHit*>;
-  using ConstIterator = Map::const_iterator;
+
+  /**
+   * @brief Iterator over the (hitkey, hit) pairs of a hitset
+   *
+   * Walks either a Map or the parallel arrays of sorted keys and hits of the
+   * flat hitsets. Dereferencing gives the pair by value, so this is only an
+   * input iterator: do not keep the address of *it or it.operator->().
+   */
+  class ConstIterator
+  {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::pair<const TrkrDefs::hitkey, TrkrHit*>;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+
+    //! keeps the dereferenced pair alive for operator->
+    class pointer
+    {
+     public:
+      explicit pointer(const value_type& value)
+        : m_value(value)
+      {
+      }
+      const value_type* operator->() const { return &m_value; }
+
+     private:
+      value_type m_value;
+    };
+
+    ConstIterator() = default;
+
+    //! iterator into a Map
+    ConstIterator(Map::const_iterator iter)  // NOLINT(hicpp-explicit-conversions)
+      : m_mapIter(iter)
+    {
+    }
+
+    ConstIterator(Map::iterator iter)  // NOLINT(hicpp-explicit-conversions)
+      : m_mapIter(iter)
+    {
+    }
+
+    //! position in the flat arrays of keys and hits
+    ConstIterator(const TrkrDefs::hitkey* key, TrkrHit* const* hit)
+      : m_key(key)
+      , m_hit(hit)
+    {
+    }
+
+    reference operator*() const
+    {
+      return m_key ? value_type(*m_key, *m_hit) : *m_mapIter;
+    }
+
+    pointer operator->() const { return pointer(**this); }
+
+    ConstIterator& operator++()
+    {
+      if (m_key)
+      {
+        ++m_key;
+        ++m_hit;
+      }
+      else
+      {
+        ++m_mapIter;
+      }
+      return *this;
+    }
+
+    ConstIterator operator++(int)
+    {
+      ConstIterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    ConstIterator& operator--()
+    {
+      if (m_key)
+      {
+        --m_key;
+        --m_hit;
+      }
+      else
+      {
+        --m_mapIter;
+      }
+      return *this;
+    }
+
+    ConstIterator operator--(int)
+    {
+      ConstIterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const ConstIterator& other) const
+    {
+      return m_key == other.m_key && m_mapIter == other.m_mapIter;
+    }
+
+    bool operator!=(const ConstIterator& other) const
+    {
+      return !(*this == other);
+    }
+
+   private:
+    Map::const_iterator m_mapIter{};
+    const TrkrDefs::hitkey* m_key = nullptr;
+    TrkrHit* const* m_hit = nullptr;
+  };
+
   using ConstRange = std::pair<ConstIterator, ConstIterator>;
 
   //! TObject functions
@@ -70,6 +186,16 @@ class TrkrHitSet : public PHObject
    */
   virtual ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*);
 
+  /**
+   * @brief Get the hit with a given key, create it if not found
+   * @param[in] key Hit key
+   * @param[out] Pointer to the hit, owned by this TrkrHitSet
+   *
+   * Preferred to addHitSpecificKey for new hits, hitsets with flat storage
+   * do not need a separate allocation per hit.
+   */
+  virtual TrkrHit* findOrAddHit(const TrkrDefs::hitkey);
+
   /**
    * @brief Remove a hit using its key
    * @param[in] key to be removed
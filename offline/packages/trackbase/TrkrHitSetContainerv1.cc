@@ -8,16 +8,46 @@
 
 #include "TrkrDefs.h"
 #include "TrkrHitSetv1.h"
+#include "TrkrHitSetv2.h"
 
+#include <algorithm>
 #include <cstdlib>
 
+TrkrHitSetContainerv1::~TrkrHitSetContainerv1()
+{
+  TrkrHitSetContainerv1::Reset();
+  for (auto hitset : m_flatHitSetPool)
+  {
+    delete hitset;
+  }
+}
+
 void TrkrHitSetContainerv1::Reset()
 {
+  // only the flat hitsets allocated by this container are reused,
+  // the ones read back from a DST or added from outside are deleted
+  std::sort(m_flatHitSets.begin(), m_flatHitSets.end());
   for (auto&& [key, hitset] : m_hitmap)
   {
-    delete hitset;
+    if (std::binary_search(m_flatHitSets.begin(), m_flatHitSets.end(), hitset))
+    {
+      hitset->Reset();
+      m_flatHitSetPool.push_back(static_cast<TrkrHitSetv2*>(hitset));
+    }
+    else
+    {
+      delete hitset;
+    }
   }
 
+  // keep at most as many as this event had hitsets
+  while (m_flatHitSetPool.size() > m_hitmap.size())
+  {
+    delete m_flatHitSetPool.back();
+    m_flatHitSetPool.pop_back();
+  }
+
+  m_flatHitSets.clear();
   m_hitmap.clear();
 }
 
@@ -61,7 +91,17 @@ void TrkrHitSetContainerv1::removeHitSet(TrkrDefs::hitsetkey key)
   if (iter != m_hitmap.end())
   {
     TrkrHitSet* hitset = iter->second;
-    delete hitset;
+    const auto flat_iter = std::find(m_flatHitSets.begin(), m_flatHitSets.end(), hitset);
+    if (flat_iter != m_flatHitSets.end())
+    {
+      m_flatHitSets.erase(flat_iter);
+      hitset->Reset();
+      m_flatHitSetPool.push_back(static_cast<TrkrHitSetv2*>(hitset));
+    }
+    else
+    {
+      delete hitset;
+    }
     m_hitmap.erase(iter);
   }
 }
@@ -99,12 +139,34 @@ TrkrHitSetContainerv1::findOrAddHitSet(TrkrDefs::hitsetkey key)
   auto it = m_hitmap.lower_bound(key);
   if (it == m_hitmap.end() || (key < it->first))
   {
-    it = m_hitmap.insert(it, std::make_pair(key, new TrkrHitSetv1));
+    it = m_hitmap.insert(it, std::make_pair(key, newHitSet(key)));
     it->second->setHitSetKey(key);
   }
   return it;
 }
 
+TrkrHitSet*
+TrkrHitSetContainerv1::newHitSet(TrkrDefs::hitsetkey key)
+{
+  const auto trkrid = TrkrDefs::getTrkrId(key);
+  if (!m_useFlatHitSets || (trkrid != TrkrDefs::mvtxId && trkrid != TrkrDefs::inttId))
+  {
+    return new TrkrHitSetv1;
+  }
+  TrkrHitSetv2* hitset = nullptr;
+  if (m_flatHitSetPool.empty())
+  {
+    hitset = new TrkrHitSetv2;
+  }
+  else
+  {
+    hitset = m_flatHitSetPool.back();
+    m_flatHitSetPool.pop_back();
+  }
+  m_flatHitSets.push_back(hitset);
+  return hitset;
+}
+
 TrkrHitSet*
 TrkrHitSetContainerv1::findHitSet(TrkrDefs::hitsetkey key)
 {
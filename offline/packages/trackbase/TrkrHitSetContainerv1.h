@@ -12,21 +12,23 @@
 #include <iostream>  // for cout, ostream
 #include <map>
 #include <utility>  // for pair
+#include <vector>
 
 class TrkrHitSet;
+class TrkrHitSetv2;
 
 /**
  * Container for TrkrHitSet objects
+ * With setFlatHitSets(true), findOrAddHitSet creates flat TrkrHitSetv2 hitsets
+ * for the adc only MVTX and INTT hits, which are kept by Reset() and reused
+ * with their hit storage. By default all hitsets are TrkrHitSetv1.
  */
 class TrkrHitSetContainerv1 : public TrkrHitSetContainer
 {
  public:
   TrkrHitSetContainerv1() = default;
 
-  ~TrkrHitSetContainerv1() override
-  {
-    TrkrHitSetContainerv1::Reset();
-  }
+  ~TrkrHitSetContainerv1() override;
 
   void Reset() override;
 
@@ -50,14 +52,37 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
 
   TrkrHitSet* findHitSet(TrkrDefs::hitsetkey key) override;
 
+  //! create TrkrHitSetv2 instead of TrkrHitSetv1 for MVTX and INTT hitsets in findOrAddHitSet
+  void setFlatHitSets(const bool value)
+  {
+    m_useFlatHitSets = value;
+  }
+
+  bool flatHitSets() const
+  {
+    return m_useFlatHitSets;
+  }
+
   unsigned int size() const override
   {
     return m_hitmap.size();
   }
 
  private:
+  //! new hitset for findOrAddHitSet
+  TrkrHitSet* newHitSet(TrkrDefs::hitsetkey key);
+
   Map m_hitmap;
 
+  //! hitset class created by findOrAddHitSet, not needed when reading back
+  bool m_useFlatHitSets = false;  //!
+
+  //! flat hitsets allocated by findOrAddHitSet and still in m_hitmap
+  std::vector<TrkrHitSet*> m_flatHitSets;  //!
+
+  //! flat hitsets released by Reset(), reused by findOrAddHitSet
+  std::vector<TrkrHitSetv2*> m_flatHitSetPool;  //!
+
   ClassDefOverride(TrkrHitSetContainerv1, 1)
 };
 
@@ -76,7 +76,7 @@ TrkrHitSetv1::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
 TrkrHit*
 TrkrHitSetv1::getHit(const TrkrDefs::hitkey key) const
 {
-  TrkrHitSetv1::ConstIterator it = m_hits.find(key);
+  const auto it = m_hits.find(key);
 
   if (it != m_hits.end())
   {
@@ -0,0 +1,155 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+#include "TrkrHit.h"
+
+#include <TBuffer.h>
+
+#include <algorithm>
+#include <cstdlib>  // for exit
+#include <iostream>
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+  m_hitKeys.clear();
+  m_hitAdcs.clear();
+  m_hitPtrs.clear();
+  // the arena hits are reused by the next event
+  m_hitArenaUsed = 0;
+}
+
+TrkrHitv2* TrkrHitSetv2::newHit()
+{
+  if (m_hitArenaUsed == m_hitArena.size())
+  {
+    m_hitArena.emplace_back();
+  }
+  TrkrHitv2* hit = &m_hitArena[m_hitArenaUsed++];
+  hit->setAdc(0);
+  return hit;
+}
+
+TrkrHit* TrkrHitSetv2::insertHit(size_t index, const TrkrDefs::hitkey key)
+{
+  TrkrHit* hit = newHit();
+  m_hitKeys.insert(m_hitKeys.begin() + index, key);
+  m_hitPtrs.insert(m_hitPtrs.begin() + index, hit);
+  return hit;
+}
+
+void TrkrHitSetv2::Streamer(TBuffer& R__b)
+{
+  if (R__b.IsReading())
+  {
+    R__b.ReadClassBuffer(TrkrHitSetv2::Class(), this);
+    m_hitPtrs.clear();
+    m_hitPtrs.reserve(m_hitKeys.size());
+    m_hitArenaUsed = 0;
+    for (const auto adc : m_hitAdcs)
+    {
+      TrkrHitv2* hit = newHit();
+      hit->setAdc(adc);
+      m_hitPtrs.push_back(hit);
+    }
+  }
+  else
+  {
+    m_hitAdcs.clear();
+    m_hitAdcs.reserve(m_hitPtrs.size());
+    for (const auto hit : m_hitPtrs)
+    {
+      m_hitAdcs.push_back(std::min(hit->getAdc(), 0xFFFFU));
+    }
+    R__b.WriteClassBuffer(TrkrHitSetv2::Class(), this);
+  }
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << m_hitKeys.size()
+      << std::endl;
+
+  for (size_t i = 0; i < m_hitKeys.size(); ++i)
+  {
+    os << " hitkey " << m_hitKeys[i] << std::endl;
+    m_hitPtrs[i]->identify(os);
+  }
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  const auto it = std::lower_bound(m_hitKeys.begin(), m_hitKeys.end(), key);
+  if (it != m_hitKeys.end() && *it == key)
+  {
+    // the arena hit stays unused until the next Reset()
+    m_hitPtrs.erase(m_hitPtrs.begin() + (it - m_hitKeys.begin()));
+    m_hitKeys.erase(it);
+  }
+  else
+  {
+    identify();
+    std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  const auto it = std::lower_bound(m_hitKeys.begin(), m_hitKeys.end(), key);
+  if (it != m_hitKeys.end() && *it == key)
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  const size_t index = it - m_hitKeys.begin();
+  // only the adc is kept, the hitset owns the passed hit
+  insertHit(index, key)->CopyFrom(*hit);
+  delete hit;
+  return ConstIterator(m_hitKeys.data() + index, m_hitPtrs.data() + index);
+}
+
+TrkrHit*
+TrkrHitSetv2::findOrAddHit(const TrkrDefs::hitkey key)
+{
+  // producers mostly add hits in increasing key order
+  if (m_hitKeys.empty() || m_hitKeys.back() < key)
+  {
+    return insertHit(m_hitKeys.size(), key);
+  }
+  const auto it = std::lower_bound(m_hitKeys.begin(), m_hitKeys.end(), key);
+  const size_t index = it - m_hitKeys.begin();
+  if (*it == key)
+  {
+    return m_hitPtrs[index];
+  }
+  return insertHit(index, key);
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  const auto it = std::lower_bound(m_hitKeys.begin(), m_hitKeys.end(), key);
+  if (it != m_hitKeys.end() && *it == key)
+  {
+    return m_hitPtrs[it - m_hitKeys.begin()];
+  }
+  return nullptr;
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  return std::make_pair(ConstIterator(m_hitKeys.data(), m_hitPtrs.data()),
+                        ConstIterator(m_hitKeys.data() + m_hitKeys.size(), m_hitPtrs.data() + m_hitPtrs.size()));
+}
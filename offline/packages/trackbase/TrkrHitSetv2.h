@@ -0,0 +1,98 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Flat container for storing TrkrHit's
+ */
+#include "TrkrDefs.h"
+#include "TrkrHitSet.h"
+#include "TrkrHitv2.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+// forward declaration
+class TrkrHit;
+
+/**
+ * IO and memory efficient hitset for adc only hits (MVTX, INTT)
+ * The hits are kept as a sorted array of hitkeys with a parallel array of
+ * pointers into an arena of TrkrHitv2, which is reused from event to event, so
+ * adding hits, reading back and resetting do not allocate or delete single hits.
+ * Only the hitkeys and adc values are written to the DST.
+ * Hits should be created with findOrAddHit(), addHitSpecificKey() copies the
+ * passed hit into the arena and deletes it.
+ */
+class TrkrHitSetv2 : public TrkrHitSet
+{
+ public:
+  TrkrHitSetv2() = default;
+
+  //! the hit pointers point into the arena of this object
+  TrkrHitSetv2(const TrkrHitSetv2&) = delete;
+  TrkrHitSetv2& operator=(const TrkrHitSetv2&) = delete;
+
+  ~TrkrHitSetv2() override = default;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void Reset() override;
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+
+  TrkrHit* findOrAddHit(const TrkrDefs::hitkey) override;
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+
+  ConstRange getHits() const override;
+
+  unsigned int size() const override
+  {
+    return m_hitKeys.size();
+  }
+
+ private:
+  //! insert an arena hit for key at position index of the sorted arrays
+  TrkrHit* insertHit(size_t index, const TrkrDefs::hitkey key);
+
+  //! next unused hit of the arena, with zero adc
+  TrkrHitv2* newHit();
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// sorted hit keys
+  std::vector<TrkrDefs::hitkey> m_hitKeys;
+
+  /// adc values, same order as m_hitKeys, only filled when writing
+  std::vector<uint16_t> m_hitAdcs;
+
+  /// hits, same order as m_hitKeys
+  std::vector<TrkrHit*> m_hitPtrs;  //!
+
+  /// hit storage, kept by Reset(). A deque does not move the hits when growing
+  std::deque<TrkrHitv2> m_hitArena;  //!
+
+  /// number of arena hits handed out since the last Reset()
+  size_t m_hitArenaUsed = 0;  //!
+
+  ClassDefOverride(TrkrHitSetv2, 1);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
@@ -0,0 +1,6 @@
+#ifdef __CINT__
+
+// custom streamer fills the adc array and rebuilds the hits from it
+#pragma link C++ class TrkrHitSetv2 - ;
+
+#endif
@@ -73,6 +73,26 @@ class TrkrHitTruthAssoc : public PHObject
   {
   }
 
+  /**
+   * @brief True if getG4HitRange is implemented, otherwise use getG4Hits per hit
+   */
+  virtual bool hasG4HitRange() const
+  {
+    return false;
+  }
+
+  /**
+   * @brief Get all (hitkey, g4hitkey) pairs of a hitset at once
+   * @param[in] hset TrkrHitSet key
+   *
+   * Only valid if hasG4HitRange() is true, the base class returns an empty range
+   */
+  virtual ConstRange getG4HitRange(const TrkrDefs::hitsetkey /*hitsetkey*/) const
+  {
+    static const MMap dummy;
+    return std::make_pair(dummy.cbegin(), dummy.cend());
+  }
+
  protected:
   //! ctor
   TrkrHitTruthAssoc() = default;
@@ -0,0 +1,141 @@
+/*!
+ * \file TrkrThreadPool.cc
+ * \brief persistent worker pool shared by the TPC clusterizers and the track fit
+ */
+
+#include "TrkrThreadPool.h"
+
+#include <algorithm>
+
+//_____________________________________________________________________
+TrkrThreadPool::TrkrThreadPool(unsigned int nthreads)
+{
+  if (nthreads == 0)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+
+  m_workers.reserve(nthreads);
+  for (unsigned int i = 0; i < nthreads; ++i)
+  {
+    m_workers.emplace_back(&TrkrThreadPool::work, this, i);
+  }
+}
+
+//_____________________________________________________________________
+TrkrThreadPool::~TrkrThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start.notify_all();
+  for (auto& worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+//_____________________________________________________________________
+void TrkrThreadPool::run(unsigned int ntasks, const Task& task)
+{
+  if (ntasks == 0)
+  {
+    return;
+  }
+
+  // distribute tasks in contiguous blocks
+  const unsigned int nqueues = m_queues.size();
+  for (unsigned int i = 0; i < nqueues; ++i)
+  {
+    std::lock_guard<std::mutex> lock(m_queues[i]->mutex);
+    const unsigned int first = static_cast<unsigned long>(ntasks) * i / nqueues;
+    const unsigned int last = static_cast<unsigned long>(ntasks) * (i + 1) / nqueues;
+    for (unsigned int itask = first; itask < last; ++itask)
+    {
+      m_queues[i]->tasks.push_back(itask);
+    }
+  }
+
+  // wake up workers and wait until they are all done
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_task = &task;
+  m_active = m_workers.size();
+  ++m_generation;
+  m_start.notify_all();
+  m_done.wait(lock, [this]
+              { return m_active == 0; });
+  m_task = nullptr;
+}
+
+//_____________________________________________________________________
+bool TrkrThreadPool::next_task(unsigned int worker, unsigned int& task)
+{
+  // own queue first
+  {
+    auto& queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+
+  // steal from the back of the other queues
+  const unsigned int nqueues = m_queues.size();
+  for (unsigned int i = 1; i < nqueues; ++i)
+  {
+    auto& queue = *m_queues[(worker + i) % nqueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//_____________________________________________________________________
+void TrkrThreadPool::work(unsigned int worker)
+{
+  unsigned long generation = 0;
+  while (true)
+  {
+    const Task* task = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start.wait(lock, [this, generation]
+                   { return m_stop || m_generation != generation; });
+      if (m_stop)
+      {
+        return;
+      }
+      generation = m_generation;
+      task = m_task;
+    }
+
+    unsigned int itask = 0;
+    while (next_task(worker, itask))
+    {
+      (*task)(itask, worker);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_active == 0)
+      {
+        m_done.notify_one();
+      }
+    }
+  }
+}
@@ -0,0 +1,89 @@
+#ifndef TRACKBASE_TRKRTHREADPOOL_H
+#define TRACKBASE_TRKRTHREADPOOL_H
+
+/*!
+ * \file TrkrThreadPool.h
+ * \brief persistent worker pool shared by the TPC clusterizers and the track fit
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * The worker threads are created once and reused from event to event.
+ * run() distributes the task indices in contiguous blocks over per-worker queues.
+ * A worker takes tasks from the front of its own queue and, once it is empty,
+ * steals from the back of the other queues, so that a few large hitsets do not
+ * leave the other workers idle. run() returns when all tasks are done.
+ *
+ * The task function receives the task index and the worker index, the latter
+ * can be used to address per-worker output buffers without locking.
+ */
+class TrkrThreadPool
+{
+ public:
+  //! task function, called with task index and worker index
+  using Task = std::function<void(unsigned int /*task*/, unsigned int /*worker*/)>;
+
+  //! constructor. Zero threads means one per hardware thread
+  explicit TrkrThreadPool(unsigned int nthreads = 0);
+
+  //! destructor, joins the workers
+  ~TrkrThreadPool();
+
+  TrkrThreadPool(const TrkrThreadPool&) = delete;
+  TrkrThreadPool& operator=(const TrkrThreadPool&) = delete;
+
+  //! number of worker threads
+  unsigned int nthreads() const
+  {
+    return m_workers.size();
+  }
+
+  //! run task for all indices in [0, ntasks) and wait for completion
+  void run(unsigned int ntasks, const Task& task);
+
+ private:
+  //! worker main loop
+  void work(unsigned int worker);
+
+  //! get next task for worker, from its own queue or stolen from another one. Returns false when none is left
+  bool next_task(unsigned int worker, unsigned int& task);
+
+  //! per-worker task queue
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<unsigned int> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_workers;
+
+  //! protects the members below
+  std::mutex m_mutex;
+
+  //! signals workers that a new batch of tasks is available
+  std::condition_variable m_start;
+
+  //! signals run() that all workers are done
+  std::condition_variable m_done;
+
+  //! current task function
+  const Task* m_task = nullptr;
+
+  //! incremented for each call to run()
+  unsigned long m_generation = 0;
+
+  //! number of workers still processing the current batch
+  unsigned int m_active = 0;
+
+  bool m_stop = false;
+};
+
+#endif
@@ -59,6 +59,7 @@
 #include <cmath>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 namespace
@@ -151,6 +152,39 @@ int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
     m_fitCfg.fit->outlierFinder(m_outlierFinder);
   }
 
+  if (m_nthreads != 1)
+  {
+    if (!m_use_clustermover || m_useOutlierFinder)
+    {
+      // transient transforms and outlier finder histograms are shared between tracks
+      std::cout << "PHActsTrkFitter::InitRun - parallel fits require the cluster mover and no outlier finder. Fitting sequentially" << std::endl;
+    }
+    else if (!m_threadPool)
+    {
+      m_threadPool = std::make_unique<TrkrThreadPool>(m_nthreads);
+
+      // one fitter instance per worker
+      m_workerFitCfg.clear();
+      for (unsigned int i = 0; i < m_threadPool->nthreads(); ++i)
+      {
+        auto fitCfg = m_fitCfg;
+        fitCfg.fit = ActsTrackFittingAlgorithm::makeKalmanFitterFunction(
+            m_tGeometry->geometry().tGeometry,
+            m_tGeometry->geometry().magField,
+            true, true, 0.0, Acts::FreeToBoundCorrection(), *Acts::getDefaultLogger("Kalman", level));
+        fitCfg.dFit = ActsTrackFittingAlgorithm::makeDirectedKalmanFitterFunction(
+            m_tGeometry->geometry().tGeometry,
+            m_tGeometry->geometry().magField);
+        m_workerFitCfg.push_back(fitCfg);
+      }
+
+      if (Verbosity() > 0)
+      {
+        std::cout << "PHActsTrkFitter::InitRun - using " << m_threadPool->nthreads() << " fit threads" << std::endl;
+      }
+    }
+  }
+
   if (m_timeAnalysis)
   {
     m_timeFile = new TFile(std::string(Name() + ".root").c_str(),
@@ -216,6 +250,9 @@ int PHActsTrkFitter::process_event(PHCompositeNode* topNode)
 
   // in case the track map already exist in the file, we want to replace it
   m_trackMap->Reset(); 
+
+  // cluster positions from previous event are no longer valid
+  m_globalPositionWrapper.clear_cluster_cache();
      
   loopTracks(logLevel);
 
@@ -298,6 +335,15 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
 {
   auto logger = Acts::getDefaultLogger("PHActsTrkFitter", logLevel);
 
+  // the transient transforms are modified in place, the context only points to them
+  m_transient_geocontext = m_alignmentTransformationMapTransient;
+
+  if (m_threadPool)
+  {
+    loopTracksParallel();
+    return;
+  }
+
   for (auto track : *m_seedMap)
   {
     if (!track)
@@ -305,551 +351,644 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
       continue;
     }
 
-    unsigned int tpcid = track->get_tpc_seed_index();
-    unsigned int siid = track->get_silicon_seed_index();
+    SeedFit seedfit;
+    if (!getSeedFit(track, seedfit))
+    {
+      continue;
+    }
 
-    // capture the input crossing value, and set crossing parameters
-    //==============================
-    short silicon_crossing =  SHRT_MAX;
-    auto siseed = m_siliconSeeds->get(siid);
-    if(siseed)
-      {
-	silicon_crossing = siseed->get_crossing();
-      }
-    short crossing = silicon_crossing;
-    short int crossing_estimate = crossing;
+    PHTimer trackTimer("TrackTimer");
+    trackTimer.stop();
+    trackTimer.restart();
 
-    if(m_enable_crossing_estimate)
-      {
-	crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate from matcher
-     }
-    //===============================
+    std::vector<float> chisq_ndf;
+    std::vector<SvtxTrack_v4> svtx_vec;
 
+    // Fit this track assuming either:
+    //    crossing = INTT value, if it exists (uses nvary = 0)
+    //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
 
-    // must have silicon seed with valid crossing if we are doing a SC calibration fit
-    if (m_fitSiliconMMs)
-      {
-	if( (siid == std::numeric_limits<unsigned int>::max()) || (silicon_crossing == SHRT_MAX))
-	  {
-	    continue;
-	  }
-      }
+    for (short int ivary = -seedfit.nvary; ivary <= seedfit.nvary; ++ivary)
+    {
+      TrialFit trial;
+      fitTrial(seedfit, ivary, trial, m_fitCfg);
+      storeTrial(seedfit, trial, chisq_ndf, svtx_vec);
+    }  // end ivary loop
 
-    // do not skip TPC only tracks, just set crossing to the nominal zero
-    if(!siseed)
-      {
-	crossing = 0;
-      }
+    trackTimer.stop();
+    auto trackTime = trackTimer.get_accumulated_time();
 
     if (Verbosity() > 1)
     {
-      if(siseed)
-	{
-	  std::cout << "tpc and si id " << tpcid << ", " << siid << " silicon_crossing " << silicon_crossing
-		    << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
-	}
+      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
     }
+  }
 
-    auto tpcseed = m_tpcSeeds->get(tpcid);
+  return;
+}
 
-    /// Need to also check that the tpc seed wasn't removed by the ghost finder
-    if (!tpcseed)
+void PHActsTrkFitter::loopTracksParallel()
+{
+  // seed selection is cheap and prints diagnostics, keep it in seed map order
+  std::vector<SeedFit> seedfits;
+  seedfits.reserve(m_seedMap->size());
+  for (auto track : *m_seedMap)
+  {
+    if (!track)
     {
-      std::cout << "no tpc seed" << std::endl;
       continue;
     }
 
-    if (Verbosity() > 0)
+    SeedFit seedfit;
+    if (getSeedFit(track, seedfit))
     {
-      if (siseed)
-      {
-        const auto si_position = TrackSeedHelper::get_xyz(siseed);
-        const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
-        std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
-        std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
-      }
+      seedfits.push_back(std::move(seedfit));
     }
+  }
 
-    PHTimer trackTimer("TrackTimer");
-    trackTimer.stop();
-    trackTimer.restart();
-
-    if (Verbosity() > 1 && siseed)
+  // fit all crossing hypotheses of each seed, each worker using its own fitter instance
+  m_threadPool->run(seedfits.size(), [this, &seedfits](unsigned int task, unsigned int worker)
+  {
+    auto& seedfit = seedfits[task];
+    for (short int ivary = -seedfit.nvary; ivary <= seedfit.nvary; ++ivary)
     {
-      std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
-        << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
+      auto trial = std::make_unique<TrialFit>();
+      fitTrial(seedfit, ivary, *trial, m_workerFitCfg[worker]);
+      seedfit.trials.push_back(std::move(trial));
     }
+  });
 
-    short int this_crossing = crossing;
-    bool use_estimate = false;
-    short int nvary = 0;
+  // store the results in seed order, so that the track map does not depend on the number of threads
+  for (auto& seedfit : seedfits)
+  {
     std::vector<float> chisq_ndf;
     std::vector<SvtxTrack_v4> svtx_vec;
+    for (auto& trial : seedfit.trials)
+    {
+      storeTrial(seedfit, *trial, chisq_ndf, svtx_vec);
+    }
+  }
+}
 
-    if(m_pp_mode)
-      {
-	if (m_enable_crossing_estimate && crossing == SHRT_MAX)
-	  {
-	    // this only happens if there is a silicon seed but no assigned INTT crossing, and only in pp_mode
-	    // If there is no INTT crossing, start with the crossing_estimate value, vary up and down, fit, and choose the best chisq/ndf
-	    use_estimate = true;
-	    nvary = max_bunch_search;
-	    if (Verbosity() > 1)
-	      {
-		std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << nvary << std::endl;
-	      }
-	  }
-	else
-	  {
-	    // use INTT crossing
-	    crossing_estimate = crossing;
-	  }
-      }
-    else
-      {
-	// non pp mode, we want only crossing zero, veto others
-	if(siseed && silicon_crossing != 0)
-	  {
-	    crossing = 0;
-	    //continue;
-	  }
-	crossing_estimate = crossing;
-      }
+bool PHActsTrkFitter::getSeedFit(TrackSeed* track, SeedFit& seedfit) const
+{
+  unsigned int tpcid = track->get_tpc_seed_index();
+  unsigned int siid = track->get_silicon_seed_index();
+
+  // capture the input crossing value, and set crossing parameters
+  //==============================
+  short silicon_crossing =  SHRT_MAX;
+  auto siseed = m_siliconSeeds->get(siid);
+  if(siseed)
+    {
+      silicon_crossing = siseed->get_crossing();
+    }
+  short crossing = silicon_crossing;
+  short int crossing_estimate = crossing;
 
-    // Fit this track assuming either:
-    //    crossing = INTT value, if it exists (uses nvary = 0)
-    //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
+  if(m_enable_crossing_estimate)
+    {
+      crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate from matcher
+    }
+  //===============================
+
+
+  // must have silicon seed with valid crossing if we are doing a SC calibration fit
+  if (m_fitSiliconMMs)
+    {
+      if( (siid == std::numeric_limits<unsigned int>::max()) || (silicon_crossing == SHRT_MAX))
+	{
+	  return false;
+	}
+    }
 
-    for (short int ivary = -nvary; ivary <= nvary; ++ivary)
+  // do not skip TPC only tracks, just set crossing to the nominal zero
+  if(!siseed)
     {
-      this_crossing = crossing_estimate + ivary;
+      crossing = 0;
+    }
 
-      if (Verbosity() > 1)
+  if (Verbosity() > 1)
+  {
+    if(siseed)
       {
-        std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
+	std::cout << "tpc and si id " << tpcid << ", " << siid << " silicon_crossing " << silicon_crossing
+		  << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
       }
+  }
 
-      ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+  auto tpcseed = m_tpcSeeds->get(tpcid);
 
-      SourceLinkVec sourceLinks;
+  /// Need to also check that the tpc seed wasn't removed by the ghost finder
+  if (!tpcseed)
+  {
+    std::cout << "no tpc seed" << std::endl;
+    return false;
+  }
 
-      MakeSourceLinks makeSourceLinks;
-      makeSourceLinks.initialize(_tpccellgeo);
-      makeSourceLinks.setVerbosity(Verbosity());
-      makeSourceLinks.set_pp_mode(m_pp_mode);
-      for(const auto& layer : m_ignoreLayer)
-      {
-        makeSourceLinks.ignoreLayer(layer);
-      }
-      // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-      // does nothing if m_transient_id_set is empty
-      makeSourceLinks.resetTransientTransformMap(
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        m_tGeometry);
+  if (Verbosity() > 0)
+  {
+    if (siseed)
+    {
+      const auto si_position = TrackSeedHelper::get_xyz(siseed);
+      const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
+      std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
+      std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
+    }
+  }
 
-      if (m_use_clustermover)
-      {
-	// make source links using cluster mover after making distortion correction
+  if (Verbosity() > 1 && siseed)
+  {
+    std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
+      << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
+  }
 
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-            siseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            this_crossing);
-        }
+  bool use_estimate = false;
+  short int nvary = 0;
 
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-          tpcseed,
-          measurements,
-          m_clusterContainer,
-          m_tGeometry,
-          m_globalPositionWrapper,
-          this_crossing);
-
-        // add tpc sourcelinks to silicon source links
-	sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
-      }
+  if(m_pp_mode)
+    {
+      if (m_enable_crossing_estimate && crossing == SHRT_MAX)
+	{
+	  // this only happens if there is a silicon seed but no assigned INTT crossing, and only in pp_mode
+	  // If there is no INTT crossing, start with the crossing_estimate value, vary up and down, fit, and choose the best chisq/ndf
+	  use_estimate = true;
+	  nvary = max_bunch_search;
+	  if (Verbosity() > 1)
+	    {
+	      std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << nvary << std::endl;
+	    }
+	}
       else
-      {
-	// make source links using transient transforms for distortion corrections
+	{
+	  // use INTT crossing
+	  crossing_estimate = crossing;
+	}
+    }
+  else
+    {
+      // non pp mode, we want only crossing zero, veto others
+      if(siseed && silicon_crossing != 0)
+	{
+	  crossing = 0;
+	  //continue;
+	}
+      crossing_estimate = crossing;
+    }
 
-	if(Verbosity() > 1)
-	  { std::cout << "Calling getSourceLinks for si seed, siid " << siid << " and tpcid " << tpcid << std::endl; }
-	
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinks(
-            siseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            m_alignmentTransformationMapTransient,
-            m_transient_id_set,
-            this_crossing);
-        }
+  seedfit.track = track;
+  seedfit.siseed = siseed;
+  seedfit.tpcseed = tpcseed;
+  seedfit.tpcid = tpcid;
+  seedfit.siid = siid;
+  seedfit.crossing_estimate = crossing_estimate;
+  seedfit.nvary = nvary;
+  seedfit.use_estimate = use_estimate;
+  return true;
+}
 
-	if(Verbosity() > 1)
-	  { std::cout << "Calling getSourceLinks for tpc seed, siid " << siid << " and tpcid " << tpcid << std::endl; }
-	      
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
-          tpcseed,
-          measurements,
-          m_clusterContainer,
-          m_tGeometry,
-          m_globalPositionWrapper,
-          m_alignmentTransformationMapTransient,
-          m_transient_id_set,
-          this_crossing);
-
-        // add tpc sourcelinks to silicon source links
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
-      }
+void PHActsTrkFitter::fitTrial(const SeedFit& seedfit, short int ivary, TrialFit& trial,
+                               const ActsTrackFittingAlgorithm::Config& fitCfg)
+{
+  auto siseed = seedfit.siseed;
+  auto tpcseed = seedfit.tpcseed;
+  const auto siid = seedfit.siid;
+  const auto tpcid = seedfit.tpcid;
+  const auto nvary = seedfit.nvary;
 
-      // copy transient map for this track into transient geoContext
-      m_transient_geocontext = m_alignmentTransformationMapTransient;
-      
-      // position comes from the silicon seed, unless there is no silicon seed
-      Acts::Vector3 position(0, 0, 0);
-      if (siseed)
-      {
-        position = TrackSeedHelper::get_xyz(siseed)*Acts::UnitConstants::cm;
-      }
-      if(!siseed || !is_valid(position) || m_ignoreSilicon)
-      {
-        position = TrackSeedHelper::get_xyz(tpcseed)*Acts::UnitConstants::cm;
-      }
-      if (!is_valid(position))
+  short int this_crossing = seedfit.crossing_estimate + ivary;
+  trial.ivary = ivary;
+  trial.crossing = this_crossing;
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
+  }
+
+  auto& measurements = trial.measurements;
+
+  SourceLinkVec sourceLinks;
+
+  MakeSourceLinks makeSourceLinks;
+  makeSourceLinks.initialize(_tpccellgeo);
+  makeSourceLinks.setVerbosity(Verbosity());
+  makeSourceLinks.set_pp_mode(m_pp_mode);
+  for(const auto& layer : m_ignoreLayer)
+  {
+    makeSourceLinks.ignoreLayer(layer);
+  }
+
+  if (m_use_clustermover)
+  {
+    // make source links using cluster mover after making distortion correction
+
+    if (siseed && !m_ignoreSilicon)
+    {
+      // silicon source links
+      sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+        siseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        this_crossing);
+    }
+
+    // tpc source links
+    const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+      tpcseed,
+      measurements,
+      m_clusterContainer,
+      m_tGeometry,
+      m_globalPositionWrapper,
+      this_crossing);
+
+    // add tpc sourcelinks to silicon source links
+    sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+  }
+  else
+  {
+    // make source links using transient transforms for distortion corrections
+
+    // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+    // does nothing if m_transient_id_set is empty
+    makeSourceLinks.resetTransientTransformMap(
+      m_alignmentTransformationMapTransient,
+      m_transient_id_set,
+      m_tGeometry);
+
+    if(Verbosity() > 1)
+      { std::cout << "Calling getSourceLinks for si seed, siid " << siid << " and tpcid " << tpcid << std::endl; }
+
+    if (siseed && !m_ignoreSilicon)
+    {
+      // silicon source links
+      sourceLinks = makeSourceLinks.getSourceLinks(
+        siseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        m_alignmentTransformationMapTransient,
+        m_transient_id_set,
+        this_crossing);
+    }
+
+    if(Verbosity() > 1)
+      { std::cout << "Calling getSourceLinks for tpc seed, siid " << siid << " and tpcid " << tpcid << std::endl; }
+
+    // tpc source links
+    const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
+      tpcseed,
+      measurements,
+      m_clusterContainer,
+      m_tGeometry,
+      m_globalPositionWrapper,
+      m_alignmentTransformationMapTransient,
+      m_transient_id_set,
+      this_crossing);
+
+    // add tpc sourcelinks to silicon source links
+    sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+  }
+
+  // position comes from the silicon seed, unless there is no silicon seed
+  Acts::Vector3 position(0, 0, 0);
+  if (siseed)
+  {
+    position = TrackSeedHelper::get_xyz(siseed)*Acts::UnitConstants::cm;
+  }
+  if(!siseed || !is_valid(position) || m_ignoreSilicon)
+  {
+    position = TrackSeedHelper::get_xyz(tpcseed)*Acts::UnitConstants::cm;
+  }
+  if (!is_valid(position))
+  {
+   if(Verbosity() > 4)
+    {
+      std::cout << "Invalid position of " << position.transpose() << std::endl;
+    }
+    return;
+  }
+
+  if (sourceLinks.empty())
+  {
+    return;
+  }
+
+  /// If using directed navigation, collect surface list to navigate
+  SurfacePtrVec surfaces_tmp;
+  SurfacePtrVec surfaces;
+  if (m_fitSiliconMMs || m_directNavigation)
+  {
+    sourceLinks = getSurfaceVector(sourceLinks, surfaces_tmp);
+
+    // skip if there is no surfaces
+    if (surfaces_tmp.empty())
+    {
+      return;
+    }
+    for (const auto& surface_apr : m_materialSurfaces)
+    {
+      if(m_forceSiOnlyFit)
       {
-       if(Verbosity() > 4)
+        if(surface_apr->geometryId().volume() >12)
         {
-          std::cout << "Invalid position of " << position.transpose() << std::endl;
+          continue;
         }
-        continue;
       }
-
-      if (sourceLinks.empty())
+      bool pop_flag = false;
+      if(surface_apr->geometryId().approach() == 1)
       {
-        continue;
+        surfaces.push_back(surface_apr);
       }
-
-      /// If using directed navigation, collect surface list to navigate
-      SurfacePtrVec surfaces_tmp;
-      SurfacePtrVec surfaces;
-      if (m_fitSiliconMMs || m_directNavigation)
+      else
       {
-        sourceLinks = getSurfaceVector(sourceLinks, surfaces_tmp);
-
-        // skip if there is no surfaces
-        if (surfaces_tmp.empty())
-        {
-          continue;
-        }
-        for (const auto& surface_apr : m_materialSurfaces)
+        pop_flag = true;
+        for (const auto& surface_sns: surfaces_tmp)
         {
-          if(m_forceSiOnlyFit)
-          {
-            if(surface_apr->geometryId().volume() >12)
-            {
-              continue;
-            }
-          }
-          bool pop_flag = false;
-          if(surface_apr->geometryId().approach() == 1)
-          {
-            surfaces.push_back(surface_apr);
-          }
-          else
+          if (surface_apr->geometryId().volume() == surface_sns->geometryId().volume())
           {
-            pop_flag = true;
-            for (const auto& surface_sns: surfaces_tmp)
+            if ( surface_apr->geometryId().layer()==surface_sns->geometryId().layer())
             {
-              if (surface_apr->geometryId().volume() == surface_sns->geometryId().volume())
-              {
-                if ( surface_apr->geometryId().layer()==surface_sns->geometryId().layer())
-                {
-                  pop_flag = false;
-                  surfaces.push_back(surface_sns);
-                }            
-              }
-            }
-            if (!pop_flag)
-            {
-              surfaces.push_back(surface_apr);
-            }
-            else
-            {
-              surfaces.pop_back();
               pop_flag = false;
-            }
-            if (surface_apr->geometryId().volume() == 12&& surface_apr->geometryId().layer()==8)
-            {
-              for (const auto& surface_sns: surfaces_tmp)
-              {
-                if (14 == surface_sns->geometryId().volume())
-                {
-                  surfaces.push_back(surface_sns);
-                }   
-              }
-            }
+              surfaces.push_back(surface_sns);
+            }            
           }
         }
-        checkSurfaceVec(surfaces);
-        if (Verbosity() > 1)
+        if (!pop_flag)
+        {
+          surfaces.push_back(surface_apr);
+        }
+        else
+        {
+          surfaces.pop_back();
+          pop_flag = false;
+        }
+        if (surface_apr->geometryId().volume() == 12&& surface_apr->geometryId().layer()==8)
         {
-          for (const auto& surf : surfaces)
+          for (const auto& surface_sns: surfaces_tmp)
           {
-            std::cout << "Surface vector : " << surf->geometryId() << std::endl;
+            if (14 == surface_sns->geometryId().volume())
+            {
+              surfaces.push_back(surface_sns);
+            }   
           }
         }
-	if (m_fitSiliconMMs)
-	  {
-	    // make sure micromegas are in the tracks, if required
-	    if (m_useMicromegas &&
-		std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
-		{ return m_tGeometry->maps().isMicromegasSurface(surface); }))
-	      {
-		continue;
-	      }
-	  }
       }
-
-      float px = std::numeric_limits<float>::quiet_NaN();
-      float py = std::numeric_limits<float>::quiet_NaN();
-      float pz = std::numeric_limits<float>::quiet_NaN();
-
-      // get phi and theta from the silicon seed, momentum from the TPC seed
-      float seedphi = 0;
-      float seedtheta = 0;
-      float seedeta = 0;
-      if(siseed)
-	{
-	  seedphi = siseed->get_phi();
-	  seedtheta = siseed->get_theta();
-	  seedeta = siseed->get_eta();
-	}
-      else
-	{
-	  seedphi = tpcseed->get_phi();
-	  seedtheta = tpcseed->get_theta();
-	  seedeta = tpcseed->get_eta();
-	}
-      
-      float seedpt = tpcseed->get_pt();      
-
-      if (m_ConstField)
+    }
+    checkSurfaceVec(surfaces);
+    if (Verbosity() > 1)
+    {
+      for (const auto& surf : surfaces)
       {
-        float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
-	float phi = seedphi;
-	float eta = seedeta;
-	float theta = seedtheta;
-	px = pt * std::cos(phi);
-        py = pt * std::sin(phi);
-	pz = pt * std::cosh(eta) * std::cos(theta);
+        std::cout << "Surface vector : " << surf->geometryId() << std::endl;
       }
-      else
+    }
+    if (m_fitSiliconMMs)
       {
-	px = seedpt * std::cos(seedphi);
-	py = seedpt * std::sin(seedphi);
-	pz = seedpt * std::cosh(seedeta) * std::cos(seedtheta);
+	// make sure micromegas are in the tracks, if required
+	if (m_useMicromegas &&
+	    std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
+	    { return m_tGeometry->maps().isMicromegasSurface(surface); }))
+	  {
+	    return;
+	  }
       }
+  }
 
-      Acts::Vector3 momentum(px, py, pz);
-      if (!is_valid(momentum))
-      {
-        if(Verbosity() > 4)
-        {
-          std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
-        }
-        continue;
-      }
+  float px = std::numeric_limits<float>::quiet_NaN();
+  float py = std::numeric_limits<float>::quiet_NaN();
+  float pz = std::numeric_limits<float>::quiet_NaN();
 
-      auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
-          position);
+  // get phi and theta from the silicon seed, momentum from the TPC seed
+  float seedphi = 0;
+  float seedtheta = 0;
+  float seedeta = 0;
+  if(siseed)
+    {
+      seedphi = siseed->get_phi();
+      seedtheta = siseed->get_theta();
+      seedeta = siseed->get_eta();
+    }
+  else
+    {
+      seedphi = tpcseed->get_phi();
+      seedtheta = tpcseed->get_theta();
+      seedeta = tpcseed->get_eta();
+    }
+  
+  float seedpt = tpcseed->get_pt();      
 
-      auto actsFourPos = Acts::Vector4(position(0), position(1),
-                                       position(2),
-                                       10 * Acts::UnitConstants::ns);
-      Acts::BoundSquareMatrix cov = setDefaultCovariance();
+  if (m_ConstField)
+  {
+    float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
+    float phi = seedphi;
+    float eta = seedeta;
+    float theta = seedtheta;
+    px = pt * std::cos(phi);
+    py = pt * std::sin(phi);
+    pz = pt * std::cosh(eta) * std::cos(theta);
+  }
+  else
+  {
+    px = seedpt * std::cos(seedphi);
+    py = seedpt * std::sin(seedphi);
+    pz = seedpt * std::cosh(seedeta) * std::cos(seedtheta);
+  }
 
-      int charge = tpcseed->get_charge();
+  Acts::Vector3 momentum(px, py, pz);
+  if (!is_valid(momentum))
+  {
+    if(Verbosity() > 4)
+    {
+      std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
+    }
+    return;
+  }
 
-      /// Reset the track seed with the dummy covariance
-      auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
-                      pSurface,
-                      m_transient_geocontext,
-                      actsFourPos,
-                      momentum,
-                      charge / momentum.norm(),
-                      cov,
-                      Acts::ParticleHypothesis::pion())
-                      .value();
+  auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
+      position);
 
-      if (Verbosity() > 2)
-      {
-        printTrackSeed(seed);
-      }
+  auto actsFourPos = Acts::Vector4(position(0), position(1),
+                                   position(2),
+                                   10 * Acts::UnitConstants::ns);
+  Acts::BoundSquareMatrix cov = setDefaultCovariance();
 
-      /// Set host of propagator options for Acts to do e.g. material integration
-      Acts::PropagatorPlainOptions ppPlainOptions;
-
-      auto calibptr = std::make_unique<Calibrator>();
-      CalibratorAdapter calibrator{*calibptr, measurements};
-
-      auto magcontext = m_tGeometry->geometry().magFieldContext;
-      auto calibcontext = m_tGeometry->geometry().calibContext;
-
-      ActsTrackFittingAlgorithm::GeneralFitterOptions
-          kfOptions{
-              m_transient_geocontext,
-              magcontext,
-              calibcontext,
-              pSurface.get(),
-              ppPlainOptions};
-
-      PHTimer fitTimer("FitTimer");
-      fitTimer.stop();
-      fitTimer.restart();
-
-      auto trackContainer =
-          std::make_shared<Acts::VectorTrackContainer>();
-      auto trackStateContainer =
-          std::make_shared<Acts::VectorMultiTrajectory>();
-      ActsTrackFittingAlgorithm::TrackContainer
-          tracks(trackContainer, trackStateContainer);
-
-      if(Verbosity() > 1)	
-	{  std::cout << "Calling fitTrack for track with siid " << siid << " tpcid " << tpcid << " crossing " << crossing << std::endl; }
-      
-      auto result = fitTrack(sourceLinks, seed, kfOptions,
-                             surfaces, calibrator, tracks);
-      fitTimer.stop();
-      auto fitTime = fitTimer.get_accumulated_time();
+  int charge = tpcseed->get_charge();
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
-      }
+  /// Reset the track seed with the dummy covariance
+  auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
+                  pSurface,
+                  m_transient_geocontext,
+                  actsFourPos,
+                  momentum,
+                  charge / momentum.norm(),
+                  cov,
+                  Acts::ParticleHypothesis::pion())
+                  .value();
 
-      /// Check that the track fit result did not return an error
-      if (result.ok())
-      {
-        if (use_estimate)  // trial variation case
-        {
-          // this is a trial variation of the crossing estimate for this track
-          // Capture the chisq/ndf so we can choose the best one after all trials
+  if (Verbosity() > 2)
+  {
+    printTrackSeed(seed);
+  }
 
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
+  /// Set host of propagator options for Acts to do e.g. material integration
+  Acts::PropagatorPlainOptions ppPlainOptions;
+
+  auto calibptr = std::make_unique<Calibrator>();
+  CalibratorAdapter calibrator{*calibptr, measurements};
+
+  auto magcontext = m_tGeometry->geometry().magFieldContext;
+  auto calibcontext = m_tGeometry->geometry().calibContext;
+
+  ActsTrackFittingAlgorithm::GeneralFitterOptions
+      kfOptions{
+          m_transient_geocontext,
+          magcontext,
+          calibcontext,
+          pSurface.get(),
+          ppPlainOptions};
+
+  PHTimer fitTimer("FitTimer");
+  fitTimer.stop();
+  fitTimer.restart();
+
+  auto trackContainer =
+      std::make_shared<Acts::VectorTrackContainer>();
+  auto trackStateContainer =
+      std::make_shared<Acts::VectorMultiTrajectory>();
+  trial.tracks = std::make_unique<ActsTrackFittingAlgorithm::TrackContainer>(
+      trackContainer, trackStateContainer);
+
+  if(Verbosity() > 1)	
+    {  std::cout << "Calling fitTrack for track with siid " << siid << " tpcid " << tpcid << " crossing " << this_crossing << std::endl; }
+  
+  trial.result.emplace(fitTrack(sourceLinks, seed, kfOptions,
+                                surfaces, calibrator, *trial.tracks, fitCfg));
+  fitTimer.stop();
+  auto fitTime = fitTimer.get_accumulated_time();
 
-          if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-          {
-            float chi2ndf = newTrack.get_quality();
-            chisq_ndf.push_back(chi2ndf);
-            svtx_vec.push_back(newTrack);
-            if (Verbosity() > 1)
-            {
-              std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
-            }
-          }
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+  }
+}
 
-          if (ivary != nvary)
-          {
-            if(Verbosity() > 3)
-            {
-              std::cout << "Skipping track fit for trial variation" << std::endl;
-            }
-            continue;
-          }
+void PHActsTrkFitter::storeTrial(const SeedFit& seedfit, TrialFit& trial,
+                                 std::vector<float>& chisq_ndf, std::vector<SvtxTrack_v4>& svtx_vec)
+{
+  // no fit was attempted for this crossing
+  if (!trial.result)
+  {
+    return;
+  }
 
-          // if we are here this is the last crossing iteration, evaluate the results
-          if (Verbosity() > 1)
-          {
-            std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
-          }
-          float best_chisq = 1000.0;
-          short int best_ivary = 0;
-          for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
-          {
-            if (chisq_ndf[i] < best_chisq)
-            {
-              best_chisq = chisq_ndf[i];
-              best_ivary = i;
-            }
-            if (Verbosity() > 1)
-            {
-              std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
-            }
-          }
-          unsigned int trid = m_trackMap->size();
-          svtx_vec[best_ivary].set_id(trid);
+  auto& result = *trial.result;
+  auto& tracks = *trial.tracks;
+  const auto& measurements = trial.measurements;
+  auto track = seedfit.track;
+  const auto ivary = trial.ivary;
+  const auto this_crossing = trial.crossing;
 
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
-        }
-        else  // case where INTT crossing is known
-        {
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
+  /// Check that the track fit result did not return an error
+  if (result.ok())
+  {
+    if (seedfit.use_estimate)  // trial variation case
+    {
+      // this is a trial variation of the crossing estimate for this track
+      // Capture the chisq/ndf so we can choose the best one after all trials
 
-          if (m_fitSiliconMMs)
-          {
-            unsigned int trid = m_directedTrackMap->size();
-            newTrack.set_id(trid);
+      SvtxTrack_v4 newTrack;
+      newTrack.set_tpc_seed(seedfit.tpcseed);
+      newTrack.set_crossing(this_crossing);
+      newTrack.set_silicon_seed(seedfit.siseed);
 
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for SC calib fit
-          else
-          {
-            unsigned int trid = m_trackMap->size();
-            newTrack.set_id(trid);
+      if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
+      {
+        float chi2ndf = newTrack.get_quality();
+        chisq_ndf.push_back(chi2ndf);
+        svtx_vec.push_back(newTrack);
+        if (Verbosity() > 1)
+        {
+          std::cout << "   tpcid " << seedfit.tpcid << " siid " << seedfit.siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
+        }
+      }
 
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_trackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for normal fit
-        }    // end case where INTT crossing is known
+      if (ivary != seedfit.nvary)
+      {
+        if(Verbosity() > 3)
+        {
+          std::cout << "Skipping track fit for trial variation" << std::endl;
+        }
+        return;
+      }
+
+      // if we are here this is the last crossing iteration, evaluate the results
+      if (Verbosity() > 1)
+      {
+        std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
       }
-      else if (!m_fitSiliconMMs)
+      float best_chisq = 1000.0;
+      short int best_ivary = 0;
+      for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
       {
-        /// Track fit failed, get rid of the track from the map
-        m_nBadFits++;
+        if (chisq_ndf[i] < best_chisq)
+        {
+          best_chisq = chisq_ndf[i];
+          best_ivary = i;
+        }
         if (Verbosity() > 1)
         {
-          std::cout << "Track fit failed for track " << m_seedMap->find(track)
-                    << " with Acts error message "
-                    << result.error() << ", " << result.error().message()
-                    << std::endl;
+          std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
         }
-      }  // end fit failed case
-    }    // end ivary loop
+      }
+      unsigned int trid = m_trackMap->size();
+      svtx_vec[best_ivary].set_id(trid);
 
-    trackTimer.stop();
-    auto trackTime = trackTimer.get_accumulated_time();
+      m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
+    }
+    else  // case where INTT crossing is known
+    {
+      SvtxTrack_v4 newTrack;
+      newTrack.set_tpc_seed(seedfit.tpcseed);
+      newTrack.set_crossing(this_crossing);
+      newTrack.set_silicon_seed(seedfit.siseed);
+
+      if (m_fitSiliconMMs)
+      {
+        unsigned int trid = m_directedTrackMap->size();
+        newTrack.set_id(trid);
+
+        if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
+        {
+          m_directedTrackMap->insertWithKey(&newTrack, trid);
+        }
+      }  // end insert track for SC calib fit
+      else
+      {
+        unsigned int trid = m_trackMap->size();
+        newTrack.set_id(trid);
 
+        if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
+        {
+          m_trackMap->insertWithKey(&newTrack, trid);
+        }
+      }  // end insert track for normal fit
+    }    // end case where INTT crossing is known
+  }
+  else if (!m_fitSiliconMMs)
+  {
+    /// Track fit failed, get rid of the track from the map
+    m_nBadFits++;
     if (Verbosity() > 1)
     {
-      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+      std::cout << "Track fit failed for track " << m_seedMap->find(track)
+                << " with Acts error message "
+                << result.error() << ", " << result.error().message()
+                << std::endl;
     }
-  }
-
-  return;
+  }  // end fit failed case
 }
 
 bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
@@ -936,23 +1075,24 @@ ActsTrackFittingAlgorithm::TrackFitterResult PHActsTrkFitter::fitTrack(
     const ActsTrackFittingAlgorithm::GeneralFitterOptions& kfOptions,
     const SurfacePtrVec& surfSequence,
     const CalibratorAdapter& calibrator,
-    ActsTrackFittingAlgorithm::TrackContainer& tracks)
+    ActsTrackFittingAlgorithm::TrackContainer& tracks,
+    const ActsTrackFittingAlgorithm::Config& fitCfg)
 {
   if (m_fitSiliconMMs)
   {
-    return (*m_fitCfg.dFit)(sourceLinks, seed, kfOptions,
+    return (*fitCfg.dFit)(sourceLinks, seed, kfOptions,
                             surfSequence, calibrator, tracks);
   }
   else
   {
     if(m_directNavigation)
       {
-	return (*m_fitCfg.dFit)(sourceLinks, seed, kfOptions,
+	return (*fitCfg.dFit)(sourceLinks, seed, kfOptions,
 				surfSequence, calibrator, tracks);	
       }
     else
       {
-        return (*m_fitCfg.fit)(sourceLinks, seed, kfOptions,
+        return (*fitCfg.fit)(sourceLinks, seed, kfOptions,
 			       calibrator, tracks);
       }
   }
@@ -15,6 +15,7 @@
 
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/ActsTrackFittingAlgorithm.h>
+#include <trackbase/TrkrThreadPool.h>
 
 #include <tpc/TpcGlobalPositionWrapper.h>
 
@@ -30,11 +31,14 @@
 #include <TH1.h>
 #include <TH2.h>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 class alignmentTransformationContainer;
 class ActsGeometry;
 class SvtxTrack;
+class SvtxTrack_v4;
 class SvtxTrackMap;
 class TrackSeed;
 class TrackSeedContainer;
@@ -141,9 +145,16 @@ class PHActsTrkFitter : public SubsysReco
 
   void set_enable_geometric_crossing_estimate(bool flag) { m_enable_crossing_estimate = flag ; }
   void set_use_clustermover(bool use) { m_use_clustermover = use; }
+  //! cache distortion corrected cluster positions within an event
+  void set_use_cluster_position_cache(bool flag) { m_globalPositionWrapper.set_use_cluster_cache(flag); }
   void ignoreLayer(int layer) { m_ignoreLayer.insert(layer); }
   void setTrkrClusterContainerName(std::string &name){ m_clusterContainerName = name; }
   void setDirectNavigation(bool flag) { m_directNavigation = flag; }
+
+  /// Number of threads used to fit the seeds. 1 (default) fits sequentially,
+  /// 0 uses one thread per hardware thread. The track map does not depend on it.
+  /// Parallel fits require the cluster mover and no outlier finder
+  void set_num_threads(unsigned int n) { m_nthreads = n; }
     
  private:
   /// Get all the nodes
@@ -154,6 +165,49 @@ class PHActsTrkFitter : public SubsysReco
 
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// Fit of one crossing hypothesis of a seed
+  struct TrialFit
+  {
+    short int ivary = 0;
+    short int crossing = 0;
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    std::unique_ptr<ActsTrackFittingAlgorithm::TrackContainer> tracks;
+
+    /// unset if no fit was attempted
+    std::optional<FitResult> result;
+  };
+
+  /// Seeds and crossing hypotheses of one entry of the seed map
+  struct SeedFit
+  {
+    TrackSeed* track = nullptr;
+    TrackSeed* siseed = nullptr;
+    TrackSeed* tpcseed = nullptr;
+    unsigned int tpcid = 0;
+    unsigned int siid = 0;
+    short int crossing_estimate = 0;
+    short int nvary = 0;
+    bool use_estimate = false;
+
+    /// trial fits, filled in parallel mode only
+    std::vector<std::unique_ptr<TrialFit>> trials;
+  };
+
+  /// Fit all seeds with the thread pool, then store them in seed order
+  void loopTracksParallel();
+
+  /// Get seeds and crossing hypotheses, returns false if the seed must be skipped
+  bool getSeedFit(TrackSeed* track, SeedFit& seedfit) const;
+
+  /// Make source links and fit one crossing hypothesis with the given fitter.
+  /// Does not modify the track maps and can run concurrently with the cluster mover
+  void fitTrial(const SeedFit& seedfit, short int ivary, TrialFit& trial,
+                const ActsTrackFittingAlgorithm::Config& fitCfg);
+
+  /// Convert trial fit result and store it in the track map
+  void storeTrial(const SeedFit& seedfit, TrialFit& trial,
+                  std::vector<float>& chisq_ndf, std::vector<SvtxTrack_v4>& svtx_vec);
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                        Trajectory::IndexedParameters& paramsMap,
@@ -169,7 +223,8 @@ class PHActsTrkFitter : public SubsysReco
           kfOptions,
       const SurfacePtrVec& surfSequence,
       const CalibratorAdapter& calibrator,
-      ActsTrackFittingAlgorithm::TrackContainer& tracks);
+      ActsTrackFittingAlgorithm::TrackContainer& tracks,
+      const ActsTrackFittingAlgorithm::Config& fitCfg);
 
   /// Functions to get list of sorted surfaces for direct navigation, if
   /// applicable
@@ -194,6 +249,15 @@ class PHActsTrkFitter : public SubsysReco
   /// Configuration containing the fitting function instance
   ActsTrackFittingAlgorithm::Config m_fitCfg;
 
+  /// Number of fit threads, see set_num_threads
+  unsigned int m_nthreads = 1;
+
+  /// Worker threads for parallel fits, null when fitting sequentially
+  std::unique_ptr<TrkrThreadPool> m_threadPool;
+
+  /// Fitting function instances, one per worker
+  std::vector<ActsTrackFittingAlgorithm::Config> m_workerFitCfg;
+
   /// TrackMap containing SvtxTracks
   alignmentTransformationContainer* m_alignmentTransformationMap = nullptr;  // added for testing purposes
   alignmentTransformationContainer* m_alignmentTransformationMapTransient = nullptr;
@@ -13,10 +13,9 @@
 #include <trackbase_historic/TrackSeedContainer.h>
 #include <trackbase_historic/TrackSeedHelper.h>
 
+#include <algorithm>  // for sort, count
 #include <cmath>     // for sqrt, fabs, atan2, cos
 #include <iostream>  // for operator<<, basic_ostream
-#include <map>       // for map
-#include <set>       // for _Rb_tree_const_iterator
 #include <utility>   // for pair, make_pair
 
 //____________________________________________________________________________..
@@ -102,54 +101,45 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
   }
 
   // Elimate low-interest track, and try to eliminate repeated tracks
-  std::set<unsigned int> matches_set;
-  std::multimap<unsigned int, unsigned int> matches;
-  for (size_t trid1 = 0; trid1 < seeds.size(); ++trid1)
+  std::vector<SeedSummary> summaries(seeds.size());
+  for (unsigned int i = 0; i < seeds.size(); ++i)
   {
-    if (m_rejected[trid1]) { continue; }
-    const auto& track1 = seeds[trid1];
-    const float track1phi = track1.get_phi();
+    if (m_rejected[i]) { continue; }
+    summaries[i].phi = seeds[i].get_phi();
+    summaries[i].eta = seeds[i].get_eta();
+    summaries[i].position = TrackSeedHelper::get_xyz(&seeds[i]);
+  }
 
-    const auto track1_pos = TrackSeedHelper::get_xyz(&track1);
-    const float track1eta = track1.get_eta();
-    for (size_t trid2 = trid1+1; trid2 < seeds.size(); ++trid2)
+  const auto matches = find_matches(summaries);
+  if (_check_all_pairs)
+  {
+    const auto all_pairs = find_matches_all_pairs(summaries);
+    if (all_pairs != matches)
     {
-      if (m_rejected[trid2])
-      {
-        continue;
-      }
-
-      const auto& track2 = seeds[trid2];
-      const auto track2_pos = TrackSeedHelper::get_xyz(&track2);
-      const float track2eta = track2.get_eta();
-      auto delta_phi = std::abs(track1phi - track2.get_phi());
-
-      if (delta_phi > 2 * M_PI) {
-        delta_phi = delta_phi - 2*M_PI;
-      }
-      if (delta_phi < _phi_cut &&
-          std::abs(track1eta - track2eta) < _eta_cut &&
-          std::abs(track1_pos.x() - track2_pos.x()) < _x_cut &&
-          std::abs(track1_pos.y() - track2_pos.y()) < _y_cut &&
-          std::abs(track1_pos.z() - track2_pos.z()) < _z_cut)
-      {
-        matches_set.insert(trid1);
-        matches.insert(std::pair(trid1, trid2));
-
-        if (m_verbosity > 1)
-        {
-          std::cout << "Found match for tracks " << trid1 << " and " << trid2 << std::endl;
-        }
-      }
+      std::cout << "PHGhostRejection::find_ghosts - sorted sweep found " << matches.size()
+                << " matches, comparing all pairs found " << all_pairs.size() << std::endl;
+    }
+    else if (m_verbosity > 0)
+    {
+      std::cout << "PHGhostRejection::find_ghosts - sorted sweep and all pairs agree on " << matches.size() << " matches" << std::endl;
     }
   }
 
-  for (auto set_it : matches_set)
+  // matches are sorted, so all matches of a track are next to each other
+  for (auto match_begin = matches.begin(); match_begin != matches.end();)
   {
+    const unsigned int set_it = match_begin->first;
+    auto match_end = match_begin;
+    while (match_end != matches.end() && match_end->first == set_it)
+    {
+      ++match_end;
+    }
+    const auto match_list = std::make_pair(match_begin, match_end);
+    match_begin = match_end;
+
     if (m_rejected[set_it]) { continue; } // already rejected
-    auto match_list = matches.equal_range(set_it);
 
-    auto tr1 = seeds[set_it];
+    const auto& tr1 = seeds[set_it];
     double best_qual = trackChi2.at(set_it);
     unsigned int best_track = set_it;
 
@@ -165,7 +155,7 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
         std::cout << "    match of track " << it->first << " to track " << it->second << std::endl;
       }
 
-      auto tr2 = seeds[it->second];
+      const auto& tr2 = seeds[it->second];
 
       // Check that these two tracks actually share the same clusters, if not skip this pair
       bool is_same_track = checkClusterSharing(tr1, tr2);
@@ -234,6 +224,97 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
   }
 }
 
+PHGhostRejection::MatchList PHGhostRejection::find_matches(const std::vector<SeedSummary>& summaries) const
+{
+  // sort the seeds in phi, so that only neighbours closer than the phi cut need to be compared.
+  // seeds with NaN phi never pass the phi cut and are left out
+  std::vector<unsigned int> order;
+  order.reserve(seeds.size());
+  for (unsigned int i = 0; i < seeds.size(); ++i)
+  {
+    if (!m_rejected[i] && !std::isnan(summaries[i].phi))
+    {
+      order.push_back(i);
+    }
+  }
+  if (order.empty())
+  {
+    return {};
+  }
+  std::sort(order.begin(), order.end(), [&summaries](unsigned int i1, unsigned int i2)
+    { return summaries[i1].phi < summaries[i2].phi || (summaries[i1].phi == summaries[i2].phi && i1 < i2); });
+
+  // the all pairs comparison takes off 2 pi once from phi differences above 2 pi.
+  // that can only matter if the seeds span more than 2 pi, which the sweep does not handle
+  const float phi_span = summaries[order.back()].phi - summaries[order.front()].phi;
+  if (phi_span > 2 * M_PI)
+  {
+    return find_matches_all_pairs(summaries);
+  }
+
+  MatchList matches;
+  for (auto it1 = order.begin(); it1 != order.end(); ++it1)
+  {
+    const auto& seed1 = summaries[*it1];
+    for (auto it2 = it1 + 1; it2 != order.end(); ++it2)
+    {
+      const auto& seed2 = summaries[*it2];
+      // same float difference as in the all pairs comparison, and it only grows along the sorted seeds
+      const float delta_phi = seed2.phi - seed1.phi;
+      if (!(delta_phi < _phi_cut))
+      {
+        break;
+      }
+      if (in_windows(seed1, seed2))
+      {
+        matches.emplace_back(std::min(*it1, *it2), std::max(*it1, *it2));
+      }
+    }
+  }
+  std::sort(matches.begin(), matches.end());
+
+  if (m_verbosity > 1)
+  {
+    for (const auto& [trid1, trid2] : matches)
+    {
+      std::cout << "Found match for tracks " << trid1 << " and " << trid2 << std::endl;
+    }
+  }
+  return matches;
+}
+
+PHGhostRejection::MatchList PHGhostRejection::find_matches_all_pairs(const std::vector<SeedSummary>& summaries) const
+{
+  MatchList matches;
+  for (unsigned int trid1 = 0; trid1 < seeds.size(); ++trid1)
+  {
+    if (m_rejected[trid1]) { continue; }
+    const auto& seed1 = summaries[trid1];
+    for (unsigned int trid2 = trid1 + 1; trid2 < seeds.size(); ++trid2)
+    {
+      if (m_rejected[trid2]) { continue; }
+      const auto& seed2 = summaries[trid2];
+      auto delta_phi = std::abs(seed1.phi - seed2.phi);
+      if (delta_phi > 2 * M_PI) {
+        delta_phi = delta_phi - 2*M_PI;
+      }
+      if (delta_phi < _phi_cut && in_windows(seed1, seed2))
+      {
+        matches.emplace_back(trid1, trid2);
+      }
+    }
+  }
+  return matches;
+}
+
+bool PHGhostRejection::in_windows(const SeedSummary& seed1, const SeedSummary& seed2) const
+{
+  return std::abs(seed1.eta - seed2.eta) < _eta_cut &&
+         std::abs(seed1.position.x() - seed2.position.x()) < _x_cut &&
+         std::abs(seed1.position.y() - seed2.position.y()) < _y_cut &&
+         std::abs(seed1.position.z() - seed2.position.z()) < _z_cut;
+}
+
 // there is no check, at this point, about which is the best chi2 track
 bool PHGhostRejection::checkClusterSharing(const TrackSeed& tr1, const TrackSeed& tr2) const
 {
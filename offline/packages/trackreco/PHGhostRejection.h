@@ -15,9 +15,13 @@
 #include <trackbase/ActsTrackingGeometry.h>
 #include <trackbase_historic/TrackSeed_v2.h>
 
+#include <Acts/Definitions/Algebra.hpp>
 
+#include <cmath>
+#include <limits>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 class PHCompositeNode;
@@ -58,7 +62,30 @@ class PHGhostRejection
   void set_y_cut(double d) { _y_cut = d; }
   void set_z_cut(double d) { _z_cut = d; }
 
+  // also run the pairwise comparison of all seeds and report if the matches differ (slow, for validation)
+  void set_check_all_pairs(bool b) { _check_all_pairs = b; }
+
+  // pairs of seeds (first < second) within the phi, eta, x, y and z windows, sorted
+  using MatchList = std::vector<std::pair<unsigned int, unsigned int>>;
+
  private:
+  // per seed quantities used for matching, computed once instead of once per pair
+  struct SeedSummary
+  {
+    float phi = NAN;
+    float eta = NAN;
+    Acts::Vector3 position;
+  };
+
+  // candidate matches from a sweep over seeds sorted in phi
+  MatchList find_matches(const std::vector<SeedSummary>& summaries) const;
+
+  // candidate matches from comparing every pair of seeds
+  MatchList find_matches_all_pairs(const std::vector<SeedSummary>& summaries) const;
+
+  // eta and position windows, the phi window is checked by the callers
+  bool in_windows(const SeedSummary& seed1, const SeedSummary& seed2) const;
+
   unsigned int m_verbosity;
   const std::vector<TrackSeed_v2>& seeds;
   std::vector<bool> m_rejected {}; // id
@@ -74,6 +101,8 @@ class PHGhostRejection
   bool   _must_span_sectors = false;
   size_t _min_clusters = 3;
 
+  bool _check_all_pairs = false;
+
 
   /* TrackSeedContainer *m_trackMap = nullptr; */
 
@@ -32,6 +32,7 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
+#include <algorithm>
 #include <climits>   // for UINT_MAX
 #include <cmath>     // for fabs, sqrt
 #include <iostream>  // for operator<<, basic_ostream
@@ -174,6 +175,27 @@ bool PHSiliconTpcTrackMatching::WindowMatcher::in_window
   }
 }
 
+double PHSiliconTpcTrackMatching::WindowMatcher::max_abs_delta
+(const bool posQ, const double tpc_pt)
+{
+  // same pT and window functions as in_window
+  if (posQ) {
+    double pt = (tpc_pt<min_pt_posQ) ? min_pt_posQ : tpc_pt;
+    if (fabs_max_posQ) {
+      return fn_exp(posHi, posHi_b0, pt);
+    } else {
+      return std::max(fabs(fn_exp(posLo, posLo_b0, pt)), fabs(fn_exp(posHi, posHi_b0, pt)));
+    }
+  } else {
+    double pt = (tpc_pt<min_pt_negQ) ? min_pt_negQ : tpc_pt;
+    if (fabs_max_negQ) {
+      return fn_exp(negHi, negHi_b0, pt);
+    } else {
+      return std::max(fabs(fn_exp(negLo, negLo_b0, pt)), fabs(fn_exp(negHi, negHi_b0, pt)));
+    }
+  }
+}
+
 //____________________________________________________________________________..
 int PHSiliconTpcTrackMatching::process_event(PHCompositeNode * /*unused*/)
 {
@@ -378,6 +400,11 @@ double PHSiliconTpcTrackMatching::getBunchCrossing(unsigned int trid, double z_m
 
 int PHSiliconTpcTrackMatching::End(PHCompositeNode * /*unused*/)
 {
+  if (Verbosity() > 0)
+  {
+    cout << "PHSiliconTpcTrackMatching::End - tested " << _n_candidate_pairs_total << " TPC-silicon seed pairs out of " << _n_all_pairs_total << endl;
+  }
+
   if(_test_windows)
   {
   _file->cd();
@@ -467,6 +494,12 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
     std::set<unsigned int> &tpc_unmatched_set,
     std::multimap<unsigned int, unsigned int> &tpc_matches)
 {
+  // silicon seed parameters and (eta, phi) grid
+  fillSiliconSeedGrid();
+  _n_candidate_pairs = 0;
+
+  std::vector<unsigned int> candidates;
+
   // loop over the TPC track seeds
   for (unsigned int phtrk_iter = 0;
        phtrk_iter < _track_map->size();
@@ -537,47 +570,42 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
 
     bool matched = false;
 
-    // Now search the silicon track list for a match in eta and phi
-    for (unsigned int phtrk_iter_si = 0;
-         phtrk_iter_si < _track_map_silicon->size();
-         ++phtrk_iter_si)
+    // Get the silicon seeds to test
+    // with the window printout all pairs go to the tree, otherwise only the grid cells in the eta and phi windows are tested
+    candidates.clear();
+    if (_test_windows)
     {
-      _tracklet_si = _track_map_silicon->get(phtrk_iter_si);
-      if (!_tracklet_si)
+      for (unsigned int siid = 0; siid < _si_seed_params.size(); ++siid)
       {
-
-        continue;
+        candidates.push_back(siid);
       }
+    }
+    else
+    {
+      const double deta_max = std::max(window_deta.max_abs_delta(is_posQ, tpc_pt), (double) _deltaeta_min);
+      const double dphi_max = window_dphi.max_abs_delta(is_posQ, tpc_pt);
+      getSiliconCandidates(tpc_eta, deta_max, tpc_phi, dphi_max, candidates);
+    }
+    _n_candidate_pairs += candidates.size();
 
-      double si_phi, si_eta, si_pt;
-      float si_px, si_py, si_pz;
-      int si_q;
-      Acts::Vector3 si_pos;
-      if (_zero_field) {
-      auto cluster_list = getTrackletClusterList(_tracklet_si);
-
-      Acts::Vector3  mom;
-      bool ok_track;
-
-      std::tie(ok_track, si_phi, si_eta, si_pt, si_pos, mom) =
-        TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
-      if (!ok_track) { continue; }
-        si_px = mom.x();
-        si_py = mom.y();
-        si_pz = mom.z();
-        si_q = -100;
-      } else {
-        si_eta = _tracklet_si->get_eta();
-        si_phi = _tracklet_si->get_phi();
-
-        si_pos = TrackSeedHelper::get_xyz(_tracklet_si);
-        si_px = _tracklet_si->get_px();
-        si_py = _tracklet_si->get_py();
-        si_pz = _tracklet_si->get_pz();
-        si_q = _tracklet_si->get_charge();
+    // Now search the silicon track list for a match in eta and phi
+    for (const auto siid : candidates)
+    {
+      const auto &si_params = _si_seed_params[siid];
+      if (!si_params.valid)
+      {
+        continue;
       }
+      _tracklet_si = _track_map_silicon->get(siid);
+
+      const double si_phi = si_params.phi;
+      const double si_eta = si_params.eta;
+      const Acts::Vector3 &si_pos = si_params.pos;
+      const float si_px = si_params.px;
+      const float si_py = si_params.py;
+      const float si_pz = si_params.pz;
+      const int si_q = si_params.q;
       int si_crossing = _tracklet_si->get_crossing();
-      unsigned int siid = phtrk_iter_si;
 
       if(_test_windows)
       {
@@ -679,8 +707,145 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
     }
   }
 
+  _n_candidate_pairs_total += _n_candidate_pairs;
+  _n_all_pairs_total += static_cast<unsigned long>(_track_map->size()) * _track_map_silicon->size();
+  if (Verbosity() > 0)
+  {
+    cout << "PHSiliconTpcTrackMatching::findEtaPhiMatches - tested " << _n_candidate_pairs << " TPC-silicon seed pairs out of "
+         << static_cast<unsigned long>(_track_map->size()) * _track_map_silicon->size() << endl;
+  }
+
   return;
 }
+
+//_________________________________________________________________________________
+void PHSiliconTpcTrackMatching::fillSiliconSeedGrid()
+{
+  _si_seed_params.assign(_track_map_silicon->size(), SiliconSeedParams());
+  _si_seed_grid.resize(_grid_neta * _grid_nphi);
+  for (auto &cell : _si_seed_grid)
+  {
+    cell.clear();
+  }
+
+  for (unsigned int siid = 0; siid < _track_map_silicon->size(); ++siid)
+  {
+    TrackSeed *si_seed = _track_map_silicon->get(siid);
+    if (!si_seed)
+    {
+      continue;
+    }
+
+    auto &params = _si_seed_params[siid];
+    if (_zero_field)
+    {
+      auto cluster_list = getTrackletClusterList(si_seed);
+
+      Acts::Vector3 mom;
+      bool ok_track;
+      double si_pt;
+
+      std::tie(ok_track, params.phi, params.eta, si_pt, params.pos, mom) =
+          TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
+      if (!ok_track)
+      {
+        continue;
+      }
+      params.px = mom.x();
+      params.py = mom.y();
+      params.pz = mom.z();
+      params.q = -100;
+    }
+    else
+    {
+      params.eta = si_seed->get_eta();
+      params.phi = si_seed->get_phi();
+
+      params.pos = TrackSeedHelper::get_xyz(si_seed);
+      params.px = si_seed->get_px();
+      params.py = si_seed->get_py();
+      params.pz = si_seed->get_pz();
+      params.q = si_seed->get_charge();
+    }
+    params.valid = true;
+
+    // seeds with undefined direction can not pass the windows
+    if (!std::isfinite(params.eta) || !std::isfinite(params.phi))
+    {
+      continue;
+    }
+    _si_seed_grid[getEtaBin(params.eta) * _grid_nphi + getPhiBin(params.phi)].push_back(siid);
+  }
+}
+
+//_________________________________________________________________________________
+int PHSiliconTpcTrackMatching::getEtaBin(double eta) const
+{
+  const int bin = std::floor((eta - _grid_eta_min) * _grid_neta / (_grid_eta_max - _grid_eta_min));
+  return std::clamp(bin, 0, _grid_neta - 1);
+}
+
+//_________________________________________________________________________________
+int PHSiliconTpcTrackMatching::getPhiBin(double phi) const
+{
+  // wrap to [0, 2pi)
+  phi = std::fmod(phi, 2 * M_PI);
+  if (phi < 0)
+  {
+    phi += 2 * M_PI;
+  }
+  const int bin = std::floor(phi * _grid_nphi / (2 * M_PI));
+  return std::clamp(bin, 0, _grid_nphi - 1);
+}
+
+//_________________________________________________________________________________
+void PHSiliconTpcTrackMatching::getSiliconCandidates(double tpc_eta, double deta_max, double tpc_phi, double dphi_max, std::vector<unsigned int> &candidates) const
+{
+  // no match is possible for an undefined TPC direction
+  if (!std::isfinite(tpc_eta) || !std::isfinite(tpc_phi))
+  {
+    return;
+  }
+
+  // small margin against rounding at the window edges
+  static constexpr double margin = 1e-6;
+  deta_max += margin;
+  dphi_max += margin;
+
+  // eta range. Bins are clamped, so that seeds outside of the grid range are kept
+  int eta_low = 0;
+  int eta_high = _grid_neta - 1;
+  if (std::isfinite(deta_max))
+  {
+    eta_low = getEtaBin(tpc_eta - deta_max);
+    eta_high = getEtaBin(tpc_eta + deta_max);
+  }
+
+  // phi range, wrapped around. The matching accepts dphi shifted by 2pi,
+  // so any accepted pair is within dphi_max of the TPC seed on the circle
+  const double phi_bin_width = 2 * M_PI / _grid_nphi;
+  int phi_low = 0;
+  int nphi = _grid_nphi;
+  if (std::isfinite(dphi_max) && 2 * dphi_max < 2 * M_PI - 2 * phi_bin_width)
+  {
+    phi_low = getPhiBin(tpc_phi - dphi_max);
+    const int phi_high = getPhiBin(tpc_phi + dphi_max);
+    nphi = (phi_high - phi_low + _grid_nphi) % _grid_nphi + 1;
+  }
+
+  for (int ieta = eta_low; ieta <= eta_high; ++ieta)
+  {
+    for (int i = 0; i < nphi; ++i)
+    {
+      const int iphi = (phi_low + i) % _grid_nphi;
+      const auto &cell = _si_seed_grid[ieta * _grid_nphi + iphi];
+      candidates.insert(candidates.end(), cell.begin(), cell.end());
+    }
+  }
+
+  // keep the silicon seed order of the full loop
+  std::sort(candidates.begin(), candidates.end());
+}
 void PHSiliconTpcTrackMatching::checkZMatches(
     std::multimap<unsigned int, unsigned int> &tpc_matches,
     std::multimap<unsigned int, unsigned int> &bad_map)
@@ -10,6 +10,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class TrackSeedContainer;
@@ -86,6 +87,9 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
 
     bool in_window(bool posQ, const double tpc_pt, const double tpc_X, const double si_X);
 
+    // largest |deltaX| that can pass in_window for this charge and pT, used to bound the candidate search
+    double max_abs_delta(bool posQ, const double tpc_pt);
+
     // initialize to fn_lo < deltaX < fn_hi for +Q, and fn_lo < deltaX < fn_hi for -Q
 
     void reset_fns() {
@@ -212,6 +216,42 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   std::string _silicon_track_map_name = "SiliconTrackSeedContainer";
   std::string m_fieldMap = "1.4";
   std::vector<TrkrDefs::cluskey> getTrackletClusterList(TrackSeed* tracklet);
+
+  // silicon seed parameters, calculated once per event
+  struct SiliconSeedParams
+  {
+    bool valid = false;
+    double phi = 0;
+    double eta = 0;
+    Acts::Vector3 pos = Acts::Vector3::Zero();
+    float px = 0;
+    float py = 0;
+    float pz = 0;
+    int q = 0;
+  };
+  std::vector<SiliconSeedParams> _si_seed_params;
+
+  // silicon seed indices binned in (eta, phi), so that each TPC seed only tests the seeds close to it
+  // seeds outside of the eta range go to the first or last eta bin
+  static constexpr int _grid_neta = 60;
+  static constexpr double _grid_eta_min = -1.5;
+  static constexpr double _grid_eta_max = 1.5;
+  static constexpr int _grid_nphi = 64;
+  std::vector<std::vector<unsigned int>> _si_seed_grid;
+
+  // calculate the silicon seed parameters and fill the grid
+  void fillSiliconSeedGrid();
+
+  // sorted silicon seed indices in the grid cells overlapping |deta| < deta_max and |dphi| < dphi_max
+  void getSiliconCandidates(double tpc_eta, double deta_max, double tpc_phi, double dphi_max, std::vector<unsigned int> &candidates) const;
+
+  int getEtaBin(double eta) const;
+  int getPhiBin(double phi) const;
+
+  // number of TPC-silicon pairs tested in findEtaPhiMatches
+  unsigned long _n_candidate_pairs = 0;
+  unsigned long _n_candidate_pairs_total = 0;
+  unsigned long _n_all_pairs_total = 0;
 };
 
 #endif  //  PHSILICONTPCTRACKMATCHING_H
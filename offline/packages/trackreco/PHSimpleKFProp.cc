@@ -1351,6 +1351,7 @@ void PHSimpleKFProp::rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, con
   rejector.set_x_cut(_ghost_x_cut);
   rejector.set_y_cut(_ghost_y_cut);
   rejector.set_z_cut(_ghost_z_cut);
+  rejector.set_check_all_pairs(_ghost_check_all_pairs);
   // If you want to reject tracks (before they are are made) can set them here:
   // rejector.set_min_pt_cut(0.2);
   // rejector.set_must_span_sectors(true);
@@ -94,6 +94,9 @@ class PHSimpleKFProp : public SubsysReco
   void set_ghost_y_cut(double d) { _ghost_y_cut = d; }
   void set_ghost_z_cut(double d) { _ghost_z_cut = d; }
 
+  //! cross-check the ghost matching against the comparison of all seed pairs (slow)
+  void set_ghost_check_all_pairs(bool b) { _ghost_check_all_pairs = b; }
+
   // number of threads
   void set_num_threads(int value) { m_num_threads = value; }
 
@@ -239,6 +242,7 @@ class PHSimpleKFProp : public SubsysReco
   double _ghost_x_cut = std::numeric_limits<double>::max();
   double _ghost_y_cut = std::numeric_limits<double>::max();
   double _ghost_z_cut = std::numeric_limits<double>::max();
+  bool _ghost_check_all_pairs = false;
   //@}
 
   //! number of threads
@@ -23,9 +23,12 @@
 
 #include <Acts/Surfaces/PerigeeSurface.hpp>
 
+#include <omp.h>
+
 #include <cmath>  // for sqrt, fabs, atan2, cos
 #include <iomanip>
 #include <iostream>  // for operator<<, basic_ostream
+#include <limits>
 #include <map>       // for map
 #include <set>       // for _Rb_tree_const_iterator
 #include <utility>   // for pair, make_pair
@@ -74,8 +77,6 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
     std::cout << PHWHERE << " track map size " << _track_map->size() << std::endl;
   }
 
-  _active_dcacut = _base_dcacut;
-
   // in case these objects are in the input file, we clear the nodes and replace them
     _svtx_vertex_map->Reset();
     _track_vertex_crossing_map->Reset();
@@ -109,10 +110,27 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
     _track_vertex_crossing_map->addTrackAssoc(crossing, trackkey);    
   }
   
+  // Find all instances where two tracks have a dca of < _dcacut, and capture the pair details.
+  // Crossings are independent, so the pairs are searched for in parallel
+  std::vector<short int> crossing_list(crossings.begin(), crossings.end());
+  std::vector<std::vector<TrackPair>> crossing_pairs(crossing_list.size());
+  if (!_zero_field)
+  {
+    // single thread for the detailed printout of the pair search
+    const int nthreads = (Verbosity() > 3) ? 1 : ((m_num_threads >= 1) ? m_num_threads : omp_get_max_threads());
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (size_t icross = 0; icross < crossing_list.size(); ++icross)
+    {
+      crossing_pairs[icross] = findTrackPairs(crossing_list[icross]);
+    }
+  }
+
   unsigned int vertex_id = 0;
 
-  for (auto cross : crossings)
+  for (size_t icross = 0; icross < crossing_list.size(); ++icross)
   {
+    const short int cross = crossing_list[icross];
+
     // reset maps for each crossing
     _vertex_track_map.clear();
     _track_pair_map.clear();
@@ -126,45 +144,45 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
       std::cout << "process tracks for beam crossing " << cross << std::endl;
     }
 
-    // get the subset of tracks for this crossing
+    // the subset of tracks for this crossing
     auto crossing_track_index = _track_vertex_crossing_map->getTracks(cross);
-    SvtxTrackMap *crossing_tracks = new SvtxTrackMap_v2;
-    for (auto iter = crossing_track_index.first; iter != crossing_track_index.second; ++iter)
+
+    if (_zero_field)
     {
-      unsigned int trackkey = (*iter).second;
-      SvtxTrack *track = _track_map->get(trackkey);
-      if(!track)
+      SvtxTrackMap *crossing_tracks = new SvtxTrackMap_v2;
+      for (auto iter = crossing_track_index.first; iter != crossing_track_index.second; ++iter)
       {
-        continue;
+        unsigned int trackkey = (*iter).second;
+        SvtxTrack *track = _track_map->get(trackkey);
+        if (!track)
+        {
+          continue;
+        }
+        crossing_tracks->insertWithKey(track, trackkey);
       }
-      crossing_tracks->insertWithKey(track, trackkey);
-    }
 
-    // Find all instances where two tracks have a dca of < _dcacut,  and capture the pair details
-    // Fills _track_pair_map and _track_pair_pca_map
-    if(_zero_field)
+      // Fills _track_pair_map and _track_pair_pca_map
+      _active_dcacut = _base_dcacut;
+      checkDCAsZF(crossing_tracks);
+
+      /// If we didn't find any matches, try again with a slightly larger DCA cut
+      if (_track_pair_map.size() == 0)
       {
-	checkDCAsZF(crossing_tracks);
+        _active_dcacut = 3.0 * _base_dcacut;
+        checkDCAsZF(crossing_tracks);
       }
+      delete crossing_tracks;
+    }
     else
+    {
+      // pairs are sorted in track id, same order as the pair loop over the track map
+      for (const auto &pair : crossing_pairs[icross])
       {
-	checkDCAs(crossing_tracks);
+        _track_pair_map.insert(std::make_pair(pair.id1, std::make_pair(pair.id2, pair.dca)));
+        _track_pair_pca_map.insert(std::make_pair(pair.id1, std::make_pair(pair.id2, std::make_pair(pair.pca1, pair.pca2))));
       }
-
-    /// If we didn't find any matches, try again with a slightly larger DCA cut
-    if (_track_pair_map.size() == 0)
-    {
-      _active_dcacut = 3.0 * _base_dcacut;
-      if(_zero_field)
-	{
-	  checkDCAsZF(crossing_tracks);
-	}
-      else
-	{
-	  checkDCAs(crossing_tracks);
-	}
     }
-    
+
     if (Verbosity() > 0)
     {
       std::cout << "crossing " << cross << " track pair map size " << _track_pair_map.size() << std::endl;
@@ -294,9 +312,14 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
     /// tracks that were missed or were not  compatible with any of the
     /// identified vertices
     //=================================================
-    for (const auto &[trackkey, track] : *crossing_tracks)
+    for (auto iter = crossing_track_index.first; iter != crossing_track_index.second; ++iter)
     {
-      auto thistrack = _track_map->get(trackkey);  // get the original, not the copy
+      unsigned int trackkey = (*iter).second;
+      auto thistrack = _track_map->get(trackkey);
+      if (!thistrack)
+      {
+        continue;
+      }
       auto vtxid = thistrack->get_vertex_id();
       if (Verbosity() > 1)
       {
@@ -340,9 +363,6 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
         }
       }
     }
-
-    delete crossing_tracks;
-
   }  // end loop over crossings
 
   // update the crossing vertex map with the results
@@ -470,95 +490,100 @@ int PHSimpleVertexFinder::GetNodes(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void PHSimpleVertexFinder::checkDCAs(SvtxTrackMap *track_map)
+std::vector<PHSimpleVertexFinder::TrackPair> PHSimpleVertexFinder::findTrackPairs(short int crossing) const
 {
-  // Loop over tracks and check for close DCA match with all other tracks
-  for (auto tr1_it = track_map->begin(); tr1_it != track_map->end(); ++tr1_it)
+  // tracks of this crossing that can be used for a vertex, track cuts are evaluated only once per track
+  std::vector<PairCandidate> candidates;
+  auto crossing_track_index = _track_vertex_crossing_map->getTracks(crossing);
+  for (auto iter = crossing_track_index.first; iter != crossing_track_index.second; ++iter)
   {
-    auto id1 = tr1_it->first;
-    auto tr1 = tr1_it->second;
-    if (tr1->get_quality() > _qual_cut)
+    unsigned int trackkey = (*iter).second;
+    SvtxTrack *track = _track_map->get(trackkey);
+    if (!track || !passTrackCuts(trackkey, track))
     {
       continue;
     }
-    if (_require_mvtx)
-    {
-      unsigned int nmvtx = 0;
-      TrackSeed *siliconseed = tr1->get_silicon_seed();
-      if (!siliconseed)
-      {
-        continue;
-      }
 
-      for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
-      {
-        if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-        {
-          nmvtx++;
-        }
-        if (nmvtx >= _nmvtx_required)
-        {
-          break;
-        }
-      }
-      if (nmvtx < _nmvtx_required)
-      {
-        continue;
-      }
-      if (Verbosity() > 3)
-      {
-        std::cout << " tr1 id " << id1 << " has nmvtx at least " << nmvtx << std::endl;
-      }
+    PairCandidate cand;
+    cand.id = trackkey;
+    cand.position = Eigen::Vector3d(track->get_x(), track->get_y(), track->get_z());
+    cand.direction = Eigen::Vector3d(track->get_px() / track->get_p(), track->get_py() / track->get_p(), track->get_pz() / track->get_p());
+    if (!cand.position.allFinite() || !cand.direction.allFinite())
+    {
+      // no DCA can be calculated for this track
+      continue;
     }
 
-    // look for close DCA matches with all other such tracks
-    for (auto tr2_it = std::next(tr1_it); tr2_it != track_map->end(); ++tr2_it)
+    // z and cot(theta) of the track line where it is closest to the beam line
+    const double bt2 = cand.direction.x() * cand.direction.x() + cand.direction.y() * cand.direction.y();
+    if (bt2 > 0)
     {
-      auto id2 = tr2_it->first;
-      auto tr2 = tr2_it->second;
-      if (tr2->get_quality() > _qual_cut)
-      {
-        continue;
-      }
-      if (_require_mvtx)
-      {
-        unsigned int nmvtx = 0;
-        TrackSeed *siliconseed = tr2->get_silicon_seed();
-        if (!siliconseed)
-        {
-          continue;
-        }
+      const double s = -(cand.position.x() * cand.direction.x() + cand.position.y() * cand.direction.y()) / bt2;
+      cand.z_beam = cand.position.z() + s * cand.direction.z();
+      cand.cot_theta = std::abs(cand.direction.z()) / std::sqrt(bt2);
+    }
+    else
+    {
+      cand.z_beam = cand.position.z();
+      cand.cot_theta = std::numeric_limits<double>::infinity();
+    }
+    candidates.push_back(cand);
+  }
 
-        for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
-        {
-          if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-          {
-            nmvtx++;
-          }
-          if (nmvtx >= _nmvtx_required)
-          {
-            break;
-          }
-        }
-        if (nmvtx < _nmvtx_required)
-        {
-          continue;
-        }
-        if (Verbosity() > 3)
-        {
-          std::cout << " tr2 id " << id2 << " has nmvtx at least " << nmvtx << std::endl;
-        }
-      }
+  std::vector<TrackPair> pairs = checkDCAs(candidates, _base_dcacut);
 
-      // find DCA of these two tracks
-      if (Verbosity() > 3)
+  /// If we didn't find any matches, try again with a slightly larger DCA cut
+  if (pairs.empty())
+  {
+    pairs = checkDCAs(candidates, 3.0 * _base_dcacut);
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "crossing " << crossing << " " << candidates.size() << " tracks pass the track cuts, "
+              << pairs.size() << " track pairs found" << std::endl;
+  }
+
+  return pairs;
+}
+
+std::vector<PHSimpleVertexFinder::TrackPair> PHSimpleVertexFinder::checkDCAs(std::vector<PairCandidate> candidates, double dcacut) const
+{
+  // A good pair has PCA1 within _beamline_xy_cut of the beam line in x and y, and PCA2 within dcacut of PCA1.
+  // So both PCAs are less than rmax from the beam line, which limits how far (rmax * |cot(theta)|) they are in z
+  // from the point where the track is closest to the beam line. Only tracks with overlapping z ranges are compared
+  const double rmax = std::sqrt(2.) * _beamline_xy_cut + dcacut;
+  for (auto &cand : candidates)
+  {
+    // the extra dcacut covers the z distance between PCA1 and PCA2, 1% margin for rounding
+    const double halfwidth = 1.01 * (rmax * cand.cot_theta + dcacut);
+    cand.z_low = cand.z_beam - halfwidth;
+    cand.z_high = cand.z_beam + halfwidth;
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const PairCandidate &a, const PairCandidate &b)
+            { return a.z_low < b.z_low; });
+
+  // sorted by lower edge, every later track starting below the upper edge of tr1 overlaps with it
+  std::vector<TrackPair> pairs;
+  for (auto tr1_it = candidates.begin(); tr1_it != candidates.end(); ++tr1_it)
+  {
+    for (auto tr2_it = std::next(tr1_it); tr2_it != candidates.end() && tr2_it->z_low <= tr1_it->z_high; ++tr2_it)
+    {
+      // lower track id first, as in a loop over the track map
+      const bool ordered = tr1_it->id < tr2_it->id;
+      TrackPair pair;
+      if (findDcaTwoTracks(ordered ? *tr1_it : *tr2_it, ordered ? *tr2_it : *tr1_it, dcacut, pair))
       {
-        std::cout << "Check DCA for tracks " << id1 << " and  " << id2 << std::endl;
+        pairs.push_back(pair);
       }
-
-      findDcaTwoTracks(tr1, tr2);
     }
   }
+
+  // same order as pairs from a loop over the track map
+  std::sort(pairs.begin(), pairs.end(), [](const TrackPair &a, const TrackPair &b)
+            { return std::make_pair(a.id1, a.id2) < std::make_pair(b.id1, b.id2); });
+
+  return pairs;
 }
 
 void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map)
@@ -747,117 +772,61 @@ void PHSimpleVertexFinder::getTrackletClusterList(TrackSeed* tracklet, std::vect
   }  // end loop over clusters for this track
 }
 
-void PHSimpleVertexFinder::checkDCAs()
+bool PHSimpleVertexFinder::passTrackCuts(unsigned int id, SvtxTrack *track) const
 {
-  // Loop over tracks and check for close DCA match with all other tracks
-  for (auto tr1_it = _track_map->begin(); tr1_it != _track_map->end(); ++tr1_it)
+  if (track->get_quality() > _qual_cut)
+  {
+    return false;
+  }
+  if (_require_mvtx)
   {
-    auto id1 = tr1_it->first;
-    auto tr1 = tr1_it->second;
-    if (tr1->get_quality() > _qual_cut)
+    unsigned int nmvtx = 0;
+    TrackSeed *siliconseed = track->get_silicon_seed();
+    if (!siliconseed)
     {
-      continue;
+      return false;
     }
-    if (_require_mvtx)
-    {
-      unsigned int nmvtx = 0;
-      TrackSeed *siliconseed = tr1->get_silicon_seed();
-      if (!siliconseed)
-      {
-        continue;
-      }
 
-      for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
-      {
-        if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-        {
-          nmvtx++;
-        }
-        if (nmvtx >= _nmvtx_required)
-        {
-          break;
-        }
-      }
-      if (nmvtx < _nmvtx_required)
+    for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
+    {
+      if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
       {
-        continue;
+        nmvtx++;
       }
-      if (Verbosity() > 3)
+      if (nmvtx >= _nmvtx_required)
       {
-        std::cout << " tr1 id " << id1 << " has nmvtx at least " << nmvtx << std::endl;
+        break;
       }
     }
-
-    // look for close DCA matches with all other such tracks
-    for (auto tr2_it = std::next(tr1_it); tr2_it != _track_map->end(); ++tr2_it)
+    if (nmvtx < _nmvtx_required)
     {
-      auto id2 = tr2_it->first;
-      auto tr2 = tr2_it->second;
-      if (tr2->get_quality() > _qual_cut)
-      {
-        continue;
-      }
-      if (_require_mvtx)
-      {
-        unsigned int nmvtx = 0;
-        TrackSeed *siliconseed = tr2->get_silicon_seed();
-        if (!siliconseed)
-        {
-          continue;
-        }
-
-        for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
-        {
-          if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-          {
-            nmvtx++;
-          }
-          if (nmvtx >= _nmvtx_required)
-          {
-            break;
-          }
-        }
-        if (nmvtx < _nmvtx_required)
-        {
-          continue;
-        }
-        if (Verbosity() > 3)
-        {
-          std::cout << " tr2 id " << id2 << " has nmvtx at least " << nmvtx << std::endl;
-        }
-      }
-
-      // find DCA of these two tracks
-      if (Verbosity() > 3)
-      {
-        std::cout << "Check DCA for tracks " << id1 << " and  " << id2 << std::endl;
-      }
-
-      findDcaTwoTracks(tr1, tr2);
+      return false;
     }
+    if (Verbosity() > 3)
+    {
+      std::cout << " track id " << id << " has nmvtx at least " << nmvtx << std::endl;
+    }
+  }
+  if (track->get_pt() < _track_pt_cut)
+  {
+    return false;
   }
+  return true;
 }
 
-void PHSimpleVertexFinder::findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2)
+bool PHSimpleVertexFinder::findDcaTwoTracks(const PairCandidate &tr1, const PairCandidate &tr2, double dcacut, TrackPair &pair) const
 {
-  if (tr1->get_pt() < _track_pt_cut)
-  {
-    return;
-  }
-  if (tr2->get_pt() < _track_pt_cut)
+  if (Verbosity() > 3)
   {
-    return;
+    std::cout << "Check DCA for tracks " << tr1.id << " and  " << tr2.id << std::endl;
   }
 
-  unsigned int id1 = tr1->get_id();
-  unsigned int id2 = tr2->get_id();
-
   // get the line equations for the tracks
 
-  Eigen::Vector3d a1(tr1->get_x(), tr1->get_y(), tr1->get_z());
-  Eigen::Vector3d b1(tr1->get_px() / tr1->get_p(), tr1->get_py() / tr1->get_p(), tr1->get_pz() / tr1->get_p());
-  Eigen::Vector3d a2(tr2->get_x(), tr2->get_y(), tr2->get_z());
-  Eigen::Vector3d b2(tr2->get_px() / tr2->get_p(), tr2->get_py() / tr2->get_p(), tr2->get_pz() / tr2->get_p());
+  const Eigen::Vector3d &a1 = tr1.position;
+  const Eigen::Vector3d &b1 = tr1.direction;
+  const Eigen::Vector3d &a2 = tr2.position;
+  const Eigen::Vector3d &b2 = tr2.direction;
 
   Eigen::Vector3d PCA1(0, 0, 0);
   Eigen::Vector3d PCA2(0, 0, 0);
@@ -865,17 +834,17 @@ void PHSimpleVertexFinder::findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2)
 
   if (Verbosity() > 3)
   {
-    std::cout << " pair dca is " << dca << " _active_dcacut is " << _active_dcacut
+    std::cout << " pair dca is " << dca << " dcacut is " << dcacut
               << " PCA1.x " << PCA1.x() << " PCA1.y " << PCA1.y()
               << " PCA2.x " << PCA2.x() << " PCA2.y " << PCA2.y() << std::endl;
   }
 
   // check dca cut is satisfied, and that PCA is close to beam line
-  if (fabs(dca) < _active_dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
+  if (fabs(dca) < dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
   {
     if (Verbosity() > 3)
     {
-      std::cout << " good match for tracks " << tr1->get_id() << " and " << tr2->get_id() << " with pT " << tr1->get_pt() << " and " << tr2->get_pt() << std::endl;
+      std::cout << " good match for tracks " << tr1.id << " and " << tr2.id << std::endl;
       std::cout << "    a1.x " << a1.x() << " a1.y " << a1.y() << " a1.z " << a1.z() << std::endl;
       std::cout << "    a2.x  " << a2.x() << " a2.y " << a2.y() << " a2.z " << a2.z() << std::endl;
       std::cout << "    PCA1.x() " << PCA1.x() << " PCA1.y " << PCA1.y() << " PCA1.z " << PCA1.z() << std::endl;
@@ -884,16 +853,20 @@ void PHSimpleVertexFinder::findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2)
     }
 
     // capture the results for successful matches
-    _track_pair_map.insert(std::make_pair(id1, std::make_pair(id2, dca)));
-    _track_pair_pca_map.insert(std::make_pair(id1, std::make_pair(id2, std::make_pair(PCA1, PCA2))));
+    pair.id1 = tr1.id;
+    pair.id2 = tr2.id;
+    pair.dca = dca;
+    pair.pca1 = PCA1;
+    pair.pca2 = PCA2;
+    return true;
   }
 
-  return;
+  return false;
 }
 
 double PHSimpleVertexFinder::dcaTwoLines(const Eigen::Vector3d &a1, const Eigen::Vector3d &b1,
                                          const Eigen::Vector3d &a2, const Eigen::Vector3d &b2,
-                                         Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2)
+                                         Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2) const
 {
   // The shortest distance between two skew lines described by
   //  a1 + c * b1
@@ -953,71 +926,53 @@ double PHSimpleVertexFinder::dcaTwoLines(const Eigen::Vector3d &a1, const Eigen:
 
 std::vector<std::set<unsigned int>> PHSimpleVertexFinder::findConnectedTracks()
 {
-  std::vector<std::set<unsigned int>> connected_tracks;
-  std::set<unsigned int> connected;
-  std::set<unsigned int> used;
-  for (auto it : _track_pair_map)
+  // union-find over all tracks in the pair list, tracks connected by any chain of pairs end up in the same set
+  std::map<unsigned int, unsigned int> index;
+  for (const auto &it : _track_pair_map)
   {
-    unsigned int id1 = it.first;
-    unsigned int id2 = it.second.first;
+    index.emplace(it.first, index.size());
+    index.emplace(it.second.first, index.size());
+  }
 
-    if ((used.find(id1) != used.end()) && (used.find(id2) != used.end()))
-    {
-      if (Verbosity() > 3)
-      {
-        std::cout << " tracks " << id1 << " and " << id2 << " are both in used , skip them" << std::endl;
-      }
-      continue;
-    }
-    else if ((used.find(id1) == used.end()) && (used.find(id2) == used.end()))
+  std::vector<unsigned int> parent(index.size());
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find_root = [&parent](unsigned int i)
+  {
+    while (parent[i] != i)
     {
-      if (Verbosity() > 3)
-      {
-        std::cout << " tracks " << id1 << " and " << id2 << " are both not in used , start a new connected set" << std::endl;
-      }
-      // close out and start a new connections set
-      if (connected.size() > 0)
-      {
-        connected_tracks.push_back(connected);
-        connected.clear();
-        if (Verbosity() > 3)
-        {
-          std::cout << "           closing out set " << std::endl;
-        }
-      }
+      parent[i] = parent[parent[i]];
+      i = parent[i];
     }
+    return i;
+  };
 
-    // get everything connected to id1 and id2
-    connected.insert(id1);
-    used.insert(id1);
-    connected.insert(id2);
-    used.insert(id2);
-    for (auto cit : _track_pair_map)
+  for (const auto &it : _track_pair_map)
+  {
+    unsigned int root1 = find_root(index[it.first]);
+    unsigned int root2 = find_root(index[it.second.first]);
+    if (root1 != root2)
     {
-      unsigned int id3 = cit.first;
-      unsigned int id4 = cit.second.first;
-      if ((connected.find(id3) != connected.end()) || (connected.find(id4) != connected.end()))
-      {
-        if (Verbosity() > 3)
-        {
-          std::cout << " found connection to " << id3 << " and " << id4 << std::endl;
-        }
-        connected.insert(id3);
-        used.insert(id3);
-        connected.insert(id4);
-        used.insert(id4);
-      }
+      parent[std::max(root1, root2)] = std::min(root1, root2);
     }
   }
 
-  // close out the last set
-  if (connected.size() > 0)
+  // sets are numbered in the order of their first pair in the track pair map
+  std::vector<std::set<unsigned int>> connected_tracks;
+  std::map<unsigned int, unsigned int> set_index;
+  for (const auto &it : _track_pair_map)
   {
-    connected_tracks.push_back(connected);
-    connected.clear();
+    unsigned int id1 = it.first;
+    unsigned int id2 = it.second.first;
+    auto [set_it, is_new] = set_index.emplace(find_root(index[id1]), connected_tracks.size());
+    if (is_new)
+    {
+      connected_tracks.emplace_back();
+    }
+    connected_tracks[set_it->second].insert(id1);
+    connected_tracks[set_it->second].insert(id2);
     if (Verbosity() > 3)
     {
-      std::cout << "           closing out last set " << std::endl;
+      std::cout << " tracks " << id1 << " and " << id2 << " are in connected set " << set_it->second << std::endl;
     }
   }
 
@@ -55,20 +55,46 @@ class PHSimpleVertexFinder : public SubsysReco
   void setTrkrClusterContainerName(std::string &name){ m_clusterContainerName = name; }
   void set_pp_mode(bool mode) { _pp_mode = mode; }
 
+  //! number of threads used to find track pairs in the beam crossings (0: OpenMP default)
+  void set_num_threads(int value) { m_num_threads = value; }
+
  private:
   int GetNodes(PHCompositeNode *topNode);
   int CreateNodes(PHCompositeNode *topNode);
 
-  void checkDCAs(SvtxTrackMap *track_map);
+  //! track parameters used in the DCA search, computed once per track
+  struct PairCandidate
+  {
+    unsigned int id = 0;
+    Eigen::Vector3d position;
+    Eigen::Vector3d direction;
+    double z_beam = 0;     // z where the track is closest to the beam line
+    double cot_theta = 0;  // |cot(theta)| of the track
+    double z_low = 0;      // z range at the beam line that can contain a good pair
+    double z_high = 0;
+  };
+
+  //! pair of tracks (id1 < id2) passing the DCA and beam line cuts
+  struct TrackPair
+  {
+    unsigned int id1 = 0;
+    unsigned int id2 = 0;
+    double dca = 0;
+    Eigen::Vector3d pca1;
+    Eigen::Vector3d pca2;
+  };
+
+  std::vector<TrackPair> findTrackPairs(short int crossing) const;
+  std::vector<TrackPair> checkDCAs(std::vector<PairCandidate> candidates, double dcacut) const;
   void checkDCAsZF(SvtxTrackMap *track_map);
-  void checkDCAs();
 
   void getTrackletClusterList(TrackSeed* tracklet, std::vector<TrkrDefs::cluskey>& cluskey_vec);
-  
-  void findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2);
+
+  bool passTrackCuts(unsigned int id, SvtxTrack *track) const;
+  bool findDcaTwoTracks(const PairCandidate &tr1, const PairCandidate &tr2, double dcacut, TrackPair &pair) const;
   double dcaTwoLines(const Eigen::Vector3d &p1, const Eigen::Vector3d &v1,
                      const Eigen::Vector3d &p2, const Eigen::Vector3d &v2,
-                     Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2);
+                     Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2) const;
   std::vector<std::set<unsigned int>> findConnectedTracks();
   void removeOutlierTrackPairs();
   double getMedian(std::vector<double> &v);
@@ -108,6 +134,8 @@ class PHSimpleVertexFinder : public SubsysReco
   TrackVertexCrossingAssoc *_track_vertex_crossing_map{nullptr};
 
   bool _pp_mode = true;  // default to pp mode
+
+  int m_num_threads = 0;
 };
 
 #endif  // PHSIMPLEVERTEXFINDER_H
@@ -0,0 +1,88 @@
+#include "EvalNtuple.h"
+
+#include "EvalNtupleFile.h"
+
+#include <sstream>
+
+EvalNtuple::EvalNtuple(EvalNtupleFile *file, const std::string &name, const std::string &title, const std::string &varlist, Type type)
+  : m_file(file)
+  , m_name(name)
+  , m_title(title)
+  , m_type(type)
+{
+  std::istringstream stream(varlist);
+  std::string column_name;
+  while (std::getline(stream, column_name, ':'))
+  {
+    if (!column_name.empty())
+    {
+      m_columns.emplace_back().name = column_name;
+    }
+  }
+}
+
+EvalNtuple::~EvalNtuple() = default;
+
+int EvalNtuple::column(const std::string &name) const
+{
+  for (size_t i = 0; i < m_columns.size(); ++i)
+  {
+    if (m_columns[i].name == name)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void EvalNtuple::Fill(const float *values)
+{
+  for (size_t i = 0; i < m_columns.size(); ++i)
+  {
+    m_columns[i].f.push_back(values[i]);
+  }
+  end_row();
+}
+
+void EvalNtuple::Fill(const std::vector<int> &values)
+{
+  for (size_t i = 0; i < m_columns.size(); ++i)
+  {
+    m_columns[i].i.push_back(values[i]);
+  }
+  end_row();
+}
+
+void EvalNtuple::end_row()
+{
+  ++m_event_rows;
+  ++m_nrows;
+  ++m_entries;
+
+  if (m_nrows >= m_file->block_rows())
+  {
+    m_file->flush(*this);
+  }
+}
+
+std::vector<EvalNtuple::Column> EvalNtuple::take_block()
+{
+  std::vector<Column> block;
+  block.swap(m_columns);
+  m_columns.reserve(block.size());
+  for (const auto &column : block)
+  {
+    Column &empty = m_columns.emplace_back();
+    empty.name = column.name;
+    if (m_type == Type::Int)
+    {
+      empty.i.reserve(m_file->block_rows());
+    }
+    else
+    {
+      empty.f.reserve(m_file->block_rows());
+    }
+  }
+  m_nrows = 0;
+  return block;
+}
@@ -0,0 +1,90 @@
+#ifndef G4EVAL_EVALNTUPLE_H
+#define G4EVAL_EVALNTUPLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class EvalNtupleFile;
+class TTree;
+
+/**
+ * Output table of the evaluators, replacing TNtuple.
+ *
+ * Columns are declared once from a TNtuple style "a:b:c" list and are float
+ * like the TNtuple leaves. Rows are buffered in one vector per column and
+ * handed to the owning EvalNtupleFile in blocks, which writes them to a TTree
+ * with the same name (on its writer thread if enabled).
+ * Tables are created with EvalNtupleFile::book.
+ */
+class EvalNtuple
+{
+ public:
+  ~EvalNtuple();
+
+  const std::string &name() const { return m_name; }
+  const std::string &title() const { return m_title; }
+  size_t ncolumns() const { return m_columns.size(); }
+
+  //! column index, -1 if there is no such column
+  int column(const std::string &name) const;
+
+  //! fill one row from an array with one value per column, like TNtuple::Fill
+  void Fill(const float *values);
+
+  //! rows filled so far, including the ones already written
+  uint64_t entries() const { return m_entries; }
+
+ private:
+  friend class EvalNtupleFile;
+
+  //! float columns for the evaluator tables, int for the event summary of the file
+  enum class Type
+  {
+    Float,
+    Int
+  };
+
+  EvalNtuple(EvalNtupleFile *file, const std::string &name, const std::string &title, const std::string &varlist, Type type = Type::Float);
+
+  struct Column
+  {
+    std::string name;
+    std::vector<float> f;
+    std::vector<int> i;
+  };
+
+  //! branch buffer, only used by the thread writing the tree
+  union BranchValue
+  {
+    float f;
+    int i;
+  };
+
+  //! fill one row of an int table
+  void Fill(const std::vector<int> &values);
+
+  //! called after each row, hands full blocks to the file
+  void end_row();
+
+  //! move the buffered rows out, leaving empty columns
+  std::vector<Column> take_block();
+
+  EvalNtupleFile *m_file = nullptr;
+  std::string m_name;
+  std::string m_title;
+  Type m_type = Type::Float;
+  std::vector<Column> m_columns;
+  size_t m_nrows = 0;
+  uint64_t m_entries = 0;
+
+  //! rows since the last EvalNtupleFile::end_event, for the event summary
+  int m_event_rows = 0;
+
+  //! output tree, created by the file when the first block is written
+  TTree *m_tree = nullptr;
+  std::vector<BranchValue> m_branch_values;
+};
+
+#endif  // G4EVAL_EVALNTUPLE_H
@@ -0,0 +1,217 @@
+#include "EvalNtupleFile.h"
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include <utility>
+#include <vector>
+
+EvalNtupleFile::EvalNtupleFile(const std::string &filename, int compression)
+  : m_file(new TFile(filename.c_str(), "RECREATE"))
+{
+  m_file->SetCompressionSettings(compression);
+}
+
+EvalNtupleFile::~EvalNtupleFile()
+{
+  Close();
+}
+
+bool EvalNtupleFile::IsOpen() const
+{
+  return m_file && m_file->IsOpen();
+}
+
+EvalNtuple *EvalNtupleFile::book(const std::string &name, const std::string &title, const std::string &varlist)
+{
+  // no make_unique, the constructor is private
+  m_tables.emplace_back(new EvalNtuple(this, name, title, varlist));
+  return m_tables.back().get();
+}
+
+void EvalNtupleFile::end_event(int event)
+{
+  if (!m_do_event_summary || m_tables.empty())
+  {
+    return;
+  }
+
+  if (!m_summary)
+  {
+    std::string varlist = "event";
+    for (const auto &table : m_tables)
+    {
+      varlist += ":n_" + table->name();
+    }
+    m_summary.reset(new EvalNtuple(this, "ntp_event_summary", "rows per event", varlist, EvalNtuple::Type::Int));
+  }
+
+  std::vector<int> row;
+  row.reserve(m_tables.size() + 1);
+  row.push_back(event);
+  for (auto &table : m_tables)
+  {
+    row.push_back(table->m_event_rows);
+    table->m_event_rows = 0;
+  }
+  m_summary->Fill(row);
+}
+
+void EvalNtupleFile::flush(EvalNtuple &table)
+{
+  Block block;
+  block.table = &table;
+  block.nrows = table.m_nrows;
+  block.columns = table.take_block();
+
+  if (!m_async)
+  {
+    write_block(block);
+    return;
+  }
+
+  if (!m_writer.joinable())
+  {
+    start_writer();
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // limit the memory held by blocks waiting to be written
+  m_cv.wait(lock, [this]
+            { return m_queue.size() < m_max_queued_blocks; });
+  m_queue.push_back(std::move(block));
+  lock.unlock();
+  m_cv.notify_all();
+}
+
+void EvalNtupleFile::create_tree(EvalNtuple &table, const std::vector<EvalNtuple::Column> &columns)
+{
+  TDirectory::TContext context(m_file);
+  table.m_tree = new TTree(table.name().c_str(), table.title().c_str());
+
+  // one branch per column, named like the TNtuple leaves
+  table.m_branch_values.assign(columns.size(), EvalNtuple::BranchValue());
+  for (size_t i = 0; i < columns.size(); ++i)
+  {
+    const auto &column = columns[i];
+    const std::string leaflist = column.name + (table.m_type == EvalNtuple::Type::Int ? "/I" : "/F");
+    table.m_tree->Branch(column.name.c_str(), &table.m_branch_values[i], leaflist.c_str(), m_basket_size);
+  }
+}
+
+void EvalNtupleFile::write_block(Block &block)
+{
+  EvalNtuple &table = *block.table;
+  // the columns of the table itself may be filled meanwhile, take the layout from the block
+  if (!table.m_tree)
+  {
+    create_tree(table, block.columns);
+  }
+
+  auto &values = table.m_branch_values;
+  for (size_t row = 0; row < block.nrows; ++row)
+  {
+    for (size_t i = 0; i < block.columns.size(); ++i)
+    {
+      if (table.m_type == EvalNtuple::Type::Int)
+      {
+        values[i].i = block.columns[i].i[row];
+      }
+      else
+      {
+        values[i].f = block.columns[i].f[row];
+      }
+    }
+    table.m_tree->Fill();
+  }
+}
+
+void EvalNtupleFile::start_writer()
+{
+  m_stop = false;
+  m_writer = std::thread(&EvalNtupleFile::writer_loop, this);
+}
+
+void EvalNtupleFile::stop_writer()
+{
+  if (!m_writer.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  m_writer.join();
+}
+
+void EvalNtupleFile::writer_loop()
+{
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]
+              { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty())
+    {
+      // stopped and all blocks written
+      return;
+    }
+    Block block = std::move(m_queue.front());
+    m_queue.pop_front();
+    lock.unlock();
+    m_cv.notify_all();
+
+    write_block(block);
+  }
+}
+
+void EvalNtupleFile::Close()
+{
+  if (!m_file)
+  {
+    return;
+  }
+
+  for (auto &table : m_tables)
+  {
+    if (table->m_nrows > 0)
+    {
+      flush(*table);
+    }
+  }
+  if (m_summary && m_summary->m_nrows > 0)
+  {
+    flush(*m_summary);
+  }
+  stop_writer();
+
+  TDirectory::TContext context(m_file);
+  for (auto &table : m_tables)
+  {
+    // empty tables are written too, so that readers find all of them
+    if (!table->m_tree)
+    {
+      create_tree(*table, table->m_columns);
+    }
+    table->m_tree->Write();
+  }
+  if (m_summary && m_summary->m_tree)
+  {
+    m_summary->m_tree->Write();
+  }
+
+  // the trees belong to the file
+  m_file->Close();
+  delete m_file;
+  m_file = nullptr;
+  for (auto &table : m_tables)
+  {
+    table->m_tree = nullptr;
+  }
+  if (m_summary)
+  {
+    m_summary->m_tree = nullptr;
+  }
+}
@@ -0,0 +1,100 @@
+#ifndef G4EVAL_EVALNTUPLEFILE_H
+#define G4EVAL_EVALNTUPLEFILE_H
+
+#include "EvalNtuple.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TFile;
+
+/**
+ * Output file of the evaluators, owning the EvalNtuple tables written to it.
+ *
+ * Tables are flushed in blocks of rows to TTrees with large baskets and the
+ * file compression. With set_async(true) the trees are filled on a writer
+ * thread, the event loop only moves the buffered columns to a queue.
+ * end_event() adds one row per event to the optional "ntp_event_summary" table,
+ * with the number of rows each table got in this event.
+ */
+class EvalNtupleFile
+{
+ public:
+  //! compression as in TFile::SetCompressionSettings, default is zstd level 5
+  explicit EvalNtupleFile(const std::string &filename, int compression = 505);
+  ~EvalNtupleFile();
+
+  EvalNtupleFile(const EvalNtupleFile &) = delete;
+  EvalNtupleFile &operator=(const EvalNtupleFile &) = delete;
+
+  bool IsOpen() const;
+
+  //! create a table, owned by the file
+  EvalNtuple *book(const std::string &name, const std::string &title, const std::string &varlist);
+
+  //!@name settings, to be changed before the first row is filled
+  //@{
+  //! the owner has to call ROOT::EnableThreadSafety() before the first row when async
+  void set_async(bool async) { m_async = async; }
+  void set_block_rows(size_t rows) { m_block_rows = rows; }
+  void set_basket_size(int bytes) { m_basket_size = bytes; }
+  void set_event_summary(bool summary) { m_do_event_summary = summary; }
+  //@}
+
+  size_t block_rows() const { return m_block_rows; }
+
+  //! close the event: fill the event summary row, tables have to be booked before the first call
+  void end_event(int event);
+
+  //! write all buffered rows and the trees, close the file
+  void Close();
+
+ private:
+  friend class EvalNtuple;
+
+  struct Block
+  {
+    EvalNtuple *table = nullptr;
+    std::vector<EvalNtuple::Column> columns;
+    size_t nrows = 0;
+  };
+
+  //! hand the buffered rows of a table to the writer
+  void flush(EvalNtuple &table);
+
+  //! fill the rows of a block into the tree of its table
+  void write_block(Block &block);
+  void create_tree(EvalNtuple &table, const std::vector<EvalNtuple::Column> &columns);
+
+  void start_writer();
+  void stop_writer();
+  void writer_loop();
+
+  TFile *m_file = nullptr;
+  std::vector<std::unique_ptr<EvalNtuple>> m_tables;
+
+  bool m_do_event_summary = true;
+  std::unique_ptr<EvalNtuple> m_summary;
+
+  bool m_async = false;
+  size_t m_block_rows = 10000;
+  int m_basket_size = 64000;
+
+  //!@name writer thread, blocks are written in the order they were queued
+  //@{
+  std::thread m_writer;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Block> m_queue;
+  size_t m_max_queued_blocks = 8;
+  bool m_stop = false;
+  //@}
+};
+
+#endif  // G4EVAL_EVALNTUPLEFILE_H
@@ -23,6 +23,7 @@
 
 #include <TVector3.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
@@ -49,19 +50,12 @@ SvtxClusterEval::~SvtxClusterEval()
 
 void SvtxClusterEval::next_event(PHCompositeNode* topNode)
 {
-  _cache_all_truth_hits.clear();
   _cache_all_truth_clusters.clear();
   _cache_max_truth_hit_by_energy.clear();
   _cache_max_truth_cluster_by_energy.clear();
-  _cache_all_truth_particles.clear();
-  _cache_max_truth_particle_by_energy.clear();
   _cache_max_truth_particle_by_cluster_energy.clear();
-  _cache_all_clusters_from_particle.clear();
-  _cache_all_clusters_from_g4hit.clear();
-  _cache_best_cluster_from_g4hit.clear();
-  _cache_get_energy_contribution_g4particle.clear();
-  _cache_get_energy_contribution_g4hit.clear();
   _cache_best_cluster_from_gtrackid_layer.clear();
+  _truth_assoc.clear();
   _clusters_per_layer.clear();
   //  _g4hits_per_layer.clear();
   _hiteval.next_event(topNode);
@@ -343,16 +337,14 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     return std::set<PHG4Hit*>();
   }
 
-  if (_do_cache)
+  FillRecoClusterFromG4HitCache();
+  if (_truth_assoc.has_cluster(cluster_key))
   {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>>::iterator iter =
-        _cache_all_truth_hits.find(cluster_key);
-    if (iter != _cache_all_truth_hits.end())
-    {
-      return iter->second;
-    }
+    const auto g4hits = _truth_assoc.g4hits(cluster_key);
+    return std::set<PHG4Hit*>(g4hits.begin(), g4hits.end());
   }
 
+  // cluster is not in the cluster container, walk the association maps
   std::set<PHG4Hit*> truth_hits;
 
   // get all truth hits for this cluster
@@ -403,11 +395,6 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     }  // end loop over g4hits associated with hitsetkey and hitkey
   }    // end loop over hits associated with cluskey
 
-  if (_do_cache)
-  {
-    _cache_all_truth_hits.insert(std::make_pair(cluster_key, truth_hits));
-  }
-
   return truth_hits;
 }
 
@@ -785,18 +772,28 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
     return std::set<PHG4Particle*>();
   }
 
-  if (_do_cache)
+  std::set<PHG4Particle*> truth_particles;
+
+  FillRecoClusterFromG4HitCache();
+  if (_truth_assoc.has_cluster(cluster_key))
   {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>>::iterator iter =
-        _cache_all_truth_particles.find(cluster_key);
-    if (iter != _cache_all_truth_particles.end())
+    for (const auto& entry : _truth_assoc.particles(cluster_key))
     {
-      return iter->second;
+      if (_strict)
+      {
+        assert(entry.particle);
+      }
+      else if (!entry.particle)
+      {
+        ++_errors;
+        continue;
+      }
+
+      truth_particles.insert(entry.particle);
     }
+    return truth_particles;
   }
 
-  std::set<PHG4Particle*> truth_particles;
-
   std::set<PHG4Hit*> g4hits = all_truth_hits(cluster_key);
 
   for (auto hit : g4hits)
@@ -817,11 +814,6 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
     truth_particles.insert(particle);
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_particles.insert(std::make_pair(cluster_key, truth_particles));
-  }
-
   return truth_particles;
 }
 
@@ -886,16 +878,6 @@ PHG4Particle* SvtxClusterEval::max_truth_particle_by_energy(TrkrDefs::cluskey cl
     return nullptr;
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::cluskey, PHG4Particle*>::iterator iter =
-        _cache_max_truth_particle_by_energy.find(cluster_key);
-    if (iter != _cache_max_truth_particle_by_energy.end())
-    {
-      return iter->second;
-    }
-  }
-
   // loop over all particles associated with this cluster and
   // get the energy contribution for each one, record the max
   PHG4Particle* max_particle = nullptr;
@@ -911,11 +893,6 @@ PHG4Particle* SvtxClusterEval::max_truth_particle_by_energy(TrkrDefs::cluskey cl
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_max_truth_particle_by_energy.insert(std::make_pair(cluster_key, max_particle));
-  }
-
   return max_particle;
 }
 
@@ -936,68 +913,37 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Particle* tru
     ++_errors;
     return std::set<TrkrDefs::cluskey>();
   }
-  // check if cache is filled, if not fill it.
-  //   if(_cache_all_clusters_from_particle.count(truthparticle)==0){
-  if (_cache_all_clusters_from_particle.empty())
-  {
-    FillRecoClusterFromG4HitCache();
-  }
 
-  if (_do_cache)
+  FillRecoClusterFromG4HitCache();
+
+  std::set<TrkrDefs::cluskey> clusters;
+  for (const auto& entry : _truth_assoc.clusters(truthparticle))
   {
-    std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>>::iterator iter =
-        _cache_all_clusters_from_particle.find(truthparticle);
-    if (iter != _cache_all_clusters_from_particle.end())
-    {
-      return iter->second;
-    }
+    clusters.insert(clusters.end(), entry.cluster_key);
   }
-  std::set<TrkrDefs::cluskey> clusters;
   return clusters;
 }
 
 void SvtxClusterEval::FillRecoClusterFromG4HitCache()
 {
+  if (_truth_assoc.filled())
+  {
+    return;
+  }
+
   auto Mytimer = std::make_unique<PHTimer>("ReCl_timer");
   Mytimer->stop();
   Mytimer->restart();
 
-  std::multimap<PHG4Particle*, TrkrDefs::cluskey> temp_clusters_from_particles;
-  // loop over all the clusters
-  for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-  {
-    auto range = _clustermap->getClusters(hitsetkey);
-    for (auto iter = range.first; iter != range.second; ++iter)
-    {
-      TrkrDefs::cluskey cluster_key = iter->first;
-
-      // loop over all truth particles connected to this cluster
-      std::set<PHG4Particle*> particles = all_truth_particles(cluster_key);
-      for (auto candidate : particles)
-      {
-        temp_clusters_from_particles.insert(std::make_pair(candidate, cluster_key));
-      }
-    }
-  }
-  // Loop over particles and fill cache
-  PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second; ++iter)
-  {
-    PHG4Particle* g4particle = iter->second;
-    std::set<TrkrDefs::cluskey> clusters;
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
-    {
-      TrkrDefs::cluskey cluster_key = cfp_iter->second;
-      clusters.insert(cluster_key);
-    }
-    _cache_all_clusters_from_particle.insert(std::make_pair(g4particle, clusters));
-  }
+  // one pass over clusters -> hits -> g4hits -> particles for the whole event
+  _truth_assoc.fill(_clustermap, _cluster_hit_map, _hit_truth_map, _truthinfo,
+                    _g4hits_tpc, _g4hits_intt, _g4hits_mvtx, _g4hits_mms);
 
   Mytimer->stop();
+  if (_verbosity > 1)
+  {
+    std::cout << "SvtxClusterEval::FillRecoClusterFromG4HitCache - filled in " << Mytimer->elapsed() << " ms" << std::endl;
+  }
 }
 
 std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit)
@@ -1018,110 +964,20 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit
     return std::set<TrkrDefs::cluskey>();
   }
 
-  // one time, fill cache of g4hit/cluster pairs
-  if (_cache_all_clusters_from_g4hit.size() == 0)
-  {
-    // make a map of truthhit, cluster_key inside this loop
-    std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey> truth_cluster_map;
-    std::set<PHG4HitDefs::keytype> all_g4hits_set;
-    std::map<PHG4HitDefs::keytype, PHG4Hit*> all_g4hits_map;
-
-    // get all reco clusters
-    if (_verbosity > 1)
-    {
-      std::cout << "all_clusters_from_g4hit: list all reco clusters " << std::endl;
-    }
-
-    for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-    {
-      auto range = _clustermap->getClusters(hitsetkey);
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        TrkrDefs::cluskey cluster_key = iter->first;
-        int layer = TrkrDefs::getLayer(cluster_key);
-        TrkrCluster* clus = iter->second;
-        if (_verbosity > 1)
-        {
-          std::cout << " layer " << layer << " cluster_key " << cluster_key << " adc " << clus->getAdc()
-                    << " localx " << clus->getLocalX()
-                    << " localy " << clus->getLocalY()
-                    << std::endl;
-          std::cout << "  associated hits:";
-          std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-              hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-          for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-                   clushititer = hitrange.first;
-               clushititer != hitrange.second; ++clushititer)
-          {
-            TrkrDefs::hitkey hitkey = clushititer->second;
-            std::cout << " " << hitkey;
-          }
-          std::cout << std::endl;
-        }
-
-        // the returned truth hits were obtained from TrkrAssoc maps
-        std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-        for (auto candidate : hits)
-        {
-          PHG4HitDefs::keytype g4hit_key = candidate->get_hit_id();
-
-          if (_verbosity > 5)
-          {
-            int gtrackID = candidate->get_trkid();
-            std::cout << "   adding cluster with cluster_key " << cluster_key << " g4hit with g4hit_key " << g4hit_key
-                      << " gtrackID " << gtrackID
-                      << std::endl;
-          }
-
-          all_g4hits_set.insert(g4hit_key);
-          all_g4hits_map.insert(std::make_pair(g4hit_key, candidate));
-
-          truth_cluster_map.insert(std::make_pair(g4hit_key, cluster_key));
-        }
-      }
-    }
-
-    // now fill the cache
-    // loop over all entries in all_g4hits
-    for (unsigned long long g4hit_key : all_g4hits_set)
-    {
-      if (_verbosity > 5)
-      {
-        std::cout << " associations for g4hit_key " << g4hit_key << std::endl;
-      }
-
-      std::map<PHG4HitDefs::keytype, PHG4Hit*>::iterator it = all_g4hits_map.find(g4hit_key);
-      PHG4Hit* g4hit = it->second;
-
-      std::set<TrkrDefs::cluskey> assoc_clusters;
-
-      std::pair<std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator,
-                std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator>
-          ret = truth_cluster_map.equal_range(g4hit_key);
-      for (std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator jter = ret.first; jter != ret.second; ++jter)
-      {
-        assoc_clusters.insert(jter->second);
-
-        if (_verbosity > 5)
-        {
-          std::cout << "             g4hit_key " << g4hit_key << " associated with cluster_key " << jter->second << std::endl;
-        }
-      }
-      // done with this g4hit
-      _cache_all_clusters_from_g4hit.insert(std::make_pair(g4hit, assoc_clusters));
-    }
-  }
+  FillRecoClusterFromG4HitCache();
 
   // get the clusters
   std::set<TrkrDefs::cluskey> clusters;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>>::iterator iter =
-      _cache_all_clusters_from_g4hit.find(truthhit);
-  if (iter != _cache_all_clusters_from_g4hit.end())
+  for (const auto& entry : _truth_assoc.clusters(truthhit))
   {
-    return iter->second;
+    if (_verbosity > 5)
+    {
+      std::cout << "             g4hit_key " << truthhit->get_hit_id() << " associated with cluster_key " << entry.cluster_key << std::endl;
+    }
+    clusters.insert(clusters.end(), entry.cluster_key);
   }
 
-  if (_clusters_per_layer.size() == 0)
+  if (clusters.empty() && _clusters_per_layer.size() == 0)
   {
     fill_cluster_layer_map();
   }
@@ -1223,16 +1079,6 @@ TrkrDefs::cluskey SvtxClusterEval::best_cluster_from(PHG4Hit* truthhit)
     return 0;
   }
 
-  if (_do_cache)
-  {
-    std::map<PHG4Hit*, TrkrDefs::cluskey>::iterator iter =
-        _cache_best_cluster_from_g4hit.find(truthhit);
-    if (iter != _cache_best_cluster_from_g4hit.end())
-    {
-      return iter->second;
-    }
-  }
-
   TrkrDefs::cluskey best_cluster = 0;
   float best_energy = 0.0;
   std::set<TrkrDefs::cluskey> clusters = all_clusters_from(truthhit);
@@ -1246,11 +1092,6 @@ TrkrDefs::cluskey SvtxClusterEval::best_cluster_from(PHG4Hit* truthhit)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_best_cluster_from_g4hit.insert(std::make_pair(truthhit, best_cluster));
-  }
-
   return best_cluster;
 }
 
@@ -1277,14 +1118,19 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return NAN;
   }
 
-  if (_do_cache)
+  FillRecoClusterFromG4HitCache();
+  if (_truth_assoc.has_cluster(cluster_key))
   {
-    std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4particle.find(std::make_pair(cluster_key, particle));
-    if (iter != _cache_get_energy_contribution_g4particle.end())
+    // per particle sums are stored sorted by track id
+    const auto particles = _truth_assoc.particles(cluster_key);
+    const auto iter = std::lower_bound(particles.begin(), particles.end(), particle->get_track_id(),
+                                       [](const SvtxClusterTruthAssoc::ParticleEnergy& entry, int track_id)
+                                       { return entry.track_id < track_id; });
+    if (iter != particles.end() && iter->track_id == particle->get_track_id())
     {
-      return iter->second;
+      return iter->energy;
     }
+    return 0.0;
   }
 
   float energy = 0.0;
@@ -1297,11 +1143,6 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4particle.insert(std::make_pair(std::make_pair(cluster_key, particle), energy));
-  }
-
   return energy;
 }
 
@@ -1324,17 +1165,23 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return NAN;
   }
 
-  if ((_do_cache) &&
-      (_cache_get_energy_contribution_g4hit.find(std::make_pair(cluster_key, g4hit)) !=
-       _cache_get_energy_contribution_g4hit.end()))
-  {
-    return _cache_get_energy_contribution_g4hit[std::make_pair(cluster_key, g4hit)];
-  }
-
   // this is a fairly simple existance check right now, but might be more
   // complex in the future, so this is here mostly as future-proofing.
 
   float energy = 0.0;
+  FillRecoClusterFromG4HitCache();
+  if (_truth_assoc.has_cluster(cluster_key))
+  {
+    for (auto candidate : _truth_assoc.g4hits(cluster_key))
+    {
+      if (candidate->get_hit_id() == g4hit->get_hit_id())
+      {
+        energy += candidate->get_edep();
+      }
+    }
+    return energy;
+  }
+
   std::set<PHG4Hit*> g4hits = all_truth_hits(cluster_key);
   for (auto candidate : g4hits)
   {
@@ -1345,11 +1192,6 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     energy += candidate->get_edep();
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4hit.insert(std::make_pair(std::make_pair(cluster_key, g4hit), energy));
-  }
-
   return energy;
 }
 
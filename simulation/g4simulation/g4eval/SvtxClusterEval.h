@@ -1,6 +1,7 @@
 #ifndef G4EVAL_SVTXCLUSTEREVAL_H
 #define G4EVAL_SVTXCLUSTEREVAL_H
 
+#include "SvtxClusterTruthAssoc.h"
 #include "SvtxHitEval.h"
 
 #include <trackbase/ActsGeometry.h>
@@ -75,6 +76,7 @@ class SvtxClusterEval
   std::set<TrkrDefs::cluskey> all_clusters_from(PHG4Hit* truthhit);
   TrkrDefs::cluskey best_cluster_from(PHG4Hit* truthhit);
   TrkrDefs::cluskey best_cluster_by_nhit(int gid, int layer);
+  //! fill the cluster <-> truth association tables, done on first use in each event
   void FillRecoClusterFromG4HitCache();
   // overlap calculations
   float get_energy_contribution(TrkrDefs::cluskey cluster_key, PHG4Particle* truthparticle);
@@ -112,20 +114,16 @@ class SvtxClusterEval
 
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey cluster_key, TrkrCluster* cluster);
 
+  //! cluster <-> g4hit <-> particle associations, filled once per event.
+  //! Always used, independent of _do_cache
+  SvtxClusterTruthAssoc _truth_assoc;
+
   bool _do_cache = true;
-  std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>> _cache_all_truth_hits;
   std::map<TrkrDefs::cluskey, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_all_truth_clusters;
   std::map<TrkrDefs::cluskey, PHG4Hit*> _cache_max_truth_hit_by_energy;
   std::map<TrkrDefs::cluskey, std::pair<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_max_truth_cluster_by_energy;
-  std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>> _cache_all_truth_particles;
-  std::map<TrkrDefs::cluskey, PHG4Particle*> _cache_max_truth_particle_by_energy;
   std::map<TrkrDefs::cluskey, PHG4Particle*> _cache_max_truth_particle_by_cluster_energy;
-  std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>> _cache_all_clusters_from_particle;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>> _cache_all_clusters_from_g4hit;
-  std::map<PHG4Hit*, TrkrDefs::cluskey> _cache_best_cluster_from_g4hit;
   std::map<std::pair<int, int>, TrkrDefs::cluskey> _cache_best_cluster_from_gtrackid_layer;
-  std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float> _cache_get_energy_contribution_g4particle;
-  std::map<std::pair<TrkrDefs::cluskey, PHG4Hit*>, float> _cache_get_energy_contribution_g4hit;
   std::map<std::shared_ptr<TrkrCluster>, std::pair<TrkrDefs::cluskey, TrkrCluster*>> _cache_reco_cluster_from_truth_cluster;
 
   // measured for low occupancy events, all in cm
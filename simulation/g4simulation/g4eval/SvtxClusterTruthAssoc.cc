@@ -0,0 +1,242 @@
+#include "SvtxClusterTruthAssoc.h"
+
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterHitAssoc.h>
+#include <trackbase/TrkrHitTruthAssoc.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4HitDefs.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+  template <class T>
+  bool entry_less(const SvtxClusterTruthAssoc::Entry<T>& lhs, const SvtxClusterTruthAssoc::Entry<T>& rhs)
+  {
+    return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.cluster_key < rhs.cluster_key);
+  }
+
+  template <class T>
+  std::span<const SvtxClusterTruthAssoc::Entry<T>> entry_range(const std::vector<SvtxClusterTruthAssoc::Entry<T>>& entries, T* key)
+  {
+    const auto range = std::equal_range(entries.begin(), entries.end(), SvtxClusterTruthAssoc::Entry<T>{key, 0},
+                                        [](const auto& lhs, const auto& rhs)
+                                        { return lhs.key < rhs.key; });
+    return {range.first, range.second};
+  }
+}  // namespace
+
+void SvtxClusterTruthAssoc::clear()
+{
+  m_filled = false;
+  m_cluster_keys.clear();
+  m_g4hit_offset.clear();
+  m_g4hits.clear();
+  m_particle_offset.clear();
+  m_particles.clear();
+  m_particle_clusters.clear();
+  m_g4hit_clusters.clear();
+}
+
+void SvtxClusterTruthAssoc::fill(TrkrClusterContainer* clustermap,
+                                 TrkrClusterHitAssoc* cluster_hit_map,
+                                 TrkrHitTruthAssoc* hit_truth_map,
+                                 PHG4TruthInfoContainer* truthinfo,
+                                 PHG4HitContainer* g4hits_tpc,
+                                 PHG4HitContainer* g4hits_intt,
+                                 PHG4HitContainer* g4hits_mvtx,
+                                 PHG4HitContainer* g4hits_mms)
+{
+  clear();
+  m_filled = true;
+  if (!clustermap || !cluster_hit_map || !hit_truth_map || !truthinfo)
+  {
+    m_g4hit_offset.push_back(0);
+    m_particle_offset.push_back(0);
+    return;
+  }
+
+  // sorted cluster keys are grouped by hitset
+  for (const auto& hitsetkey : clustermap->getHitSetKeys())
+  {
+    auto range = clustermap->getClusters(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      m_cluster_keys.push_back(iter->first);
+    }
+  }
+  std::sort(m_cluster_keys.begin(), m_cluster_keys.end());
+  m_cluster_keys.erase(std::unique(m_cluster_keys.begin(), m_cluster_keys.end()), m_cluster_keys.end());
+
+  m_g4hit_offset.reserve(m_cluster_keys.size() + 1);
+  m_particle_offset.reserve(m_cluster_keys.size() + 1);
+  m_g4hit_offset.push_back(0);
+  m_particle_offset.push_back(0);
+
+  // (hitkey, g4hitkey) of the current hitset, sorted by hitkey.
+  // Without the range access of the association, the g4hits are looked up per hit
+  const bool use_g4hit_range = hit_truth_map->hasG4HitRange();
+  std::vector<std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>> hit_g4hits;
+  TrkrHitTruthAssoc::MMap temp_map;
+  TrkrDefs::hitsetkey current_hitsetkey = 0;
+  bool first_cluster = true;
+  PHG4HitContainer* g4hitcontainer = nullptr;
+
+  for (const auto& cluster_key : m_cluster_keys)
+  {
+    const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
+    if (first_cluster || hitsetkey != current_hitsetkey)
+    {
+      first_cluster = false;
+      current_hitsetkey = hitsetkey;
+      hit_g4hits.clear();
+      if (use_g4hit_range)
+      {
+        const auto g4range = hit_truth_map->getG4HitRange(hitsetkey);
+        for (auto iter = g4range.first; iter != g4range.second; ++iter)
+        {
+          hit_g4hits.push_back(iter->second);
+        }
+        std::sort(hit_g4hits.begin(), hit_g4hits.end());
+      }
+
+      switch (TrkrDefs::getTrkrId(hitsetkey))
+      {
+      case TrkrDefs::tpcId:
+        g4hitcontainer = g4hits_tpc;
+        break;
+      case TrkrDefs::inttId:
+        g4hitcontainer = g4hits_intt;
+        break;
+      case TrkrDefs::mvtxId:
+        g4hitcontainer = g4hits_mvtx;
+        break;
+      case TrkrDefs::micromegasId:
+        g4hitcontainer = g4hits_mms;
+        break;
+      default:
+        g4hitcontainer = nullptr;
+        break;
+      }
+    }
+
+    // g4hits of all hits in this cluster
+    const size_t first_g4hit = m_g4hits.size();
+    if (g4hitcontainer)
+    {
+      auto add_g4hit = [&](PHG4HitDefs::keytype g4hitkey)
+      {
+        PHG4Hit* g4hit = g4hitcontainer->findHit(g4hitkey);
+        if (g4hit)
+        {
+          m_g4hits.push_back(g4hit);
+        }
+      };
+
+      const auto hitrange = cluster_hit_map->getHits(cluster_key);
+      for (auto clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
+      {
+        const TrkrDefs::hitkey hitkey = clushititer->second;
+        if (use_g4hit_range)
+        {
+          auto g4iter = std::lower_bound(hit_g4hits.begin(), hit_g4hits.end(), std::make_pair(hitkey, PHG4HitDefs::keytype(0)));
+          for (; g4iter != hit_g4hits.end() && g4iter->first == hitkey; ++g4iter)
+          {
+            add_g4hit(g4iter->second);
+          }
+        }
+        else
+        {
+          temp_map.clear();
+          hit_truth_map->getG4Hits(hitsetkey, hitkey, temp_map);
+          for (const auto& [key, hit_g4hit] : temp_map)
+          {
+            add_g4hit(hit_g4hit.second);
+          }
+        }
+      }
+    }
+    const auto g4hits_begin = m_g4hits.begin() + first_g4hit;
+    std::sort(g4hits_begin, m_g4hits.end());
+    m_g4hits.erase(std::unique(g4hits_begin, m_g4hits.end()), m_g4hits.end());
+    m_g4hit_offset.push_back(m_g4hits.size());
+
+    // sum energy per particle, in g4hit order so the sums do not depend on how they are looked up
+    const size_t first_particle = m_particles.size();
+    for (size_t i = first_g4hit; i < m_g4hits.size(); ++i)
+    {
+      PHG4Hit* g4hit = m_g4hits[i];
+      m_g4hit_clusters.push_back({g4hit, cluster_key});
+
+      const int track_id = g4hit->get_trkid();
+      auto particle_iter = std::find_if(m_particles.begin() + first_particle, m_particles.end(),
+                                        [track_id](const ParticleEnergy& entry)
+                                        { return entry.track_id == track_id; });
+      if (particle_iter == m_particles.end())
+      {
+        m_particles.push_back({track_id, truthinfo->GetParticle(track_id), 0});
+        particle_iter = m_particles.end() - 1;
+      }
+      particle_iter->energy += g4hit->get_edep();
+    }
+    std::sort(m_particles.begin() + first_particle, m_particles.end(),
+              [](const ParticleEnergy& lhs, const ParticleEnergy& rhs)
+              { return lhs.track_id < rhs.track_id; });
+    m_particle_offset.push_back(m_particles.size());
+
+    for (size_t i = first_particle; i < m_particles.size(); ++i)
+    {
+      if (m_particles[i].particle)
+      {
+        m_particle_clusters.push_back({m_particles[i].particle, cluster_key});
+      }
+    }
+  }
+
+  std::sort(m_particle_clusters.begin(), m_particle_clusters.end(), entry_less<PHG4Particle>);
+  std::sort(m_g4hit_clusters.begin(), m_g4hit_clusters.end(), entry_less<PHG4Hit>);
+}
+
+size_t SvtxClusterTruthAssoc::find_cluster(TrkrDefs::cluskey cluster_key) const
+{
+  const auto iter = std::lower_bound(m_cluster_keys.begin(), m_cluster_keys.end(), cluster_key);
+  if (iter == m_cluster_keys.end() || *iter != cluster_key)
+  {
+    return m_cluster_keys.size();
+  }
+  return iter - m_cluster_keys.begin();
+}
+
+std::span<PHG4Hit* const> SvtxClusterTruthAssoc::g4hits(TrkrDefs::cluskey cluster_key) const
+{
+  const size_t index = find_cluster(cluster_key);
+  if (index == m_cluster_keys.size())
+  {
+    return {};
+  }
+  return {m_g4hits.begin() + m_g4hit_offset[index], m_g4hits.begin() + m_g4hit_offset[index + 1]};
+}
+
+std::span<const SvtxClusterTruthAssoc::ParticleEnergy> SvtxClusterTruthAssoc::particles(TrkrDefs::cluskey cluster_key) const
+{
+  const size_t index = find_cluster(cluster_key);
+  if (index == m_cluster_keys.size())
+  {
+    return {};
+  }
+  return {m_particles.begin() + m_particle_offset[index], m_particles.begin() + m_particle_offset[index + 1]};
+}
+
+std::span<const SvtxClusterTruthAssoc::Entry<PHG4Particle>> SvtxClusterTruthAssoc::clusters(PHG4Particle* particle) const
+{
+  return entry_range(m_particle_clusters, particle);
+}
+
+std::span<const SvtxClusterTruthAssoc::Entry<PHG4Hit>> SvtxClusterTruthAssoc::clusters(PHG4Hit* g4hit) const
+{
+  return entry_range(m_g4hit_clusters, g4hit);
+}
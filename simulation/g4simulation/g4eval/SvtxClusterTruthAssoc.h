@@ -0,0 +1,90 @@
+#ifndef G4EVAL_SVTXCLUSTERTRUTHASSOC_H
+#define G4EVAL_SVTXCLUSTERTRUTHASSOC_H
+
+#include <trackbase/TrkrDefs.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+class PHG4Hit;
+class PHG4HitContainer;
+class PHG4Particle;
+class PHG4TruthInfoContainer;
+class TrkrClusterContainer;
+class TrkrClusterHitAssoc;
+class TrkrHitTruthAssoc;
+
+/**
+ * Cluster <-> truth associations of one event, for SvtxClusterEval.
+ *
+ * Filled in a single pass over clusters -> hits -> g4hits -> particles and
+ * stored in flat arrays sorted by key, so that queries are a binary search
+ * followed by direct indexing instead of walking the association maps again
+ * for every cluster.
+ */
+class SvtxClusterTruthAssoc
+{
+ public:
+  //! particle contributing to a cluster, with the summed edep of its g4hits in this cluster
+  struct ParticleEnergy
+  {
+    int track_id = 0;
+    PHG4Particle* particle = nullptr;  // nullptr if the track id is not in the truth container
+    float energy = 0;
+  };
+
+  //! reverse association, sorted by particle (g4hit), then cluster key
+  template <class T>
+  struct Entry
+  {
+    T* key = nullptr;
+    TrkrDefs::cluskey cluster_key = 0;
+  };
+
+  SvtxClusterTruthAssoc() = default;
+
+  //! build all tables from the clusters in the container
+  void fill(TrkrClusterContainer* clustermap,
+            TrkrClusterHitAssoc* cluster_hit_map,
+            TrkrHitTruthAssoc* hit_truth_map,
+            PHG4TruthInfoContainer* truthinfo,
+            PHG4HitContainer* g4hits_tpc,
+            PHG4HitContainer* g4hits_intt,
+            PHG4HitContainer* g4hits_mvtx,
+            PHG4HitContainer* g4hits_mms);
+
+  void clear();
+  bool filled() const { return m_filled; }
+
+  //! true if the cluster was in the container the tables were filled from
+  bool has_cluster(TrkrDefs::cluskey cluster_key) const { return find_cluster(cluster_key) < m_cluster_keys.size(); }
+
+  //! g4hits of a cluster, unique and sorted by pointer
+  std::span<PHG4Hit* const> g4hits(TrkrDefs::cluskey cluster_key) const;
+
+  //! particles contributing to a cluster, sorted by track id
+  std::span<const ParticleEnergy> particles(TrkrDefs::cluskey cluster_key) const;
+
+  //! clusters a particle (g4hit) contributes to, sorted by cluster key
+  std::span<const Entry<PHG4Particle>> clusters(PHG4Particle* particle) const;
+  std::span<const Entry<PHG4Hit>> clusters(PHG4Hit* g4hit) const;
+
+ private:
+  //! index of the cluster in m_cluster_keys, or m_cluster_keys.size() if not found
+  size_t find_cluster(TrkrDefs::cluskey cluster_key) const;
+
+  bool m_filled = false;
+
+  //! sorted cluster keys, the offset arrays have one more entry
+  std::vector<TrkrDefs::cluskey> m_cluster_keys;
+  std::vector<size_t> m_g4hit_offset;
+  std::vector<PHG4Hit*> m_g4hits;
+  std::vector<size_t> m_particle_offset;
+  std::vector<ParticleEnergy> m_particles;
+
+  std::vector<Entry<PHG4Particle>> m_particle_clusters;
+  std::vector<Entry<PHG4Hit>> m_g4hit_clusters;
+};
+
+#endif  // G4EVAL_SVTXCLUSTERTRUTHASSOC_H
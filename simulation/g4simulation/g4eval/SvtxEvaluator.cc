@@ -1,5 +1,7 @@
 #include "SvtxEvaluator.h"
 
+#include "EvalNtuple.h"
+#include "EvalNtupleFile.h"
 #include "SvtxEvalStack.h"
 
 #include "SvtxClusterEval.h"
@@ -47,8 +49,7 @@
 #include <phool/phool.h>
 #include <phool/recoConsts.h>
 
-#include <TFile.h>
-#include <TNtuple.h>
+#include <TROOT.h>
 #include <TVector3.h>
 
 #include <cmath>
@@ -85,68 +86,73 @@ int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
 {
   _ievent = 0;
 
-  _tfile = new TFile(_filename.c_str(), "RECREATE");
-  _tfile->SetCompressionLevel(0);
+  _tfile = new EvalNtupleFile(_filename);
+  if (_async_output)
+  {
+    // the trees are filled on the writer thread of the file
+    ROOT::EnableThreadSafety();
+  }
+  _tfile->set_async(_async_output);
   if (_do_info_eval)
   {
-    _ntp_info = new TNtuple("ntp_info", "event info",
-                            "event:seed:"
-                            "occ11:occ116:occ21:occ216:occ31:occ316:"
-                            "gntrkall:gntrkprim:ntrk:"
-                            "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
+    _ntp_info = _tfile->book("ntp_info", "event info",
+                             "event:seed:"
+                             "occ11:occ116:occ21:occ216:occ31:occ316:"
+                             "gntrkall:gntrkprim:ntrk:"
+                             "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
   }
 
   if (_do_vertex_eval)
   {
-    _ntp_vertex = new TNtuple("ntp_vertex", "vertex => max truth",
-                              "event:seed:vertexID:vx:vy:vz:ntracks:chi2:ndof:"
-                              "gvx:gvy:gvz:gvt:gembed:gntracks:gntracksmaps:"
-                              "gnembed:nfromtruth:"
-                              "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
+    _ntp_vertex = _tfile->book("ntp_vertex", "vertex => max truth",
+                               "event:seed:vertexID:vx:vy:vz:ntracks:chi2:ndof:"
+                               "gvx:gvy:gvz:gvt:gembed:gntracks:gntracksmaps:"
+                               "gnembed:nfromtruth:"
+                               "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
   }
 
   if (_do_gpoint_eval)
   {
-    _ntp_gpoint = new TNtuple("ntp_gpoint", "g4point => best vertex",
-                              "event:seed:gvx:gvy:gvz:gvt:gntracks:gembed:"
-                              "vx:vy:vz:ntracks:"
-                              "nfromtruth:"
-                              "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
+    _ntp_gpoint = _tfile->book("ntp_gpoint", "g4point => best vertex",
+                               "event:seed:gvx:gvy:gvz:gvt:gntracks:gembed:"
+                               "vx:vy:vz:ntracks:"
+                               "nfromtruth:"
+                               "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
   }
 
   if (_do_g4hit_eval)
   {
-    _ntp_g4hit = new TNtuple("ntp_g4hit", "g4hit => best svtxcluster",
-                             "event:seed:g4hitID:gx:gy:gz:gt:gpl:gedep:geta:gphi:"
-                             "gdphi:gdz:"
-                             "glayer:gtrackID:gflavor:"
-                             "gpx:gpy:gpz:"
-                             "gvx:gvy:gvz:"
-                             "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                             "gembed:gprimary:nclusters:"
-                             "clusID:x:y:z:eta:phi:e:adc:layer:size:"
-                             "efromtruth:dphitru:detatru:dztru:drtru:"
-                             "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
+    _ntp_g4hit = _tfile->book("ntp_g4hit", "g4hit => best svtxcluster",
+                              "event:seed:g4hitID:gx:gy:gz:gt:gpl:gedep:geta:gphi:"
+                              "gdphi:gdz:"
+                              "glayer:gtrackID:gflavor:"
+                              "gpx:gpy:gpz:"
+                              "gvx:gvy:gvz:"
+                              "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+                              "gembed:gprimary:nclusters:"
+                              "clusID:x:y:z:eta:phi:e:adc:layer:size:"
+                              "efromtruth:dphitru:detatru:dztru:drtru:"
+                              "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
   }
 
   if (_do_hit_eval)
   {
-    _ntp_hit = new TNtuple("ntp_hit", "svtxhit => max truth",
-                           "event:seed:hitID:e:adc:layer:phielem:zelem:"
-                           "cellID:ecell:phibin:zbin:phi:x:y:z:"
-                           "g4hitID:gedep:gx:gy:gz:gt:"
-                           "gtrackID:gflavor:"
-                           "gpx:gpy:gpz:gvx:gvy:gvz:gvt:"
-                           "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                           "gembed:gprimary:efromtruth:"
-                           "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
+    _ntp_hit = _tfile->book("ntp_hit", "svtxhit => max truth",
+                            "event:seed:hitID:e:adc:layer:phielem:zelem:"
+                            "cellID:ecell:phibin:zbin:phi:x:y:z:"
+                            "g4hitID:gedep:gx:gy:gz:gt:"
+                            "gtrackID:gflavor:"
+                            "gpx:gpy:gpz:gvx:gvy:gvz:gvt:"
+                            "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+                            "gembed:gprimary:efromtruth:"
+                            "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
   }
 
   if (_do_cluster_eval)
   {
-    _ntp_cluster = new TNtuple("ntp_cluster", "svtxcluster => max truth",
-                               "event:seed:hitID:x:y:z:r:phi:eta:theta:ex:ey:ez:ephi:pez:pephi:"
-                               "e:adc:maxadc:layer:phielem:zelem:size:phisize:zsize:"
+    _ntp_cluster = _tfile->book("ntp_cluster", "svtxcluster => max truth",
+                                "event:seed:hitID:x:y:z:r:phi:eta:theta:ex:ey:ez:ephi:pez:pephi:"
+                                "e:adc:maxadc:layer:phielem:zelem:size:phisize:zsize:"
 			       "pedge:redge:ovlp:"
                                "trackID:niter:g4hitID:gx:"
                                "gy:gz:gr:gphi:geta:gt:gtrackID:gflavor:"
@@ -158,22 +164,22 @@ int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
 
   if (_do_g4cluster_eval)
   {
-    _ntp_g4cluster = new TNtuple("ntp_g4cluster", "g4cluster => max truth",
-                                 "event:layer:gx:gy:gz:gt:gedep:gr:gphi:geta:gtrackID:gflavor:gembed:gprimary:gphisize:gzsize:gadc:nreco:x:y:z:r:phi:eta:ex:ey:ez:ephi:adc:phisize:zsize");
+    _ntp_g4cluster = _tfile->book("ntp_g4cluster", "g4cluster => max truth",
+                                  "event:layer:gx:gy:gz:gt:gedep:gr:gphi:geta:gtrackID:gflavor:gembed:gprimary:gphisize:gzsize:gadc:nreco:x:y:z:r:phi:eta:ex:ey:ez:ephi:adc:phisize:zsize");
   }
 
   if (_do_gtrack_eval)
   {
-    _ntp_gtrack = new TNtuple("ntp_gtrack", "g4particle => best svtxtrack",
-                              "event:seed:gntracks:gnchghad:gtrackID:gflavor:gnhits:gnmaps:gnintt:gnmms:"
-                              "gnintt1:gnintt2:gnintt3:gnintt4:"
-                              "gnintt5:gnintt6:gnintt7:gnintt8:"
-                              "gntpc:gnlmaps:gnlintt:gnltpc:gnlmms:"
-                              "gpx:gpy:gpz:gpt:geta:gphi:"
-                              "gvx:gvy:gvz:gvt:"
-                              "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
-                              "gembed:gprimary:"
-                              "trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
+    _ntp_gtrack = _tfile->book("ntp_gtrack", "g4particle => best svtxtrack",
+                               "event:seed:gntracks:gnchghad:gtrackID:gflavor:gnhits:gnmaps:gnintt:gnmms:"
+                               "gnintt1:gnintt2:gnintt3:gnintt4:"
+                               "gnintt5:gnintt6:gnintt7:gnintt8:"
+                               "gntpc:gnlmaps:gnlintt:gnltpc:gnlmms:"
+                               "gpx:gpy:gpz:gpt:geta:gphi:"
+                               "gvx:gvy:gvz:gvt:"
+                               "gfpx:gfpy:gfpz:gfx:gfy:gfz:"
+                               "gembed:gprimary:"
+                               "trackID:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
 			      "siqr:siphi:sithe:six0:siy0:tpqr:tpphi:tpthe:tpx0:tpy0:"
                               "charge:quality:chisq:ndf:nhits:layers:nmaps:nintt:ntpc:nmms:ntpc1:ntpc11:ntpc2:ntpc3:nlmaps:nlintt:nltpc:nlmms:"
                               "vertexID:vx:vy:vz:dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz:nfromtruth:nwrong:ntrumaps:nwrongmaps:ntruintt:nwrongintt:ntrutpc:nwrongtpc:ntrumms:nwrongmms:ntrutpc1:nwrongtpc1:ntrutpc11:nwrongtpc11:ntrutpc2:nwrongtpc2:ntrutpc3:nwrongtpc3:layersfromtruth:"
@@ -183,9 +189,9 @@ int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
 
   if (_do_track_eval)
   {
-    _ntp_track = new TNtuple("ntp_track", "svtxtrack => max truth",
-                             "event:seed:trackID:crossing:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
-                             "siqr:siphi:sithe:six0:siy0:tpqr:tpphi:tpthe:tpx0:tpy0:"
+    _ntp_track = _tfile->book("ntp_track", "svtxtrack => max truth",
+                              "event:seed:trackID:crossing:px:py:pz:pt:eta:phi:deltapt:deltaeta:deltaphi:"
+                              "siqr:siphi:sithe:six0:siy0:tpqr:tpphi:tpthe:tpx0:tpy0:"
 			     "charge:quality:chisq:ndf:nhits:nmaps:nintt:ntpc:nmms:ntpc1:ntpc11:ntpc2:ntpc3:nlmaps:nlintt:nltpc:nlmms:layers:"
                              "vertexID:vx:vy:vz:dca2d:dca2dsigma:dca3dxy:dca3dxysigma:dca3dz:dca3dzsigma:pcax:pcay:pcaz:"
                              "gtrackID:singlematch:gflavor:gnhits:gnmaps:gnintt:gntpc:gnmms:gnlmaps:gnlintt:gnltpc:gnlmms:"
@@ -200,14 +206,14 @@ int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
 
   if (_do_gseed_eval)
   {
-    _ntp_gseed = new TNtuple("ntp_gseed", "seeds from truth",
-                             "event:seed:ntrk:gx:gy:gz:gr:geta:gphi:"
-                             "glayer:"
-                             "gpx:gpy:gpz:gtpt:gtphi:gteta:"
-                             "gvx:gvy:gvz:"
-                             "gembed:gprimary:gflav:"
-                             "dphiprev:detaprev:"
-                             "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
+    _ntp_gseed = _tfile->book("ntp_gseed", "seeds from truth",
+                              "event:seed:ntrk:gx:gy:gz:gr:geta:gphi:"
+                              "glayer:"
+                              "gpx:gpy:gpz:gtpt:gtphi:gteta:"
+                              "gvx:gvy:gvz:"
+                              "gembed:gprimary:gflav:"
+                              "dphiprev:detaprev:"
+                              "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
   }
 
   _timer = new PHTimer("_eval_timer");
@@ -270,6 +276,7 @@ int SvtxEvaluator::process_event(PHCompositeNode* topNode)
   //---------------------------
 
   fillOutputNtuples(topNode);
+  _tfile->end_event(_ievent);
 
   //--------------------------------------------------
   // Print out the ancestry information for this event
@@ -283,49 +290,7 @@ int SvtxEvaluator::process_event(PHCompositeNode* topNode)
 
 int SvtxEvaluator::End(PHCompositeNode* /*topNode*/)
 {
-  _tfile->cd();
-
-  if (_ntp_info)
-  {
-    _ntp_info->Write();
-  }
-  if (_ntp_vertex)
-  {
-    _ntp_vertex->Write();
-  }
-  if (_ntp_gpoint)
-  {
-    _ntp_gpoint->Write();
-  }
-  if (_ntp_g4hit)
-  {
-    _ntp_g4hit->Write();
-  }
-  if (_ntp_hit)
-  {
-    _ntp_hit->Write();
-  }
-  if (_ntp_cluster)
-  {
-    _ntp_cluster->Write();
-  }
-  if (_ntp_g4cluster)
-  {
-    _ntp_g4cluster->Write();
-  }
-  if (_ntp_gtrack)
-  {
-    _ntp_gtrack->Write();
-  }
-  if (_ntp_track)
-  {
-    _ntp_track->Write();
-  }
-  if (_ntp_gseed)
-  {
-    _ntp_gseed->Write();
-  }
-
+  // writes the buffered rows and all trees
   _tfile->Close();
 
   delete _tfile;
@@ -19,8 +19,8 @@ class PHCompositeNode;
 class PHTimer;
 class TrkrCluster;
 class SvtxEvalStack;
-class TFile;
-class TNtuple;
+class EvalNtuple;
+class EvalNtupleFile;
 class SvtxTrack;
 class SvtxVertexMap;
 class GlobalVertexMap;
@@ -72,6 +72,9 @@ class SvtxEvaluator : public SubsysReco
   void do_vtx_eval_light(bool b) { _do_vtx_eval_light = b; }
   void scan_for_embedded(bool b) { _scan_for_embedded = b; }
   void scan_for_primaries(bool b) { _scan_for_primaries = b; }
+
+  //! fill the output trees on a separate thread
+  void set_async_output(bool b) { _async_output = b; }
   
  private:
   unsigned int _ievent = 0;
@@ -110,28 +113,29 @@ class SvtxEvaluator : public SubsysReco
   bool _do_vtx_eval_light = true;
   bool _scan_for_embedded = false;
   bool _scan_for_primaries = false;
+  bool _async_output = false;
 
   unsigned int _nlayers_maps = 3;
   unsigned int _nlayers_intt = 4;
   unsigned int _nlayers_tpc = 48;
   unsigned int _nlayers_mms = 2;
 
-  TNtuple *_ntp_info = nullptr;
-  TNtuple *_ntp_vertex = nullptr;
-  TNtuple *_ntp_gpoint = nullptr;
-  TNtuple *_ntp_g4hit = nullptr;
-  TNtuple *_ntp_hit = nullptr;
-  TNtuple *_ntp_cluster = nullptr;
-  TNtuple *_ntp_g4cluster = nullptr;
-  TNtuple *_ntp_gtrack = nullptr;
-  TNtuple *_ntp_track = nullptr;
-  TNtuple *_ntp_gseed = nullptr;
+  EvalNtuple *_ntp_info = nullptr;
+  EvalNtuple *_ntp_vertex = nullptr;
+  EvalNtuple *_ntp_gpoint = nullptr;
+  EvalNtuple *_ntp_g4hit = nullptr;
+  EvalNtuple *_ntp_hit = nullptr;
+  EvalNtuple *_ntp_cluster = nullptr;
+  EvalNtuple *_ntp_g4cluster = nullptr;
+  EvalNtuple *_ntp_gtrack = nullptr;
+  EvalNtuple *_ntp_track = nullptr;
+  EvalNtuple *_ntp_gseed = nullptr;
 
   // evaluator output file
   std::string _filename;
   // Track map name
   std::string _trackmapname;
-  TFile *_tfile = nullptr;
+  EvalNtupleFile *_tfile = nullptr;
 
   PHTimer *_timer = nullptr;
 
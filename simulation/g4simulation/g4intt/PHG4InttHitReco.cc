@@ -20,7 +20,6 @@
 #include <trackbase/TrkrHitSetContainerv1.h>
 #include <trackbase/TrkrHitTruthAssoc.h>
 #include <trackbase/TrkrHitTruthAssocv1.h>
-#include <trackbase/TrkrHitv2.h>  // for TrkrHit
 
 #include <phparameter/PHParameterInterface.h>  // for PHParameterInterface
 
@@ -147,6 +146,18 @@ int PHG4InttHitReco::InitRun(PHCompositeNode *topNode)
     DetNode->addNode(newNode);
   }
 
+  // flat TrkrHitSetv2 storage for the INTT hitsets, see TrkrHitSetContainerv1
+  if (m_use_flat_hitsets)
+  {
+    for (auto container : {hitsetcontainer, m_truth_hits})
+    {
+      if (auto *flat_container = dynamic_cast<TrkrHitSetContainerv1*>(container))
+      {
+        flat_container->setFlatHitSets(true);
+      }
+    }
+  }
+
   auto hittruthassoc = findNode::getClass<TrkrHitTruthAssoc>(topNode, "TRKR_HITTRUTHASSOC");
   if (!hittruthassoc)
   {
@@ -572,13 +583,8 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      TrkrHit *hit = hitsetit->second->getHit(hitkey);
-      if (!hit)
-      {
-        // Otherwise, create a new one
-        hit = new TrkrHitv2();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
-      }
+      // use the existing hit or create a new one
+      TrkrHit *hit = hitsetit->second->findOrAddHit(hitkey);
 
       // Either way, add the energy to it
       if (Verbosity() > 2)
@@ -700,15 +706,8 @@ void PHG4InttHitReco::addtruthhitset(
     return;
   }
   TrkrHitSetContainer::Iterator hitsetit = m_truth_hits->findOrAddHitSet(hitsetkey);
-  // See if this hit already exists
-  TrkrHit *hit = nullptr;
-  hit = hitsetit->second->getHit(hitkey);
-  if (!hit)
-  {
-    // create a new one
-    hit = new TrkrHitv2();
-    hitsetit->second->addHitSpecificKey(hitkey, hit);
-  }
+  // use the existing hit or create a new one
+  TrkrHit *hit = hitsetit->second->findOrAddHit(hitkey);
   // Either way, add the energy to it  -- adc values will be added at digitization
   hit->addEnergy(neffelectrons);
 }
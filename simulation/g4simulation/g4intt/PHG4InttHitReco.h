@@ -85,9 +85,13 @@ class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
   double m_pixel_thresholdrat{0.01};
   float max_g4hitstep{2.0};
   bool record_ClusHitsVerbose{false};
+  bool m_use_flat_hitsets{false};
 
  public:
   void set_pixel_thresholdrat(double val) { m_pixel_thresholdrat = val; };
+
+  //! store the INTT hits in TrkrHitSetv2 (changes the hitset class written to the DST)
+  void set_flat_hitsets(bool set = true) { m_use_flat_hitsets = set; };
   void set_max_g4hitstep(float _) { max_g4hitstep = _; };
 
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
@@ -30,11 +30,16 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <HepMC/GenEvent.h>
+#include <HepMC/GenParticle.h>
+#include <HepMC/GenVertex.h>
 #pragma GCC diagnostic pop
 
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
+#include <memory>
 #include <utility>
 
 // convenient aliases for deep copying nodes
@@ -44,6 +49,29 @@ namespace
   using PHG4VtxPoint_t = PHG4VtxPointv1;
   using PHG4Hit_t = PHG4Hitv1;
 
+  //! approximate size of a std::map entry, the value plus the node (color and three pointers)
+  template <class Map>
+  constexpr size_t map_entry_size()
+  {
+    return sizeof(typename Map::value_type) + 4 * sizeof(void *);
+  }
+
+  //! approximate memory used by a copied hepmc event
+  size_t genevent_size(const PHHepMCGenEvent *genevent)
+  {
+    size_t size = sizeof(PHHepMCGenEvent);
+    const HepMC::GenEvent *evt = genevent->getEvent();
+    if (evt)
+    {
+      // the GenEvent keeps particles and vertices in maps by barcode, the vertices
+      // have a pointer to each of their incoming and outgoing particles
+      size += sizeof(HepMC::GenEvent) +
+              evt->particles_size() * (sizeof(HepMC::GenParticle) + map_entry_size<std::map<int, HepMC::GenParticle *>>() + 2 * sizeof(HepMC::GenParticle *)) +
+              evt->vertices_size() * (sizeof(HepMC::GenVertex) + map_entry_size<std::map<int, HepMC::GenVertex *>>());
+    }
+    return size;
+  }
+
   //! utility class to find all PHG4Hit container nodes from the DST node
   class FindG4HitContainer : public PHNodeOperation
   {
@@ -110,6 +138,70 @@ void Fun4AllDstPileupMerger::load_nodes(PHCompositeNode *dstNode)
   }
 }
 
+//_____________________________________________________________________________
+Fun4AllDstPileupMerger::BackgroundEvent::BackgroundEvent() = default;
+
+//_____________________________________________________________________________
+Fun4AllDstPileupMerger::BackgroundEvent::~BackgroundEvent() = default;
+
+//_____________________________________________________________________________
+std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent> Fun4AllDstPileupMerger::load_background_event(PHCompositeNode *dstNode)
+{
+  std::unique_ptr<BackgroundEvent> event(new BackgroundEvent);
+
+  // hepmc
+  const auto map = findNode::getClass<PHHepMCGenEventMap>(dstNode, "PHHepMCGenEventMap");
+  if (map)
+  {
+    if (map->size() != 1)
+    {
+      std::cout << "Fun4AllDstPileupMerger::load_background_event - cannot merge events that contain more than one PHHepMCGenEventMap" << std::endl;
+      return nullptr;
+    }
+    event->genevent.reset(static_cast<PHHepMCGenEvent *>(map->get_map().begin()->second->CloneMe()));
+    event->size += genevent_size(event->genevent.get());
+  }
+
+  // truth information, with the same ids as in the source
+  const auto container_truth = findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo");
+  if (container_truth)
+  {
+    event->truthinfo.reset(new PHG4TruthInfoContainer);
+    const auto vtxrange = container_truth->GetVtxRange();
+    for (auto iter = vtxrange.first; iter != vtxrange.second; ++iter)
+    {
+      event->truthinfo->AddVertex(iter->first, new PHG4VtxPoint_t(iter->second));
+    }
+    const auto range = container_truth->GetParticleRange();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      event->truthinfo->AddParticle(iter->first, new PHG4Particle_t(iter->second));
+    }
+    event->size += container_truth->size() * (sizeof(PHG4Particle_t) + map_entry_size<PHG4TruthInfoContainer::Map>()) +
+                   container_truth->GetNumVertices() * (sizeof(PHG4VtxPoint_t) + map_entry_size<PHG4TruthInfoContainer::VtxMap>());
+  }
+
+  // g4hits, stored by value
+  FindG4HitContainer nodeFinder;
+  PHNodeIterator(dstNode).forEach(nodeFinder);
+  for (const auto &[name, container_hit] : nodeFinder.containers())
+  {
+    auto &hits = event->hits[name];
+    hits.reserve(container_hit->size());
+    size_t nproperties = 0;
+    const auto range = container_hit->getHits();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      nproperties += hits.emplace_back(iter->second).get_property_count();
+    }
+    const auto layerrange = container_hit->getLayers();
+    event->layers[name].insert(layerrange.first, layerrange.second);
+    // the additional properties of each hit are map entries of their own
+    event->size += hits.size() * sizeof(PHG4Hit_t) + nproperties * map_entry_size<std::map<uint8_t, uint32_t>>();
+  }
+  return event;
+}
+
 //_____________________________________________________________________________
 void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, double delta_t) const
 {
@@ -128,249 +220,319 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
     }
 
     // get event and insert in new map
-    auto genevent = map->get_map().begin()->second;
-    auto newevent = m_geneventmap->insert_background_event(genevent);
-
-    /*
-     * this hack prevents a crash when writting out
-     * it boils down to root trying to write deleted items from the HepMC::GenEvent copy if the source has been deleted
-     * it does not happen if the source gets written while the copy is deleted
-     */
-    newevent->getEvent()->swap(*genevent->getEvent());
-
-    // shift vertex time and store new embed id
-    newevent->moveVertex(0, 0, 0, delta_t);
-    new_embed_id = newevent->get_embedding_id();
+    new_embed_id = copy_genevent(map->get_map().begin()->second, delta_t);
   }
 
   // copy truth container
-  // keep track of the correspondance between source index and destination index for vertices, tracks and showers
-  using ConversionMap = std::map<int, int>;
-  ConversionMap vtxid_map;
+  // keep track of the correspondance between source index and destination index for tracks
   ConversionMap trkid_map;
-
   const auto container_truth = findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo");
   if (container_truth && m_g4truthinfo)
   {
-    {
-      // primary vertices
-      auto key = m_g4truthinfo->maxvtxindex();
-      const auto range = container_truth->GetPrimaryVtxRange();
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        // clone vertex, insert in map, and add index conversion
-        const auto &sourceVertex = iter->second;
-        auto newVertex = new PHG4VtxPoint_t(sourceVertex);
-        newVertex->set_t(sourceVertex->get_t() + delta_t);
-        m_g4truthinfo->AddVertex(++key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
-      }
-    }
+    copy_truth(container_truth, delta_t, new_embed_id, trkid_map);
+  }
 
+  // copy g4hits
+  // loop over registered maps
+  for (const auto &pair : m_g4hitscontainers)
+  {
+    // check destination node
+    if (!pair.second)
     {
-      // secondary vertices
-      auto key = m_g4truthinfo->minvtxindex();
-      const auto range = container_truth->GetSecondaryVtxRange();
-
-      // loop from last to first to preserve order with respect to the original event
-      for (
-          auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.second);
-          iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.first);
-          ++iter)
-      {
-        // clone vertex, shift time, insert in map, and add index conversion
-        const auto &sourceVertex = iter->second;
-        auto newVertex = new PHG4VtxPoint_t(sourceVertex);
-        newVertex->set_t(sourceVertex->get_t() + delta_t);
-        m_g4truthinfo->AddVertex(--key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
-      }
+      std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid destination container " << pair.first << std::endl;
+      continue;
     }
 
+    // find source node
+    auto container_hit = findNode::getClass<PHG4HitContainer>(dstNode, pair.first);
+    if (!container_hit)
     {
-      // primary particles
-      auto key = m_g4truthinfo->maxtrkindex();
-      const auto range = container_truth->GetPrimaryParticleRange();
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        const auto &source = iter->second;
-        auto dest = new PHG4Particle_t(source);
-        m_g4truthinfo->AddParticle(++key, dest);
-        dest->set_track_id(key);
-
-        // set parent to zero
-        dest->set_parent_id(0);
-
-        // set primary to itself
-        dest->set_primary_id(dest->get_track_id());
-
-        // update vertex
-        const auto keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
-        {
-          dest->set_vtx_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
-        }
-
-        // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
-      }
+      std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid source container " << pair.first << std::endl;
+      continue;
     }
-
+    if (!is_in_time_window(pair.first, delta_t))
     {
-      // secondary particles
-      auto key = m_g4truthinfo->mintrkindex();
-      const auto range = container_truth->GetSecondaryParticleRange();
-
-      /*
-       * loop from last to first to preserve order with respect to the original event
-       * also this ensures that for a given particle its parent has already been converted and thus found in the map
-       */
-      for (
-          auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.second);
-          iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.first);
-          ++iter)
-      {
-        const auto &source = iter->second;
-        auto dest = new PHG4Particle_t(source);
-        m_g4truthinfo->AddParticle(--key, dest);
-        dest->set_track_id(key);
-
-        // update parent id
-        auto keyiter = trkid_map.find(source->get_parent_id());
-        if (keyiter != trkid_map.end())
-        {
-          dest->set_parent_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_parent_id() << " not found in map" << std::endl;
-        }
-
-        // update primary id
-        keyiter = trkid_map.find(source->get_primary_id());
-        if (keyiter != trkid_map.end())
-        {
-          dest->set_primary_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_primary_id() << " not found in map" << std::endl;
-        }
-
-        // update vertex
-        keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
-        {
-          dest->set_vtx_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
-        }
-
-        // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
-      }
+      continue;
     }
-
-    // vertex embed flags
-    /* embed flag is stored only for primary vertices, consistently with PHG4TruthEventAction */
-    for (const auto &pair : vtxid_map)
     {
-      if (pair.first > 0)
+      // hits
+      const auto range = container_hit->getHits();
+      for (auto iter = range.first; iter != range.second; ++iter)
       {
-        m_g4truthinfo->AddEmbededVtxId(pair.second, new_embed_id);
+        copy_hit(iter->second, pair.second, delta_t, trkid_map);
       }
     }
 
-    // track embed flags
-    /* embed flag is stored only for primary tracks, consistently with PHG4TruthEventAction */
-    for (const auto &pair : trkid_map)
     {
-      if (pair.first > 0)
+      // layers
+      const auto range = container_hit->getLayers();
+      for (auto iter = range.first; iter != range.second; ++iter)
       {
-        m_g4truthinfo->AddEmbededTrkId(pair.second, new_embed_id);
+        pair.second->AddLayer(*iter);
       }
     }
   }
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_background_event(BackgroundEvent &event, double delta_t) const
+{
+  int new_embed_id = -1;
+  if (event.genevent && m_geneventmap)
+  {
+    new_embed_id = copy_genevent(event.genevent.get(), delta_t);
+  }
+
+  ConversionMap trkid_map;
+  if (event.truthinfo && m_g4truthinfo)
+  {
+    copy_truth(event.truthinfo.get(), delta_t, new_embed_id, trkid_map);
+  }
 
-  // copy g4hits
-  // loop over registered maps
   for (const auto &pair : m_g4hitscontainers)
   {
-    // check destination node
     if (!pair.second)
     {
       std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid destination container " << pair.first << std::endl;
       continue;
     }
 
-    // find source node
-    auto container_hit = findNode::getClass<PHG4HitContainer>(dstNode, pair.first);
-    if (!container_hit)
+    const auto hititer = event.hits.find(pair.first);
+    if (hititer == event.hits.end())
     {
       std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid source container " << pair.first << std::endl;
       continue;
     }
-    auto detiter = m_DetectorTiming.find(pair.first);
-    // apply special  cuts for selected detectors
-    if (detiter != m_DetectorTiming.end())
+    if (!is_in_time_window(pair.first, delta_t))
     {
-      if (delta_t < detiter->second.first || delta_t > detiter->second.second)
-      {
-        continue;
-      }
+      continue;
     }
+    for (const auto &hit : hititer->second)
     {
-      // hits
-      const auto range = container_hit->getHits();
-      for (auto iter = range.first; iter != range.second; ++iter)
+      copy_hit(&hit, pair.second, delta_t, trkid_map);
+    }
+    for (const auto &layer : event.layers[pair.first])
+    {
+      pair.second->AddLayer(layer);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+int Fun4AllDstPileupMerger::copy_genevent(PHHepMCGenEvent *genevent, double delta_t) const
+{
+  auto newevent = m_geneventmap->insert_background_event(genevent);
+
+  /*
+   * this hack prevents a crash when writting out
+   * it boils down to root trying to write deleted items from the HepMC::GenEvent copy if the source has been deleted
+   * it does not happen if the source gets written while the copy is deleted
+   */
+  newevent->getEvent()->swap(*genevent->getEvent());
+
+  // shift vertex time and return new embed id
+  newevent->moveVertex(0, 0, 0, delta_t);
+  return newevent->get_embedding_id();
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_truth(const PHG4TruthInfoContainer *container_truth, double delta_t, int new_embed_id, ConversionMap &trkid_map) const
+{
+  // keep track of the correspondance between source index and destination index for vertices
+  ConversionMap vtxid_map;
+
+  {
+    // primary vertices
+    auto key = m_g4truthinfo->maxvtxindex();
+    const auto range = container_truth->GetPrimaryVtxRange();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      // clone vertex, insert in map, and add index conversion
+      const auto &sourceVertex = iter->second;
+      auto newVertex = new PHG4VtxPoint_t(sourceVertex);
+      newVertex->set_t(sourceVertex->get_t() + delta_t);
+      m_g4truthinfo->AddVertex(++key, newVertex);
+      vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+    }
+  }
+
+  {
+    // secondary vertices
+    auto key = m_g4truthinfo->minvtxindex();
+    const auto range = container_truth->GetSecondaryVtxRange();
+
+    // loop from last to first to preserve order with respect to the original event
+    for (
+        auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.second);
+        iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.first);
+        ++iter)
+    {
+      // clone vertex, shift time, insert in map, and add index conversion
+      const auto &sourceVertex = iter->second;
+      auto newVertex = new PHG4VtxPoint_t(sourceVertex);
+      newVertex->set_t(sourceVertex->get_t() + delta_t);
+      m_g4truthinfo->AddVertex(--key, newVertex);
+      vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+    }
+  }
+
+  {
+    // primary particles
+    auto key = m_g4truthinfo->maxtrkindex();
+    const auto range = container_truth->GetPrimaryParticleRange();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const auto &source = iter->second;
+      auto dest = new PHG4Particle_t(source);
+      m_g4truthinfo->AddParticle(++key, dest);
+      dest->set_track_id(key);
+
+      // set parent to zero
+      dest->set_parent_id(0);
+
+      // set primary to itself
+      dest->set_primary_id(dest->get_track_id());
+
+      // update vertex
+      const auto keyiter = vtxid_map.find(source->get_vtx_id());
+      if (keyiter != vtxid_map.end())
       {
-        // clone hit
-        const auto &sourceHit = iter->second;
-        auto newHit = new PHG4Hit_t(sourceHit);
-
-        // shift time
-        newHit->set_t(0, sourceHit->get_t(0) + delta_t);
-        newHit->set_t(1, sourceHit->get_t(1) + delta_t);
-
-        // update track id
-        const auto keyiter = trkid_map.find(sourceHit->get_trkid());
-        if (keyiter != trkid_map.end())
-        {
-          newHit->set_trkid(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
-        }
-
-        /*
-         * reset shower ids
-         * it was decided that showers from the background events will not be copied to the merged event
-         * as such we just reset the hits shower id
-         */
-        newHit->set_shower_id(std::numeric_limits<int>::min());
-
-        /*
-         * this will generate a new key for the hit and assign it to the hit
-         * this ensures that there is no conflict with the hits from the 'main' event
-         */
-        pair.second->AddHit(newHit->get_detid(), newHit);
+        dest->set_vtx_id(keyiter->second);
       }
+      else
+      {
+        std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
+      }
+
+      // insert in map
+      trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
     }
+  }
+
+  {
+    // secondary particles
+    auto key = m_g4truthinfo->mintrkindex();
+    const auto range = container_truth->GetSecondaryParticleRange();
 
+    /*
+     * loop from last to first to preserve order with respect to the original event
+     * also this ensures that for a given particle its parent has already been converted and thus found in the map
+     */
+    for (
+        auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.second);
+        iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.first);
+        ++iter)
     {
-      // layers
-      const auto range = container_hit->getLayers();
-      for (auto iter = range.first; iter != range.second; ++iter)
+      const auto &source = iter->second;
+      auto dest = new PHG4Particle_t(source);
+      m_g4truthinfo->AddParticle(--key, dest);
+      dest->set_track_id(key);
+
+      // update parent id
+      auto keyiter = trkid_map.find(source->get_parent_id());
+      if (keyiter != trkid_map.end())
       {
-        pair.second->AddLayer(*iter);
+        dest->set_parent_id(keyiter->second);
+      }
+      else
+      {
+        std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_parent_id() << " not found in map" << std::endl;
       }
+
+      // update primary id
+      keyiter = trkid_map.find(source->get_primary_id());
+      if (keyiter != trkid_map.end())
+      {
+        dest->set_primary_id(keyiter->second);
+      }
+      else
+      {
+        std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_primary_id() << " not found in map" << std::endl;
+      }
+
+      // update vertex
+      keyiter = vtxid_map.find(source->get_vtx_id());
+      if (keyiter != vtxid_map.end())
+      {
+        dest->set_vtx_id(keyiter->second);
+      }
+      else
+      {
+        std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
+      }
+
+      // insert in map
+      trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
+    }
+  }
+
+  // vertex embed flags
+  /* embed flag is stored only for primary vertices, consistently with PHG4TruthEventAction */
+  for (const auto &pair : vtxid_map)
+  {
+    if (pair.first > 0)
+    {
+      m_g4truthinfo->AddEmbededVtxId(pair.second, new_embed_id);
+    }
+  }
+
+  // track embed flags
+  /* embed flag is stored only for primary tracks, consistently with PHG4TruthEventAction */
+  for (const auto &pair : trkid_map)
+  {
+    if (pair.first > 0)
+    {
+      m_g4truthinfo->AddEmbededTrkId(pair.second, new_embed_id);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+bool Fun4AllDstPileupMerger::is_in_time_window(const std::string &name, double delta_t) const
+{
+  // apply special  cuts for selected detectors
+  auto detiter = m_DetectorTiming.find(name);
+  if (detiter != m_DetectorTiming.end())
+  {
+    if (delta_t < detiter->second.first || delta_t > detiter->second.second)
+    {
+      return false;
     }
   }
+  return true;
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_hit(const PHG4Hit *sourceHit, PHG4HitContainer *container, double delta_t, const ConversionMap &trkid_map) const
+{
+  // clone hit
+  auto newHit = new PHG4Hit_t(sourceHit);
+
+  // shift time
+  newHit->set_t(0, sourceHit->get_t(0) + delta_t);
+  newHit->set_t(1, sourceHit->get_t(1) + delta_t);
+
+  // update track id
+  const auto keyiter = trkid_map.find(sourceHit->get_trkid());
+  if (keyiter != trkid_map.end())
+  {
+    newHit->set_trkid(keyiter->second);
+  }
+  else
+  {
+    std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
+  }
+
+  /*
+   * reset shower ids
+   * it was decided that showers from the background events will not be copied to the merged event
+   * as such we just reset the hits shower id
+   */
+  newHit->set_shower_id(std::numeric_limits<int>::min());
+
+  /*
+   * this will generate a new key for the hit and assign it to the hit
+   * this ensures that there is no conflict with the hits from the 'main' event
+   */
+  container->AddHit(newHit->get_detid(), newHit);
 }
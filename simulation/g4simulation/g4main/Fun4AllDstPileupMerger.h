@@ -8,13 +8,20 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include <cstddef>  // for size_t
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
+class PHG4Hit;
+class PHG4Hitv1;
 class PHG4HitContainer;
 class PHG4TruthInfoContainer;
+class PHHepMCGenEvent;
 class PHHepMCGenEventMap;
 
 /*!
@@ -31,15 +38,54 @@ class Fun4AllDstPileupMerger final
   //! destructor
   ~Fun4AllDstPileupMerger() = default;
 
+  /*!
+   * background event copied out of the input nodes, so that it can be kept in memory
+   * and merged several times. Hits are stored by value, per hit container name
+   */
+  class BackgroundEvent
+  {
+   public:
+    BackgroundEvent();
+    ~BackgroundEvent();
+
+    std::unique_ptr<PHHepMCGenEvent> genevent;
+    std::unique_ptr<PHG4TruthInfoContainer> truthinfo;
+    std::map<std::string, std::vector<PHG4Hitv1>> hits;
+    std::map<std::string, std::set<unsigned int>> layers;
+
+    //! approximate memory used by the hepmc event, hits and truth information, including the map entries (bytes)
+    size_t size = 0;
+  };
+
+  //! copy the current content of source nodes into a background event
+  static std::unique_ptr<BackgroundEvent> load_background_event(PHCompositeNode *);
+
   //! load destination nodes from composite
   void load_nodes(PHCompositeNode *);
 
   //! time-shift and copy content of source nodes to destination
   void copy_background_event(PHCompositeNode *, double delta_t) const;
 
+  //! time-shift and copy content of an in-memory background event to destination
+  void copy_background_event(BackgroundEvent &, double delta_t) const;
+
   void copyDetectorActiveCrossings(const std::map<std::string, std::pair<double, double>> &dmap) { m_DetectorTiming = dmap; }
 
  private:
+  using ConversionMap = std::map<int, int>;
+
+  //! insert time-shifted hepmc event as background, returns its embedding id
+  int copy_genevent(PHHepMCGenEvent *, double delta_t) const;
+
+  //! copy time-shifted truth information, fills the source to destination track id conversion
+  void copy_truth(const PHG4TruthInfoContainer *, double delta_t, int new_embed_id, ConversionMap &trkid_map) const;
+
+  //! false if the hits of a given container are outside of the detector active time window
+  bool is_in_time_window(const std::string &name, double delta_t) const;
+
+  //! copy time-shifted hit to destination container
+  void copy_hit(const PHG4Hit *, PHG4HitContainer *, double delta_t, const ConversionMap &trkid_map) const;
+
   //! hepmc
   PHHepMCGenEventMap *m_geneventmap = nullptr;
 
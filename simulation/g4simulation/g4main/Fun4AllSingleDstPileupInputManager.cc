@@ -27,7 +27,7 @@
 
 #include <cassert>
 #include <iostream>  // for operator<<, basic_ostream, endl
-#include <utility>   // for pair
+#include <utility>   // for pair, move
 
 //_____________________________________________________________________________
 Fun4AllSingleDstPileupInputManager::Fun4AllSingleDstPileupInputManager(const std::string &name, const std::string &nodename, const std::string &topnodename)
@@ -227,6 +227,12 @@ readagain:
   Fun4AllDstPileupMerger merger;
   merger.load_nodes(m_dstNode);
 
+  // refill the background pool once its events have been used often enough
+  if (m_pool_size > 0 && (m_background_pool.empty() || m_pool_nused >= m_pool_reuse * m_background_pool.size()))
+  {
+    fill_background_pool();
+  }
+
   // generate background collisions
   const double mu = m_collision_rate * m_time_between_crossings * 1e-9;
 
@@ -240,6 +246,22 @@ readagain:
     const int ncollisions = gsl_ran_poisson(m_rng.get(), mu);
     for (int icollision = 0; icollision < ncollisions; ++icollision)
     {
+      if (m_pool_size > 0)
+      {
+        if (m_background_pool.empty())
+        {
+          break;
+        }
+        const auto index = gsl_rng_uniform_int(m_rng.get(), m_background_pool.size());
+        if (Verbosity() > 0)
+        {
+          std::cout << "Fun4AllSingleDstPileupInputManager::run - merged pooled background event " << index << " time: " << crossing_time << std::endl;
+        }
+        merger.copy_background_event(*m_background_pool[index], crossing_time);
+        ++m_pool_nused;
+        continue;
+      }
+
       // try read
       if (!m_IManager_background->read(m_dstNodeInternal.get(), ievent_thisfile))
       {
@@ -267,6 +289,52 @@ readagain:
   return 0;
 }
 
+//_____________________________________________________________________________
+void Fun4AllSingleDstPileupInputManager::fill_background_pool()
+{
+  /*
+   * events are read from the current file position, the trigger events
+   * are then moved past them so that no event is used as both trigger and background.
+   * The previous pool is kept if the file has no more events
+   */
+  std::vector<std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent>> pool;
+  const double max_size = m_pool_memory * 1024 * 1024;
+  double pool_memory = 0;
+  int ievent_thisfile = m_ievent_thisfile;
+  while (pool.size() < m_pool_size && pool_memory < max_size)
+  {
+    if (!m_IManager_background->read(m_dstNodeInternal.get(), ievent_thisfile))
+    {
+      break;
+    }
+    ++ievent_thisfile;
+    auto event = Fun4AllDstPileupMerger::load_background_event(m_dstNodeInternal.get());
+    if (event)
+    {
+      pool_memory += event->size;
+      pool.push_back(std::move(event));
+    }
+  }
+
+  const int nevents = ievent_thisfile - m_ievent_thisfile;
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllSingleDstPileupInputManager::fill_background_pool - loaded " << pool.size()
+              << " background events from " << nevents << " events, " << pool_memory / (1024 * 1024) << " MB" << std::endl;
+  }
+  if (!pool.empty())
+  {
+    m_background_pool = std::move(pool);
+  }
+  m_pool_nused = 0;
+
+  // jump event counter past the events used for the pool
+  if (nevents > 0)
+  {
+    PushBackEvents(-nevents);
+  }
+}
+
 //_____________________________________________________________________________
 int Fun4AllSingleDstPileupInputManager::fileclose()
 {
@@ -277,6 +345,8 @@ int Fun4AllSingleDstPileupInputManager::fileclose()
   }
   m_IManager.reset();
   m_IManager_background.reset();
+  m_background_pool.clear();
+  m_pool_nused = 0;
   IsOpen(0);
   UpdateFileList();
   return 0;
@@ -8,6 +8,8 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "Fun4AllDstPileupMerger.h"
+
 #include <fun4all/Fun4AllInputManager.h>
 #include <fun4all/Fun4AllReturnCodes.h>
 
@@ -17,9 +19,11 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <cstddef>  // for size_t
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 /*!
  * dedicated input manager that merges single events into "merged" events, containing a trigger event
@@ -61,7 +65,30 @@ class Fun4AllSingleDstPileupInputManager : public Fun4AllInputManager
     m_tmax = tmax;
   }
 
+  /*!
+   * preload up to nevents background events in memory and sample the pile-up collisions from them
+   * instead of reading them from file for each trigger event. 0 (the default) disables the pool
+   */
+  void setBackgroundPoolSize(unsigned int nevents)
+  {
+    m_pool_size = nevents;
+  }
+
+  //! maximum memory used by the background pool (MB)
+  void setBackgroundPoolMemory(double mb)
+  {
+    m_pool_memory = mb;
+  }
+
+  //! average number of times each pooled event is merged before the pool is refilled with the next events of the file
+  void setBackgroundPoolReuse(double factor)
+  {
+    m_pool_reuse = factor;
+  }
+
  private:
+  //! (re)fill the background pool from the events following the current trigger event
+  void fill_background_pool();
   //!@name event counters
   //@{
   bool m_ReadRunTTree = true;
@@ -116,6 +143,18 @@ class Fun4AllSingleDstPileupInputManager : public Fun4AllInputManager
   };
 
   std::unique_ptr<gsl_rng, Deleter> m_rng;
+
+  //!@name in-memory background pool
+  //@{
+  unsigned int m_pool_size = 0;
+  double m_pool_memory = 2000;
+  double m_pool_reuse = 10;
+
+  //! number of collisions sampled since the pool was last filled
+  size_t m_pool_nused = 0;
+
+  std::vector<std::unique_ptr<Fun4AllDstPileupMerger::BackgroundEvent>> m_background_pool;
+  //@}
 };
 
 #endif /* __Fun4AllSingleDstPileupInputManager_H__ */
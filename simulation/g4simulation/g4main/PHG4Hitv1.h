@@ -20,6 +20,9 @@ class PHG4Hitv1 : public PHG4Hit
   void identify(std::ostream& os = std::cout) const override;
   void Reset() override;
 
+  //! number of additional properties which are set
+  size_t get_property_count() const { return prop_map.size(); }
+
   // The indices here represent the entry and exit points of the particle
   float get_x(const int i) const override { return x[i]; }
   float get_y(const int i) const override { return y[i]; }
@@ -15,7 +15,6 @@
 #include <trackbase/TrkrHitSetContainerv1.h>
 #include <trackbase/TrkrHitTruthAssoc.h>  // make iwyu happy
 #include <trackbase/TrkrHitTruthAssocv1.h>
-#include <trackbase/TrkrHitv2.h>  // for TrkrHit
 
 #include <g4tracking/TrkrTruthTrack.h>
 #include <g4tracking/TrkrTruthTrackContainer.h>
@@ -145,6 +144,18 @@ int PHG4MvtxHitReco::InitRun(PHCompositeNode* topNode)
     trkrnode->addNode(newNode);
   }
 
+  // flat TrkrHitSetv2 storage for the MVTX hitsets, see TrkrHitSetContainerv1
+  if (m_use_flat_hitsets)
+  {
+    for (auto container : {hitsetcontainer, m_truth_hits})
+    {
+      if (auto flat_container = dynamic_cast<TrkrHitSetContainerv1*>(container))
+      {
+        flat_container->setFlatHitSets(true);
+      }
+    }
+  }
+
   // create hit truth association if needed
   auto hittruthassoc = findNode::getClass<TrkrHitTruthAssoc>(topNode, "TRKR_HITTRUTHASSOC");
   if (!hittruthassoc)
@@ -702,10 +713,8 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
           if ((std::find(m_deadPixelMap.begin(), m_deadPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_deadPixelMap.end()) && (std::find(m_hotPixelMap.begin(), m_hotPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_hotPixelMap.end()))
           {
             // create hit and insert in hitset
-            hit = new TrkrHitv2();
-
+            hit = hitsetit->second->findOrAddHit(hitkey);
             hit->addEnergy(hitenergy);
-            hitsetit->second->addHitSpecificKey(hitkey, hit);
           }
           else
           {
@@ -918,15 +927,8 @@ void PHG4MvtxHitReco::addtruthhitset(
     return;
   }
   TrkrHitSetContainer::Iterator hitsetit = m_truth_hits->findOrAddHitSet(hitsetkey);
-  // See if this hit already exists
-  TrkrHit* hit = nullptr;
-  hit = hitsetit->second->getHit(hitkey);
-  if (!hit)
-  {
-    // create a new one
-    hit = new TrkrHitv2();
-    hitsetit->second->addHitSpecificKey(hitkey, hit);
-  }
+  // use the existing hit or create a new one
+  TrkrHit* hit = hitsetit->second->findOrAddHit(hitkey);
   // Either way, add the energy to it  -- adc values will be added at digitization
   hit->addEnergy(neffelectrons);
 }
@@ -1080,9 +1082,7 @@ void PHG4MvtxHitReco::cluster_truthhits(PHCompositeNode* topNode)
             std::cout << "                          copying over hitkey " << hitkey << std::endl;
           }
           auto old_hit = hitr->second;
-          TrkrHit* new_hit = new TrkrHitv2();
-          new_hit->setAdc(old_hit->getAdc());
-          bare_hitset->addHitSpecificKey(hitkey, new_hit);
+          bare_hitset->findOrAddHit(hitkey)->setAdc(old_hit->getAdc());
         }
 
         // all hits are copied over to the strobe zero hitset, remove this hitset
@@ -107,10 +107,14 @@ class PHG4MvtxHitReco : public SubsysReco, public PHParameterInterface
   double m_pixel_thresholdrat{0.01};
   float max_g4hitstep{3.5};
   bool record_ClusHitsVerbose{false};
+  bool m_use_flat_hitsets{false};
 
  public:
   void set_pixel_thresholdrat(double val) { m_pixel_thresholdrat = val; };
 
+  //! store the MVTX hits in TrkrHitSetv2 (changes the hitset class written to the DST)
+  void set_flat_hitsets(bool set = true) { m_use_flat_hitsets = set; };
+
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
   ClusHitsVerbosev1* mClusHitsVerbose{nullptr};
 };
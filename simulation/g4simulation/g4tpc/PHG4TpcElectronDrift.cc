@@ -543,157 +543,164 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
     }
 
     int notReachingReadout = 0;
-    //    int notInAcceptance = 0;
-    for (unsigned int i = 0; i < n_electrons; i++)
+    if (m_batched_drift)
     {
-      // We choose the electron starting position at random from a flat
-      // distribution along the path length the parameter t is the fraction of
-      // the distance along the path betwen entry and exit points, it has
-      // values between 0 and 1
-      const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
-
-      const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
-      const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
-      const double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
-      const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
-
-      unsigned int side = 0;
-      if (z_start > 0)
-      {
-        side = 1;
-      }
-
-      const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
-      const double rantrans =
-          gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
-
-      const double t_path = (tpc_length / 2. - std::abs(z_start)) / drift_velocity;
-      const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / drift_velocity;
-      const double rantime =
-          gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / drift_velocity;
-      double t_final = t_start + t_path + rantime;
-
-      if (t_final < min_time || t_final > max_time)
-      {
-        continue;
-      }
-
-      double z_final;
-      if (z_start < 0)
-      {
-        z_final = -tpc_length / 2. + t_final * drift_velocity;
-      }
-      else
+      notReachingReadout = drift_electrons_batched(hiter, n_electrons, ihit);
+    }
+    else
+    {
+      //    int notInAcceptance = 0;
+      for (unsigned int i = 0; i < n_electrons; i++)
       {
-        z_final = tpc_length / 2. - t_final * drift_velocity;
-      }
-
-      const double radstart = std::sqrt(square(x_start) + square(y_start));
-      const double phistart = std::atan2(y_start, x_start);
-      const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
-
-      double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
-      double y_final = y_start + rantrans * std::sin(ranphi);
+        // We choose the electron starting position at random from a flat
+        // distribution along the path length the parameter t is the fraction of
+        // the distance along the path betwen entry and exit points, it has
+        // values between 0 and 1
+        const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
+
+        const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
+        const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
+        const double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
+        const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
+
+        unsigned int side = 0;
+        if (z_start > 0)
+        {
+          side = 1;
+        }
 
-      double rad_final = sqrt(square(x_final) + square(y_final));
-      double phi_final = atan2(y_final, x_final);
+        const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
+        const double rantrans =
+            gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
 
-      if (do_ElectronDriftQAHistos)
-      {
-        z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
-        deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
-        deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
-      }
+        const double t_path = (tpc_length / 2. - std::abs(z_start)) / drift_velocity;
+        const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / drift_velocity;
+        const double rantime =
+            gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / drift_velocity;
+        double t_final = t_start + t_path + rantime;
 
-      if (m_distortionMap)
-      {
-        // zhangcanyu
-        const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
-        if (reaches < thresholdforreachesreadout)
+        if (t_final < min_time || t_final > max_time)
         {
-          notReachingReadout++;
           continue;
         }
 
-        const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
-        const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
-        const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
-
-        rad_final += r_distortion;
-        phi_final += phi_distortion;
-        z_final += z_distortion;
+        double z_final;
         if (z_start < 0)
         {
-          t_final = (z_final + tpc_length / 2.0) / drift_velocity;
+          z_final = -tpc_length / 2. + t_final * drift_velocity;
         }
         else
         {
-          t_final = (tpc_length / 2.0 - z_final) / drift_velocity;
+          z_final = tpc_length / 2. - t_final * drift_velocity;
         }
 
-        x_final = rad_final * std::cos(phi_final);
-        y_final = rad_final * std::sin(phi_final);
+        const double radstart = std::sqrt(square(x_start) + square(y_start));
+        const double phistart = std::atan2(y_start, x_start);
+        const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
 
-        //	if(i < 1)
-        //{std::cout << " electron " << i << " r_distortion " << r_distortion << " phi_distortion " << phi_distortion << " rad_final " << rad_final << " phi_final " << phi_final << " r*dphi distortion " << rad_final * phi_distortion << " z_distortion " << z_distortion << std::endl;}
+        double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
+        double y_final = y_start + rantrans * std::sin(ranphi);
+
+        double rad_final = sqrt(square(x_final) + square(y_final));
+        double phi_final = atan2(y_final, x_final);
 
         if (do_ElectronDriftQAHistos)
         {
-          const double phi_final_nodiff = phistart + phi_distortion;
-          const double rad_final_nodiff = radstart + r_distortion;
-          deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
-          deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
-          deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
-          deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
+          z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
+          deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
+          deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
+        }
 
-          // Fill Diagnostic plots, written into ElectronDriftQA.root
-          hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
-          hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
-          hitmapstart_z->Fill(z_start, radstart);
-          hitmapend_z->Fill(z_final, rad_final);
-          deltar->Fill(radstart, rad_final - radstart);    // total delta r
-          deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
-          deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+        if (m_distortionMap)
+        {
+          // zhangcanyu
+          const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
+          if (reaches < thresholdforreachesreadout)
+          {
+            notReachingReadout++;
+            continue;
+          }
+
+          const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
+          const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
+          const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
+
+          rad_final += r_distortion;
+          phi_final += phi_distortion;
+          z_final += z_distortion;
+          if (z_start < 0)
+          {
+            t_final = (z_final + tpc_length / 2.0) / drift_velocity;
+          }
+          else
+          {
+            t_final = (tpc_length / 2.0 - z_final) / drift_velocity;
+          }
+
+          x_final = rad_final * std::cos(phi_final);
+          y_final = rad_final * std::sin(phi_final);
+
+          //	if(i < 1)
+          //{std::cout << " electron " << i << " r_distortion " << r_distortion << " phi_distortion " << phi_distortion << " rad_final " << rad_final << " phi_final " << phi_final << " r*dphi distortion " << rad_final * phi_distortion << " z_distortion " << z_distortion << std::endl;}
+
+          if (do_ElectronDriftQAHistos)
+          {
+            const double phi_final_nodiff = phistart + phi_distortion;
+            const double rad_final_nodiff = radstart + r_distortion;
+            deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
+            deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
+            deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
+            deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
+
+            // Fill Diagnostic plots, written into ElectronDriftQA.root
+            hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
+            hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
+            hitmapstart_z->Fill(z_start, radstart);
+            hitmapend_z->Fill(z_final, rad_final);
+            deltar->Fill(radstart, rad_final - radstart);    // total delta r
+            deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
+            deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+          }
         }
-      }
 
-      // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
-      if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
-      {
-        //        notInAcceptance++;
-        continue;
-      }
+        // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
+        if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
+        {
+          //        notInAcceptance++;
+          continue;
+        }
 
-      if (Verbosity() > 1000)
-      //      if(i < 1)
-      {
-        std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
-        std::cout << "radstart " << radstart << " x_start: " << x_start
-                  << ", y_start: " << y_start
-                  << ",z_start: " << z_start
-                  << " t_start " << t_start
-                  << " t_path " << t_path
-                  << " t_sigma " << t_sigma
-                  << " rantime " << rantime
-                  << std::endl;
-
-        std::cout << "       rad_final " << rad_final << " x_final " << x_final
-                  << " y_final " << y_final
-                  << " z_final " << z_final << " t_final " << t_final
-                  << " zdiff " << z_final - z_start << std::endl;
-      }
+        if (Verbosity() > 1000)
+        //      if(i < 1)
+        {
+          std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
+          std::cout << "radstart " << radstart << " x_start: " << x_start
+                    << ", y_start: " << y_start
+                    << ",z_start: " << z_start
+                    << " t_start " << t_start
+                    << " t_path " << t_path
+                    << " t_sigma " << t_sigma
+                    << " rantime " << rantime
+                    << std::endl;
+
+          std::cout << "       rad_final " << rad_final << " x_final " << x_final
+                    << " y_final " << y_final
+                    << " z_final " << z_final << " t_final " << t_final
+                    << " zdiff " << z_final - z_start << std::endl;
+        }
 
-      if (Verbosity() > 0)
-      {
-        assert(nt);
-        nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
-      }
-      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
-                              temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
-                              side, hiter, ntpad, nthit);
-    }  // end loop over electrons for this g4hit
+        if (Verbosity() > 0)
+        {
+          assert(nt);
+          nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
+        }
+        padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
+                                side, hiter, ntpad, nthit);
+      }  // end loop over electrons for this g4hit
+    }
 
     if (do_ElectronDriftQAHistos)
     {
@@ -880,6 +887,174 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHG4TpcElectronDrift::ElectronBuffers::resize(const unsigned int n)
+{
+  for (auto *v : {&f, &ranphi, &gaus_trans, &gaus_long, &x_start, &y_start, &z_start, &t_start, &rantrans, &x_final, &y_final, &t_final})
+  {
+    v->resize(n);
+  }
+  x_gem.clear();
+  y_gem.clear();
+  t_gem.clear();
+  side.clear();
+}
+
+unsigned int PHG4TpcElectronDrift::drift_electrons_batched(PHG4HitContainer::ConstIterator hiter, const unsigned int n_electrons, const double ihit)
+{
+  // Same physics as the electron by electron loop in process_event, but each step is
+  // done for all electrons of the g4hit before going to the next one. The random numbers
+  // are drawn in one go, the kinematics loops have no branches and vectorize,
+  // and the accepted electrons are handed to the pad plane together.
+  // The two gaussian smearings (diffusion and added smear) are independent, so each
+  // is drawn as a single gaussian with the quadratic sum of the widths, which is
+  // statistically equivalent but not the same random sequence as the unbatched drift
+  auto &e = m_electrons;
+  e.resize(n_electrons);
+
+  gsl_rng *rng = RandomGenerator.get();
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    e.f[i] = gsl_rng_uniform(rng);
+  }
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    e.ranphi[i] = gsl_ran_flat(rng, -M_PI, M_PI);
+  }
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    e.gaus_trans[i] = gsl_ran_gaussian_ziggurat(rng, 1.0);
+  }
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    e.gaus_long[i] = gsl_ran_gaussian_ziggurat(rng, 1.0);
+  }
+
+  // starting point along the g4hit path
+  const PHG4Hit *hit = hiter->second;
+  const double x0 = hit->get_x(0);
+  const double y0 = hit->get_y(0);
+  const double z0 = hit->get_z(0);
+  const double t0 = hit->get_t(0);
+  const double dx = hit->get_x(1) - x0;
+  const double dy = hit->get_y(1) - y0;
+  const double dz = hit->get_z(1) - z0;
+  const double dt = hit->get_t(1) - t0;
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    e.x_start[i] = x0 + e.f[i] * dx;
+    e.y_start[i] = y0 + e.f[i] * dy;
+    e.z_start[i] = z0 + e.f[i] * dz;
+    e.t_start[i] = t0 + e.f[i] * dt;
+  }
+
+  // diffusion and drift time
+  const double diffusion_trans2 = square(diffusion_trans);
+  const double diffusion_long2 = square(diffusion_long);
+  const double smear_trans2 = square(added_smear_sigma_trans);
+  const double smear_long2 = square(added_smear_sigma_long);
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    const double drift_length = tpc_length / 2. - std::abs(e.z_start[i]);
+    e.rantrans[i] = std::sqrt(diffusion_trans2 * drift_length + smear_trans2) * e.gaus_trans[i];
+    const double rantime = std::sqrt(diffusion_long2 * drift_length + smear_long2) * e.gaus_long[i] / drift_velocity;
+    e.t_final[i] = e.t_start[i] + drift_length / drift_velocity + rantime;
+    e.x_final[i] = e.x_start[i] + e.rantrans[i] * std::cos(e.ranphi[i]);
+    e.y_final[i] = e.y_start[i] + e.rantrans[i] * std::sin(e.ranphi[i]);
+  }
+
+  // time window, distortions and acceptance
+  unsigned int notReachingReadout = 0;
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    double t_final = e.t_final[i];
+    if (t_final < min_time || t_final > max_time)
+    {
+      continue;
+    }
+
+    const double z_start = e.z_start[i];
+    double z_final = (z_start < 0) ? -tpc_length / 2. + t_final * drift_velocity : tpc_length / 2. - t_final * drift_velocity;
+    double x_final = e.x_final[i];
+    double y_final = e.y_final[i];
+    double rad_final = std::sqrt(square(x_final) + square(y_final));
+
+    if (m_distortionMap || do_ElectronDriftQAHistos)
+    {
+      const double radstart = std::sqrt(square(e.x_start[i]) + square(e.y_start[i]));
+      const double phistart = std::atan2(e.y_start[i], e.x_start[i]);
+      if (do_ElectronDriftQAHistos)
+      {
+        z_startmap->Fill(z_start, radstart);
+        deltaphinodist->Fill(phistart, e.rantrans[i] / rad_final);
+        deltarnodist->Fill(radstart, e.rantrans[i]);
+      }
+
+      if (m_distortionMap)
+      {
+        const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
+        if (reaches < thresholdforreachesreadout)
+        {
+          notReachingReadout++;
+          continue;
+        }
+
+        const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
+        const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
+        const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
+
+        const double phi_final = std::atan2(y_final, x_final) + phi_distortion;
+        rad_final += r_distortion;
+        z_final += z_distortion;
+        t_final = (z_start < 0) ? (z_final + tpc_length / 2.0) / drift_velocity : (tpc_length / 2.0 - z_final) / drift_velocity;
+        x_final = rad_final * std::cos(phi_final);
+        y_final = rad_final * std::sin(phi_final);
+
+        if (do_ElectronDriftQAHistos)
+        {
+          const double phi_final_nodiff = phistart + phi_distortion;
+          const double rad_final_nodiff = radstart + r_distortion;
+          deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);
+          deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);
+          deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
+          deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
+
+          hitmapstart->Fill(e.x_start[i], e.y_start[i]);
+          hitmapend->Fill(x_final, y_final);
+          hitmapstart_z->Fill(z_start, radstart);
+          hitmapend_z->Fill(z_final, rad_final);
+          deltar->Fill(radstart, rad_final - radstart);
+          deltaphi->Fill(phistart, phi_final - phistart);
+          deltaz->Fill(z_start, z_distortion);
+        }
+      }
+    }
+
+    // same acceptance margin as in the electron by electron loop
+    if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
+    {
+      continue;
+    }
+
+    if (Verbosity() > 0)
+    {
+      assert(nt);
+      const double t_sigma = diffusion_long * std::sqrt(tpc_length / 2. - std::abs(z_start)) / drift_velocity;
+      nt->Fill(ihit, e.t_start[i], t_final, t_sigma, rad_final, z_start, z_final);
+    }
+
+    e.x_gem.push_back(x_final);
+    e.y_gem.push_back(y_final);
+    e.t_gem.push_back(t_final);
+    e.side.push_back((z_start > 0) ? 1 : 0);
+  }
+
+  padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                          temp_hitsetcontainer.get(), hittruthassoc, e.x_gem, e.y_gem, e.t_gem,
+                          e.side, hiter, ntpad, nthit);
+
+  return notReachingReadout;
+}
+
 int PHG4TpcElectronDrift::End(PHCompositeNode * /*topNode*/)
 {
   if (Verbosity() > 0)
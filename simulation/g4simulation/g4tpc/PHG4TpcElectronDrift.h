@@ -21,6 +21,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHG4TpcPadPlane;
 class PHG4TpcDistortion;
@@ -83,9 +84,16 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   void set_zero_bfield_flag(bool flag) { zero_bfield = flag; };
   void set_zero_bfield_diffusion_factor(double f) { zero_bfield_diffusion_factor = f; };
   void use_PDG_gas_params() { m_use_PDG_gas_params = true; }
+
+  //! generate and drift all electrons of a g4hit at once and send them to the pad plane together
+  void set_batched_drift(bool flag) { m_batched_drift = flag; }
+
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
+  //! batched electron drift for one g4hit, returns the number of electrons which do not reach the readout
+  unsigned int drift_electrons_batched(PHG4HitContainer::ConstIterator hiter, const unsigned int n_electrons, const double ihit);
+
   TrkrHitSetContainer *hitsetcontainer{nullptr};
   TrkrHitTruthAssoc *hittruthassoc{nullptr};
   TrkrTruthTrackContainer *truthtracks{nullptr};
@@ -143,6 +151,38 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   bool do_getReachReadout{false};
   bool zero_bfield{false};
   bool m_use_PDG_gas_params{false};
+  bool m_batched_drift{false};
+
+  //! structure of arrays work buffers for the batched drift, kept from hit to hit
+  struct ElectronBuffers
+  {
+    void resize(const unsigned int n);
+
+    // random numbers
+    std::vector<double> f;
+    std::vector<double> ranphi;
+    std::vector<double> gaus_trans;
+    std::vector<double> gaus_long;
+
+    // start position and time
+    std::vector<double> x_start;
+    std::vector<double> y_start;
+    std::vector<double> z_start;
+    std::vector<double> t_start;
+
+    // diffused position and time at the readout
+    std::vector<double> rantrans;
+    std::vector<double> x_final;
+    std::vector<double> y_final;
+    std::vector<double> t_final;
+
+    // electrons accepted for the readout
+    std::vector<double> x_gem;
+    std::vector<double> y_gem;
+    std::vector<double> t_gem;
+    std::vector<unsigned int> side;
+  };
+  ElectronBuffers m_electrons;
 
   std::unique_ptr<TrkrHitSetContainer> temp_hitsetcontainer;
   std::unique_ptr<TrkrHitSetContainer> single_hitsetcontainer;
@@ -10,6 +10,7 @@
 #include <phool/PHNodeIterator.h>
 
 #include <string>
+#include <vector>
 
 PHG4TpcPadPlane::PHG4TpcPadPlane(const std::string &name)
   : SubsysReco(name)
@@ -47,3 +48,11 @@ int PHG4TpcPadPlane::InitRun(PHCompositeNode *topNode)
   UpdateInternalParameters();
   return Fun4AllReturnCodes::EVENT_OK;
 }
+
+void PHG4TpcPadPlane::MapToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const std::vector<double> &x_gem, const std::vector<double> &y_gem, const std::vector<double> &t_gem, const std::vector<unsigned int> &side, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+{
+  for (unsigned int i = 0; i < x_gem.size(); ++i)
+  {
+    MapToPadPlane(builder, single_hitsetcontainer, hitsetcontainer, hittruthassoc, x_gem[i], y_gem[i], t_gem[i], side[i], hiter, ntpad, nthit);
+  }
+}
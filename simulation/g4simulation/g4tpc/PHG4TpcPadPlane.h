@@ -9,6 +9,7 @@
 #include <phparameter/PHParameterInterface.h>
 
 #include <string>  // for string
+#include <vector>
 
 class TrkrHitSetContainer;
 class TrkrHitTruthAssoc;
@@ -33,6 +34,8 @@ class PHG4TpcPadPlane : public SubsysReco, public PHParameterInterface
   virtual void UpdateInternalParameters() { return; }
   //  virtual void MapToPadPlane(PHG4CellContainer * /*g4cells*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) {}
   virtual void MapToPadPlane(TpcClusterBuilder & /*builder*/, TrkrHitSetContainer * /*single_hitsetcontainer*/, TrkrHitSetContainer * /*hitsetcontainer*/, TrkrHitTruthAssoc * /*hittruthassoc*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) = 0;  // { return {}; }
+  //! map all electrons drifted from one g4hit, the default calls the single electron method for each of them
+  virtual void MapToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const std::vector<double> &x_gem, const std::vector<double> &y_gem, const std::vector<double> &t_gem, const std::vector<unsigned int> &side, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
   void Detector(const std::string &name) { detector = name; }
 
  protected:
@@ -32,17 +32,21 @@
 #include <TF1.h>
 #include <TFile.h>
 #include <TH2.h>
+#include <TMath.h>
 #include <TSystem.h>
+#include <TVectorD.h>
 
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>  // for getenv
 #include <iostream>
 #include <map>      // for _Rb_tree_cons...
+#include <memory>
 #include <utility>  // for pair
 
 class PHCompositeNode;
@@ -70,8 +74,30 @@ namespace
     return std::exp(-square(x / sigma) / 2) / (sigma * std::sqrt(2 * M_PI));
   }
 
+  //! fraction of the charge of a gaussian cloud of width sigma on a pad at distance x_loc in r-phi
+  /*!
+  this corresponds to integrating the charge distribution Gaussian function (centered on rphi and of width cloud_sig_rp),
+  convoluted with a strip response function, which is triangular from -pitch to +pitch, with a maximum of 1. at stript center
+  */
+  double pad_overlap(const double x_loc, const double pitch, const double sigma)
+  {
+    return (pitch - x_loc) * (std::erf(x_loc / (M_SQRT2 * sigma)) - std::erf((x_loc - pitch) / (M_SQRT2 * sigma))) / (pitch * 2) + (pitch + x_loc) * (std::erf((x_loc + pitch) / (M_SQRT2 * sigma)) - std::erf(x_loc / (M_SQRT2 * sigma))) / (pitch * 2) + (gaus(x_loc - pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch + (gaus(x_loc + pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch;
+  }
+
   constexpr unsigned int print_layer = 18;
 
+  // lookup table binning
+  // Langau gain: pdf sampled in 2000 bins up to 5000 electrons, inverse cdf in 4096 bins
+  constexpr double langau_max = 5000;
+  constexpr unsigned int langau_pdf_bins = 2000;
+  constexpr unsigned int langau_cdf_bins = 4096;
+  // erf: saturated beyond +-6
+  constexpr double erf_max = 6;
+  constexpr unsigned int erf_bins = 12000;
+  // pad response: range of pitch + 8 sigma on both sides, sigma/100 steps
+  constexpr double pad_response_nsigma = 8;
+  constexpr double pad_response_bins_per_sigma = 100;
+
 }  // namespace
 
 PHG4TpcPadPlaneReadout::PHG4TpcPadPlaneReadout(const std::string &name)
@@ -199,6 +225,10 @@ int PHG4TpcPadPlaneReadout::InitRun(PHCompositeNode *topNode)
 	    }
 	}
     } 
+  if (m_use_lookup_tables)
+  {
+    build_lookup_tables();
+  }
   if (m_maskDeadChannels)
   {
     makeChannelMask(m_deadChannelMap, m_deadChannelMapName, "TotalDeadChannels");
@@ -285,6 +315,12 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(TF1 *f)
   return nelec;
 }
 
+//_________________________________________________________
+double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(const LookupTable &inverse_cdf)
+{
+  return inverse_cdf(gsl_rng_uniform(RandomGenerator));
+}
+
 void PHG4TpcPadPlaneReadout::MapToPadPlane(
     TpcClusterBuilder &tpc_truth_clusterer,
     TrkrHitSetContainer *single_hitsetcontainer,
@@ -464,7 +500,14 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
     }
     if (this_region > -1)
     {
-      nelec = getSingleEGEMAmplification(flangau[side][this_region][sector]);
+      if (m_use_lookup_tables && !m_langau_inverse_cdf[side][this_region][sector].empty())
+      {
+        nelec = getSingleEGEMAmplification(m_langau_inverse_cdf[side][this_region][sector]);
+      }
+      else
+      {
+        nelec = getSingleEGEMAmplification(flangau[side][this_region][sector]);
+      }
     }
     else
     {
@@ -870,12 +913,14 @@ void PHG4TpcPadPlaneReadout::populate_zigzag_phibins(const unsigned int side, co
 
     const double x_loc = x_loc_tmp;
     // calculate fraction of the total charge on this strip
-    /*
-    this corresponds to integrating the charge distribution Gaussian function (centered on rphi and of width cloud_sig_rp),
-    convoluted with a strip response function, which is triangular from -pitch to +pitch, with a maximum of 1. at stript center
-    */
-    overlap[ipad] =
-        (pitch - x_loc) * (std::erf(x_loc / (M_SQRT2 * sigma)) - std::erf((x_loc - pitch) / (M_SQRT2 * sigma))) / (pitch * 2) + (pitch + x_loc) * (std::erf((x_loc + pitch) / (M_SQRT2 * sigma)) - std::erf(x_loc / (M_SQRT2 * sigma))) / (pitch * 2) + (gaus(x_loc - pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch + (gaus(x_loc + pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch;
+    if (m_use_lookup_tables && sigma == sigmaT && layernum < m_pad_response.size() && !m_pad_response[layernum].empty())
+    {
+      overlap[ipad] = m_pad_response[layernum](x_loc);
+    }
+    else
+    {
+      overlap[ipad] = pad_overlap(x_loc, pitch, sigma);
+    }
   }
 
   // now we have the overlap for each pad
@@ -964,7 +1009,7 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
       double tLim1 = 0.0;
       double tLim2 = 0.5 * M_SQRT2 * (-0.5 * tstepsize - tdisp) * cloud_sig_tt_inv[index1];
       // 1/2 * the erf is the integral probability from the argument Z value to zero, so this is the integral probability between the Z limits
-      double t_integral1 = 0.5 * (erf(tLim1) - erf(tLim2));
+      double t_integral1 = half_erf(tLim1) - half_erf(tLim2);
 
       if (Verbosity() > 1000)
       {
@@ -977,7 +1022,7 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
 
       tLim2 = 0.0;
       tLim1 = 0.5 * M_SQRT2 * (0.5 * tstepsize - tdisp) * cloud_sig_tt_inv[index2];
-      double t_integral2 = 0.5 * (erf(tLim1) - erf(tLim2));
+      double t_integral2 = half_erf(tLim1) - half_erf(tLim2);
 
       if (Verbosity() > 1000)
       {
@@ -1019,7 +1064,7 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
       }
       double tLim1 = 0.5 * M_SQRT2 * ((it + 0.5) * tstepsize - tdisp) * cloud_sig_tt_inv[index];
       double tLim2 = 0.5 * M_SQRT2 * ((it - 0.5) * tstepsize - tdisp) * cloud_sig_tt_inv[index];
-      t_integral = 0.5 * (erf(tLim1) - erf(tLim2));
+      t_integral = half_erf(tLim1) - half_erf(tLim2);
 
       if (Verbosity() > 1000)
       {
@@ -1038,6 +1083,292 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
   return;
 }
 
+void PHG4TpcPadPlaneReadout::LookupTable::fill(double xmin, double xmax, unsigned int nbins, const std::function<double(double)> &f)
+{
+  std::vector<double> values(nbins + 1);
+  for (unsigned int i = 0; i <= nbins; ++i)
+  {
+    values[i] = f(xmin + i * (xmax - xmin) / nbins);
+  }
+  set(xmin, xmax, values);
+}
+
+void PHG4TpcPadPlaneReadout::LookupTable::set(double xmin, double xmax, const std::vector<double> &values)
+{
+  m_xmin = xmin;
+  m_inv_step = (values.size() - 1) / (xmax - xmin);
+  m_values = values;
+}
+
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::build_lookup_tables()
+{
+  // time response
+  m_half_erf_table.fill(-erf_max, erf_max, erf_bins, [](double x)
+                        { return 0.5 * std::erf(x); });
+
+  // pad response, for the pad pitch of each layer
+  m_pad_response.clear();
+  const auto layerrange = GeomContainer->get_begin_end();
+  for (auto layeriter = layerrange.first; layeriter != layerrange.second; ++layeriter)
+  {
+    const unsigned int layer = layeriter->second->get_layer();
+    const double pitch = layeriter->second->get_phistep() * layeriter->second->get_radius();
+    const double xmax = pitch + pad_response_nsigma * sigmaT;
+    const auto nbins = static_cast<unsigned int>(std::ceil(2 * xmax / sigmaT * pad_response_bins_per_sigma));
+    if (layer >= m_pad_response.size())
+    {
+      m_pad_response.resize(layer + 1);
+    }
+    m_pad_response[layer].fill(-xmax, xmax, nbins, [pitch, this](double x)
+                               { return pad_overlap(x, pitch, sigmaT); });
+  }
+
+  // GEM gain
+  if (m_useLangau && !read_langau_tables())
+  {
+    build_langau_tables();
+    if (!m_lookup_table_cache_file.empty())
+    {
+      write_langau_tables();
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    check_lookup_tables();
+  }
+}
+
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::build_langau_tables()
+{
+  // cumulative distribution from the pdf on a fine grid (trapezoidal rule), on the same range as TF1::GetRandom,
+  // then inverted on a uniform grid of probabilities
+  const double step = langau_max / langau_pdf_bins;
+  std::vector<double> cdf(langau_pdf_bins + 1);
+  std::vector<double> inverse_cdf(langau_cdf_bins + 1);
+  for (int side = 0; side < NSides; ++side)
+  {
+    for (int region = 0; region < NRSectors; ++region)
+    {
+      for (int sector = 0; sector < NSectors; ++sector)
+      {
+        TF1 *f = flangau[side][region][sector];
+        if (!f)
+        {
+          continue;
+        }
+
+        double previous = std::max(0., f->Eval(0));
+        cdf[0] = 0;
+        for (unsigned int i = 1; i <= langau_pdf_bins; ++i)
+        {
+          const double current = std::max(0., f->Eval(i * step));
+          cdf[i] = cdf[i - 1] + 0.5 * (previous + current) * step;
+          previous = current;
+        }
+        const double norm = cdf.back();
+        if (!(norm > 0))
+        {
+          std::cout << PHWHERE << " Langau gain for side " << side << " region " << region << " sector " << sector
+                    << " has no positive integral, it is sampled from the TF1" << std::endl;
+          continue;
+        }
+        for (auto &c : cdf)
+        {
+          c /= norm;
+        }
+
+        unsigned int bin = 0;
+        for (unsigned int k = 0; k <= langau_cdf_bins; ++k)
+        {
+          const double u = static_cast<double>(k) / langau_cdf_bins;
+          // first bin whose upper edge reaches u, skipping the range without any probability below the distribution
+          while (bin + 1 < langau_pdf_bins && (cdf[bin + 1] < u || cdf[bin + 1] <= 0))
+          {
+            ++bin;
+          }
+          const double dc = cdf[bin + 1] - cdf[bin];
+          inverse_cdf[k] = step * (bin + ((dc > 0) ? (u - cdf[bin]) / dc : 0));
+        }
+        m_langau_inverse_cdf[side][region][sector].set(0, 1, inverse_cdf);
+      }
+    }
+  }
+}
+
+//_________________________________________________________
+bool PHG4TpcPadPlaneReadout::read_langau_tables()
+{
+  // AccessPathName returns true if the file does not exist
+  if (m_lookup_table_cache_file.empty() || gSystem->AccessPathName(m_lookup_table_cache_file.c_str()))
+  {
+    return false;
+  }
+  std::unique_ptr<TFile> file(TFile::Open(m_lookup_table_cache_file.c_str(), "READ"));
+  if (!file || file->IsZombie())
+  {
+    return false;
+  }
+
+  // the stored tables are used only if they were built from the same Langau parameters
+  for (int side = 0; side < NSides; ++side)
+  {
+    for (int region = 0; region < NRSectors; ++region)
+    {
+      for (int sector = 0; sector < NSectors; ++sector)
+      {
+        TF1 *f = flangau[side][region][sector];
+        if (!f)
+        {
+          continue;
+        }
+        std::unique_ptr<TVectorD> table(file->Get<TVectorD>((boost::format("langau_%d_%d_%d") % side % region % sector).str().c_str()));
+        if (!table || table->GetNrows() != static_cast<int>(4 + langau_cdf_bins + 1))
+        {
+          return false;
+        }
+        for (int ipar = 0; ipar < 4; ++ipar)
+        {
+          if ((*table)[ipar] != f->GetParameter(ipar))
+          {
+            return false;
+          }
+        }
+        m_langau_inverse_cdf[side][region][sector].set(0, 1, std::vector<double>(table->GetMatrixArray() + 4, table->GetMatrixArray() + table->GetNrows()));
+      }
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "PHG4TpcPadPlaneReadout::read_langau_tables - read Langau gain tables from " << m_lookup_table_cache_file << std::endl;
+  }
+  return true;
+}
+
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::write_langau_tables() const
+{
+  // write to a temporary file which is renamed, so that jobs sharing the cache file never read a partial file
+  const std::string tmpname = m_lookup_table_cache_file + ".tmp." + std::to_string(gSystem->GetPid());
+  std::unique_ptr<TFile> file(TFile::Open(tmpname.c_str(), "RECREATE"));
+  if (!file || file->IsZombie())
+  {
+    std::cout << PHWHERE << " cannot write Langau gain tables to " << tmpname << std::endl;
+    return;
+  }
+
+  // the Langau parameters are stored in front of the table
+  for (int side = 0; side < NSides; ++side)
+  {
+    for (int region = 0; region < NRSectors; ++region)
+    {
+      for (int sector = 0; sector < NSectors; ++sector)
+      {
+        const auto &values = m_langau_inverse_cdf[side][region][sector].values();
+        if (!flangau[side][region][sector] || values.empty())
+        {
+          continue;
+        }
+        TVectorD table(4 + values.size());
+        for (int ipar = 0; ipar < 4; ++ipar)
+        {
+          table[ipar] = flangau[side][region][sector]->GetParameter(ipar);
+        }
+        std::copy(values.begin(), values.end(), table.GetMatrixArray() + 4);
+        table.Write((boost::format("langau_%d_%d_%d") % side % region % sector).str().c_str());
+      }
+    }
+  }
+  file->Close();
+
+  if (gSystem->Rename(tmpname.c_str(), m_lookup_table_cache_file.c_str()) != 0)
+  {
+    std::cout << PHWHERE << " cannot rename " << tmpname << " to " << m_lookup_table_cache_file << std::endl;
+    gSystem->Unlink(tmpname.c_str());
+    return;
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "PHG4TpcPadPlaneReadout::write_langau_tables - wrote Langau gain tables to " << m_lookup_table_cache_file << std::endl;
+  }
+}
+
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::check_lookup_tables() const
+{
+  // compare the tables with the functions they replace, half way between grid points where the interpolation is worst
+  double max_erf_diff = 0;
+  for (unsigned int i = 0; i < erf_bins; ++i)
+  {
+    const double x = -erf_max + (i + 0.5) * 2 * erf_max / erf_bins;
+    max_erf_diff = std::max(max_erf_diff, std::abs(m_half_erf_table(x) - 0.5 * std::erf(x)));
+  }
+  std::cout << "PHG4TpcPadPlaneReadout::check_lookup_tables - time response, max deviation from erf: " << max_erf_diff << std::endl;
+
+  double max_pad_diff = 0;
+  const auto layerrange = GeomContainer->get_begin_end();
+  for (auto layeriter = layerrange.first; layeriter != layerrange.second; ++layeriter)
+  {
+    const unsigned int layer = layeriter->second->get_layer();
+    const double pitch = layeriter->second->get_phistep() * layeriter->second->get_radius();
+    const double step = sigmaT / pad_response_bins_per_sigma;
+    for (double x = -pitch - pad_response_nsigma * sigmaT + step / 2; x < pitch + pad_response_nsigma * sigmaT; x += step)
+    {
+      max_pad_diff = std::max(max_pad_diff, std::abs(m_pad_response[layer](x) - pad_overlap(x, pitch, sigmaT)));
+    }
+  }
+  std::cout << "PHG4TpcPadPlaneReadout::check_lookup_tables - pad response, max deviation from analytic overlap: " << max_pad_diff << std::endl;
+
+  if (!m_useLangau)
+  {
+    return;
+  }
+
+  // two sample Kolmogorov test between tabulated and TF1 gain sampling for each module
+  // a separate generator is used, so that the checks do not change the simulation
+  constexpr int nsamples = 10000;
+  std::vector<double> table_samples(nsamples);
+  std::vector<double> tf1_samples(nsamples);
+  gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+  double min_probability = 1;
+  for (int side = 0; side < NSides; ++side)
+  {
+    for (int region = 0; region < NRSectors; ++region)
+    {
+      for (int sector = 0; sector < NSectors; ++sector)
+      {
+        const auto &table = m_langau_inverse_cdf[side][region][sector];
+        TF1 *f = flangau[side][region][sector];
+        if (!f || table.empty())
+        {
+          continue;
+        }
+        for (int i = 0; i < nsamples; ++i)
+        {
+          table_samples[i] = table(gsl_rng_uniform(rng));
+          tf1_samples[i] = f->GetRandom(0, langau_max);
+        }
+        std::sort(table_samples.begin(), table_samples.end());
+        std::sort(tf1_samples.begin(), tf1_samples.end());
+        const double probability = TMath::KolmogorovTest(nsamples, table_samples.data(), nsamples, tf1_samples.data(), "");
+        min_probability = std::min(min_probability, probability);
+        if (Verbosity() > 1)
+        {
+          std::cout << "PHG4TpcPadPlaneReadout::check_lookup_tables - side " << side << " region " << region << " sector " << sector
+                    << " mean gain table " << TMath::Mean(nsamples, table_samples.data())
+                    << " TF1 " << TMath::Mean(nsamples, tf1_samples.data())
+                    << " KS probability " << probability << std::endl;
+        }
+      }
+    }
+  }
+  gsl_rng_free(rng);
+  std::cout << "PHG4TpcPadPlaneReadout::check_lookup_tables - GEM gain, smallest KS probability of all modules: " << min_probability << std::endl;
+}
+
 void PHG4TpcPadPlaneReadout::UseGain(const int flagToUseGain)
 {
   m_flagToUseGain = flagToUseGain;
@@ -11,6 +11,8 @@
 #include <array>
 #include <climits>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <string>  // for string
 #include <vector>
 #include <map>
@@ -43,6 +45,12 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   void SetUseLangauGEMGain(const int flagLangau) { m_useLangau = flagLangau; }
   void SetLangauParsFileName(const std::string &name) { m_tpc_langau_pars_file = name; }
 
+  //! use tables built at InitRun for the Langau GEM gain sampling and the pad and time response,
+  //! instead of TF1::GetRandom and erf calls for every electron (off by default)
+  void SetUseLookupTables(const bool flag) { m_use_lookup_tables = flag; }
+  //! ROOT file to store the Langau gain tables, they are read back if built from the same parameters
+  void SetLookupTableCacheFile(const std::string &name) { m_lookup_table_cache_file = name; }
+
   void SetDriftVelocity(double vd) override { drift_velocity = vd; }
   void SetReadoutTime(float t) override { extended_readout_time = t; }
   // otherwise warning of inconsistent overload since only one MapToPadPlane methow is overridden
@@ -65,6 +73,47 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   }
 
  private:
+  //! function tabulated on a uniform grid, linear interpolation between the grid points
+  //! and the first or last value outside of the grid
+  class LookupTable
+  {
+   public:
+    void fill(double xmin, double xmax, unsigned int nbins, const std::function<double(double)> &f);
+    void set(double xmin, double xmax, const std::vector<double> &values);
+
+    bool empty() const { return m_values.empty(); }
+    const std::vector<double> &values() const { return m_values; }
+
+    double operator()(double x) const
+    {
+      const double pos = (x - m_xmin) * m_inv_step;
+      if (!(pos > 0))
+      {
+        return m_values.front();
+      }
+      const auto bin = static_cast<size_t>(pos);
+      if (bin + 1 >= m_values.size())
+      {
+        return m_values.back();
+      }
+      return m_values[bin] + (pos - bin) * (m_values[bin + 1] - m_values[bin]);
+    }
+
+   private:
+    double m_xmin = 0;
+    double m_inv_step = 0;
+    std::vector<double> m_values;
+  };
+
+  void build_lookup_tables();
+  void build_langau_tables();
+  bool read_langau_tables();
+  void write_langau_tables() const;
+  void check_lookup_tables() const;
+
+  //! 0.5*erf(x), integral of the normalized gaussian between 0 and x*sqrt(2)*sigma
+  double half_erf(const double x) const { return m_use_lookup_tables ? m_half_erf_table(x) : 0.5 * std::erf(x); }
+
   //  void populate_rectangular_phibins(const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share);
   void populate_zigzag_phibins(const unsigned int side, const unsigned int layernum, const double phi, const double cloud_sig_rp, std::vector<int> &pad_phibin, std::vector<double> &pad_phibin_share);
   void populate_tbins(const double t, const std::array<double, 2> &cloud_sig_tt, std::vector<int> &adc_tbin, std::vector<double> &adc_tbin_share);
@@ -113,6 +162,7 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   double getSingleEGEMAmplification();
   double getSingleEGEMAmplification(double weight);
   static double getSingleEGEMAmplification(TF1 *f);
+  double getSingleEGEMAmplification(const LookupTable &inverse_cdf);
   bool m_usePolya = false;
 
   bool m_useLangau = false;
@@ -132,6 +182,18 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   TF1 *flangau[2][3][12] = {{{nullptr}}};
 
+  bool m_use_lookup_tables = false;
+  std::string m_lookup_table_cache_file;
+
+  //! inverse cumulative distribution of the Langau gain for each module
+  LookupTable m_langau_inverse_cdf[2][3][12];
+
+  //! 0.5*erf(x) for the time response
+  LookupTable m_half_erf_table;
+
+  //! charge fraction on a pad vs distance in r-phi between pad and cloud center, for each layer and sigmaT
+  std::vector<LookupTable> m_pad_response;
+
   hitMaskTpc m_deadChannelMap;
   hitMaskTpc m_hotChannelMap; 
 